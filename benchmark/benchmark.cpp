@@ -16,12 +16,18 @@
 // KIND, either express or implied.
 
 #include "benchmark.h"
+#include "component_benchmark.h"
+#include "result_store.h"
 #include "../fp_to_chars.h"
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <iomanip>
 
+// Define NO_RUN_MATLAB to skip plotting, e.g., on machines without MATLAB
+#ifndef NO_RUN_MATLAB
 #define RUN_MATLAB
+#endif
 #ifdef RUN_MATLAB
 #include <cstdlib>
 
@@ -35,22 +41,33 @@ void run_matlab() {
 }
 #endif
 
+// benchmark_results/[prefix][kind]_[float_name][extension]
+static std::string result_filename(std::string_view prefix, std::string_view kind,
+	std::string_view float_name, std::string_view extension = ".csv")
+{
+	auto filename = std::string("benchmark_results/");
+	filename += prefix;
+	filename += kind;
+	filename += "_";
+	filename += float_name;
+	filename += extension;
+	return filename;
+}
+
+// Files are written as benchmark_results/[prefix]uniform_benchmark_[float_name].csv,
+// benchmark_results/[prefix]digits_benchmark_[float_name].csv,
+// and benchmark_results/[prefix]summary_benchmark_[float_name].csv;
+// if counters is not null, also benchmark_results/[prefix]counters_benchmark_[float_name].csv
 template <class Float>
-static void benchmark_test(std::string_view float_name,
+static void write_benchmark_results(std::string_view prefix, std::string_view float_name,
+	typename benchmark_holder<Float>::output_type const& out,
 	std::size_t number_of_uniform_samples, std::size_t number_of_digits_samples_per_digits,
-	std::size_t number_of_iterations)
+	typename benchmark_holder<Float>::counters_output_type const* counters = nullptr)
 {
-	auto& inst = benchmark_holder<Float>::get_instance();
-	std::cout << "Generating random samples...\n";
-	inst.prepare_samples(number_of_uniform_samples, number_of_digits_samples_per_digits);
-	auto out = inst.run(number_of_iterations, float_name);
-
 	std::cout << "Benchmarking done.\n" << "Now writing to files...\n";
 
 	// Write uniform benchmark results
-	auto filename = std::string("benchmark_results/uniform_benchmark_");
-	filename += float_name;
-	filename += ".csv";
+	auto filename = result_filename(prefix, "uniform_benchmark", float_name);
 	std::ofstream out_file{ filename };
 	out_file << "number_of_samples," << number_of_uniform_samples << std::endl;;
 	out_file << "name,sample,bit_representation,time\n";
@@ -73,9 +90,7 @@ static void benchmark_test(std::string_view float_name,
 	out_file.close();
 
 	// Write digits benchmark results
-	filename = std::string("benchmark_results/digits_benchmark_");
-	filename += float_name;
-	filename += ".csv";
+	filename = result_filename(prefix, "digits_benchmark", float_name);
 	out_file.open(filename);
 	out_file << "number_of_samples_per_digits," << number_of_digits_samples_per_digits << std::endl;;
 	out_file << "name,digits,sample,time\n";
@@ -92,25 +107,596 @@ static void benchmark_test(std::string_view float_name,
 	}
 	out_file.close();
 
+	// Write per-(name, digits) summaries; digits=0 is for uniform samples
+	filename = result_filename(prefix, "summary_benchmark", float_name);
+	out_file.open(filename);
+	out_file << "name,digits,count,outliers,median,mad,mean,min,max\n";
+
+	std::cout << "\n" << std::left << std::setw(40) << "name" << std::right <<
+		std::setw(8) << "digits" << std::setw(12) << "median(ns)" << std::setw(10) << "mad\n";
+	for (auto& name_result_pair : out) {
+		for (unsigned int digits = 0; digits <= benchmark_holder<Float>::max_digits; ++digits) {
+			auto const& results = name_result_pair.second[digits];
+			if (results.empty()) {
+				continue;
+			}
+			std::vector<double> times(results.size());
+			for (std::size_t i = 0; i < results.size(); ++i) {
+				times[i] = results[i].second;
+			}
+			auto const summary = summarize(std::move(times));
+
+			out_file << "\"" << name_result_pair.first << "\"," << digits << "," <<
+				summary.count << "," << summary.number_of_outliers << "," <<
+				summary.median << "," << summary.mad << "," << summary.mean << "," <<
+				summary.min << "," << summary.max << "\n";
+
+			std::cout << std::left << std::setw(40) << name_result_pair.first << std::right <<
+				std::setw(8) << digits << std::fixed << std::setprecision(2) <<
+				std::setw(12) << summary.median << std::setw(10) << summary.mad << "\n" <<
+				std::defaultfloat << std::setprecision(6);
+		}
+	}
+	std::cout << "\n";
+	out_file.close();
+
+	if (!counters) {
+		return;
+	}
+
+	// Write per-call hardware counter values; unavailable counters are written as nan
+	filename = result_filename(prefix, "counters_benchmark", float_name);
+	out_file.open(filename);
+	out_file << "name,digits";
+	for (auto const event_name : perf_counters::event_names) {
+		out_file << "," << event_name;
+	}
+	out_file << "\n";
+
+	for (auto& name_counters_pair : *counters) {
+		for (unsigned int digits = 0; digits <= benchmark_holder<Float>::max_digits; ++digits) {
+			if (out.at(name_counters_pair.first)[digits].empty()) {
+				continue;
+			}
+			out_file << "\"" << name_counters_pair.first << "\"," << digits;
+			for (auto const value : name_counters_pair.second[digits]) {
+				out_file << "," << value;
+			}
+			out_file << "\n";
+		}
+	}
+	out_file.close();
+}
+
+// Written as benchmark_results/[prefix]datasets_benchmark_[float_name].csv
+// and benchmark_results/[prefix]datasets_summary_benchmark_[float_name].csv
+template <class Float>
+static void write_datasets_results(std::string_view prefix, std::string_view float_name,
+	typename benchmark_holder<Float>::datasets_output_type const& out)
+{
+	auto filename = result_filename(prefix, "datasets_benchmark", float_name);
+	std::ofstream out_file{ filename };
+	out_file << "name,dataset,sample,time\n";
+
+	char buffer[64];
+	for (auto& name_result_pair : out) {
+		for (auto const& [dataset_name, results] : name_result_pair.second) {
+			for (auto const& data_time_pair : results) {
+				jkj::fp_to_chars(data_time_pair.first, buffer);
+				out_file << "\"" << name_result_pair.first << "\"," << dataset_name << "," <<
+					buffer << "," << data_time_pair.second << "\n";
+			}
+		}
+	}
+	out_file.close();
+
+	filename = result_filename(prefix, "datasets_summary_benchmark", float_name);
+	out_file.open(filename);
+	out_file << "name,dataset,count,outliers,median,mad,mean,min,max\n";
+
+	std::cout << "\n" << std::left << std::setw(40) << "name" << std::setw(18) << "dataset" <<
+		std::right << std::setw(12) << "median(ns)" << std::setw(10) << "mad\n";
+	for (auto& name_result_pair : out) {
+		for (auto const& [dataset_name, results] : name_result_pair.second) {
+			std::vector<double> times(results.size());
+			for (std::size_t i = 0; i < results.size(); ++i) {
+				times[i] = results[i].second;
+			}
+			auto const summary = summarize(std::move(times));
+
+			out_file << "\"" << name_result_pair.first << "\"," << dataset_name << "," <<
+				summary.count << "," << summary.number_of_outliers << "," <<
+				summary.median << "," << summary.mad << "," << summary.mean << "," <<
+				summary.min << "," << summary.max << "\n";
+
+			std::cout << std::left << std::setw(40) << name_result_pair.first <<
+				std::setw(18) << dataset_name << std::right << std::fixed << std::setprecision(2) <<
+				std::setw(12) << summary.median << std::setw(10) << summary.mad << "\n" <<
+				std::defaultfloat << std::setprecision(6);
+		}
+	}
+	std::cout << "\n";
+}
+
+// Written as benchmark_results/[prefix]throughput_benchmark_[float_name].csv
+template <class Float>
+static void write_throughput_results(std::string_view prefix, std::string_view float_name,
+	typename benchmark_holder<Float>::throughput_output_type const& out)
+{
+	auto filename = result_filename(prefix, "throughput_benchmark", float_name);
+	std::ofstream out_file{ filename };
+	out_file << "name,dataset,number_of_values,ns_per_value,values_per_second\n";
+
+	std::cout << "\n" << std::left << std::setw(40) << "name" << std::setw(18) << "dataset" <<
+		std::right << std::setw(12) << "ns/value" << std::setw(16) << "values/s\n";
+	for (auto& name_result_pair : out) {
+		for (auto const& result : name_result_pair.second) {
+			auto const values_per_second = 1e9 / result.nanoseconds_per_value;
+			out_file << "\"" << name_result_pair.first << "\"," << result.dataset_name << "," <<
+				result.number_of_values << "," << result.nanoseconds_per_value << "," <<
+				values_per_second << "\n";
+
+			std::cout << std::left << std::setw(40) << name_result_pair.first <<
+				std::setw(18) << result.dataset_name << std::right <<
+				std::fixed << std::setprecision(2) << std::setw(12) << result.nanoseconds_per_value <<
+				std::setprecision(0) << std::setw(15) << values_per_second << "\n" <<
+				std::defaultfloat << std::setprecision(6);
+		}
+	}
+	std::cout << "\n";
+}
+
+// Written as benchmark_results/[prefix]scaling_benchmark_[float_name].csv
+template <class Float>
+static void write_scaling_results(std::string_view prefix, std::string_view float_name,
+	typename benchmark_holder<Float>::scaling_output_type const& out)
+{
+	auto filename = result_filename(prefix, "scaling_benchmark", float_name);
+	std::ofstream out_file{ filename };
+	out_file << "name,threads,values_per_second,efficiency\n";
+
+	std::cout << "\n" << std::left << std::setw(40) << "name" << std::right <<
+		std::setw(8) << "threads" << std::setw(16) << "values/s" << std::setw(12) << "efficiency\n";
+	for (auto& name_result_pair : out) {
+		for (auto const& result : name_result_pair.second) {
+			out_file << "\"" << name_result_pair.first << "\"," << result.number_of_threads << "," <<
+				result.values_per_second << "," << result.efficiency << "\n";
+
+			std::cout << std::left << std::setw(40) << name_result_pair.first << std::right <<
+				std::setw(8) << result.number_of_threads << std::fixed <<
+				std::setprecision(0) << std::setw(16) << result.values_per_second <<
+				std::setprecision(3) << std::setw(11) << result.efficiency << "\n" <<
+				std::defaultfloat << std::setprecision(6);
+		}
+	}
+	std::cout << "\n";
+}
+
+// Written as benchmark_results/[prefix]results_[float_name].json; see result_store.h
+template <class Float>
+static void write_result_store(std::string_view prefix, std::string_view float_name,
+	typename benchmark_holder<Float>::output_type const& out,
+	typename benchmark_holder<Float>::repetition_means_output_type const& repetition_means,
+	typename benchmark_holder<Float>::datasets_output_type const& datasets_out,
+	typename benchmark_holder<Float>::datasets_repetition_means_output_type const&
+	datasets_repetition_means)
+{
+	auto file = make_result_file(std::string(float_name));
+
+	auto add_record = [&file](std::string const& name, std::string bucket,
+		std::vector<std::pair<Float, double>> const& results, std::vector<double> means)
+	{
+		std::vector<double> times(results.size());
+		for (std::size_t i = 0; i < results.size(); ++i) {
+			times[i] = results[i].second;
+		}
+		file.records.push_back({ name, std::move(bucket), summarize(std::move(times)),
+			std::move(means) });
+	};
+
+	for (auto& name_result_pair : out) {
+		auto const& means = repetition_means.at(name_result_pair.first);
+		for (unsigned int digits = 0; digits <= benchmark_holder<Float>::max_digits; ++digits) {
+			if (!name_result_pair.second[digits].empty()) {
+				add_record(name_result_pair.first,
+					digits == 0 ? "uniform" : "digits_" + std::to_string(digits),
+					name_result_pair.second[digits], means[digits]);
+			}
+		}
+	}
+	for (auto& name_result_pair : datasets_out) {
+		auto const& means = datasets_repetition_means.at(name_result_pair.first);
+		for (std::size_t idx = 0; idx < name_result_pair.second.size(); ++idx) {
+			add_record(name_result_pair.first, name_result_pair.second[idx].first,
+				name_result_pair.second[idx].second, means[idx].second);
+		}
+	}
+
+	auto filename = result_filename(prefix, "results", float_name, ".json");
+	write_result_file(filename, file);
+}
+
+// Returns true if there is no round-trip failure
+template <class Float>
+static bool verify_functions(std::string_view float_name)
+{
+	std::cout << "Verifying outputs for " << float_name << "'s...\n";
+	typename benchmark_holder<Float>::verification_output_type out;
+	benchmark_holder<Float>::get_instance().verify([](Float x, char* buffer) {
+		jkj::fp_to_chars(x, buffer);
+	}, out);
+
+	bool success = true;
+	std::cout << std::left << std::setw(40) << "name" << std::right << std::setw(12) << "samples" <<
+		std::setw(12) << "failures" << std::setw(12) << "longer" << std::setw(12) << "shorter\n";
+	for (auto const& [name, result] : out) {
+		std::cout << std::left << std::setw(40) << name << std::right <<
+			std::setw(12) << result.number_of_samples <<
+			std::setw(12) << result.number_of_round_trip_failures <<
+			std::setw(12) << result.number_of_longer_outputs <<
+			std::setw(11) << result.number_of_shorter_outputs << "\n";
+		// Only narrowest rows may be shorter than the shortest round-trip output
+		if (result.number_of_round_trip_failures != 0 ||
+			(!result.narrowest && result.number_of_shorter_outputs != 0))
+		{
+			success = false;
+		}
+	}
+	std::cout << "\n";
+	return success;
+}
+
+// Written as benchmark_results/[prefix]cold_benchmark_[float_name].csv
+template <class Float>
+static void write_cold_results(std::string_view prefix, std::string_view float_name,
+	typename benchmark_holder<Float>::cold_output_type const& out)
+{
+	auto filename = result_filename(prefix, "cold_benchmark", float_name);
+	std::ofstream out_file{ filename };
+	out_file << "name,number_of_samples,cold_median,cold_p90,cold_mean,warm_median\n";
+
+	std::cout << "\n" << std::left << std::setw(40) << "name" << std::right <<
+		std::setw(12) << "cold(ns)" << std::setw(12) << "p90(ns)" << std::setw(12) << "mean(ns)" <<
+		std::setw(12) << "warm(ns)\n";
+	for (auto const& [name, result] : out) {
+		out_file << "\"" << name << "\"," << result.number_of_samples << "," << result.median <<
+			"," << result.percentile_90 << "," << result.mean << "," << result.warm_median << "\n";
+
+		std::cout << std::left << std::setw(40) << name << std::right << std::fixed <<
+			std::setprecision(2) << std::setw(12) << result.median <<
+			std::setw(12) << result.percentile_90 << std::setw(12) << result.mean <<
+			std::setw(11) << result.warm_median << "\n" <<
+			std::defaultfloat << std::setprecision(6);
+	}
+	std::cout << "\n";
+}
+
+// Written as benchmark_results/[prefix]tail_benchmark_[float_name].csv (percentiles)
+// and benchmark_results/[prefix]tail_histograms_benchmark_[float_name].csv (nonempty buckets)
+template <class Float>
+static void write_tail_results(std::string_view prefix, std::string_view float_name,
+	typename benchmark_holder<Float>::tail_output_type const& out)
+{
+	auto filename = result_filename(prefix, "tail_benchmark", float_name);
+	std::ofstream out_file{ filename };
+	out_file << "name,bucket,count,p50,p90,p99,p99.9,max\n";
+
+	constexpr double percentiles[] = { 50, 90, 99, 99.9 };
+	std::cout << "\n" << std::left << std::setw(40) << "name" << std::setw(18) << "bucket" <<
+		std::right << std::setw(10) << "p50(ns)" << std::setw(10) << "p90(ns)" <<
+		std::setw(10) << "p99(ns)" << std::setw(10) << "p99.9(ns)" << std::setw(11) << "max(ns)\n";
+	for (auto& name_result_pair : out) {
+		for (auto const& result : name_result_pair.second) {
+			auto const& histogram = result.histogram;
+			out_file << "\"" << name_result_pair.first << "\"," << result.bucket << "," <<
+				histogram.total_count();
+			std::cout << std::left << std::setw(40) << name_result_pair.first <<
+				std::setw(18) << result.bucket << std::right << std::fixed << std::setprecision(1);
+			for (auto const percentile : percentiles) {
+				auto const value = tsc_clock::to_nanoseconds(histogram.value_at_percentile(percentile));
+				out_file << "," << value;
+				std::cout << std::setw(10) << value;
+			}
+			auto const max = tsc_clock::to_nanoseconds(histogram.max());
+			out_file << "," << max << "\n";
+			std::cout << std::setw(10) << max << "\n" << std::defaultfloat << std::setprecision(6);
+		}
+	}
+	std::cout << "\n";
+	out_file.close();
+
+	filename = result_filename(prefix, "tail_histograms_benchmark", float_name);
+	out_file.open(filename);
+	out_file << "name,bucket,lower_ns,upper_ns,count\n";
+
+	for (auto& name_result_pair : out) {
+		for (auto const& result : name_result_pair.second) {
+			for (std::size_t i = 0; i < latency_histogram::number_of_buckets; ++i) {
+				if (result.histogram.count(i) == 0) {
+					continue;
+				}
+				out_file << "\"" << name_result_pair.first << "\"," << result.bucket << "," <<
+					tsc_clock::to_nanoseconds(latency_histogram::lower_bound(i)) << "," <<
+					tsc_clock::to_nanoseconds(latency_histogram::upper_bound(i)) << "," <<
+					result.histogram.count(i) << "\n";
+			}
+		}
+	}
+	out_file.close();
+}
+
+// Written as benchmark_results/[prefix]policies_benchmark_[float_name].csv
+// The relative cost is with respect to nearest_to_even with tie_to_even, the default
+template <class Float>
+static void write_policy_results(std::string_view prefix, std::string_view float_name,
+	typename benchmark_holder<Float>::policies_output_type const& out)
+{
+	auto filename = result_filename(prefix, "policies_benchmark", float_name);
+	std::ofstream out_file{ filename };
+	out_file << "rounding_mode,correct_rounding_search,bucket,ns_per_value,relative\n";
+
+	auto default_time = [&out](std::string const& bucket) {
+		for (auto const& result : out) {
+			if (result.bucket == bucket && result.rounding_mode == "nearest_to_even" &&
+				result.correct_rounding_search == "tie_to_even")
+			{
+				return result.nanoseconds_per_value;
+			}
+		}
+		return 0.0;
+	};
+
+	// Print a matrix for each bucket; rows and columns are in the order of registration
+	std::string current_bucket;
+	std::vector<std::string> columns;
+	for (auto const& result : out) {
+		auto const relative = result.nanoseconds_per_value / default_time(result.bucket);
+		out_file << result.rounding_mode << "," << result.correct_rounding_search << "," <<
+			result.bucket << "," << result.nanoseconds_per_value << "," << relative << "\n";
+
+		if (result.bucket != current_bucket) {
+			if (!current_bucket.empty()) {
+				std::cout << "\n";
+			}
+			current_bucket = result.bucket;
+			columns.clear();
+			for (auto const& r : out) {
+				if (r.bucket == current_bucket && std::find(columns.begin(), columns.end(),
+					r.correct_rounding_search) == columns.end())
+				{
+					columns.push_back(r.correct_rounding_search);
+				}
+			}
+			std::cout << "\nns/value (relative to nearest_to_even/tie_to_even) with " <<
+				current_bucket << " samples\n" << std::left << std::setw(48) << "" << std::right;
+			for (auto const& column : columns) {
+				std::cout << std::setw(18) << column;
+			}
+		}
+		if (result.correct_rounding_search == columns.front()) {
+			std::cout << "\n" << std::left << std::setw(48) << result.rounding_mode << std::right;
+		}
+		std::cout << std::fixed << std::setprecision(2) << std::setw(10) <<
+			result.nanoseconds_per_value << " (" << std::setw(4) << relative << ")" <<
+			std::defaultfloat << std::setprecision(6);
+	}
+	std::cout << "\n\n";
+}
+
+// Written as benchmark_results/[prefix]components_benchmark_[float_name].csv
+static void write_component_results(std::string_view prefix, std::string_view float_name,
+	std::vector<component_result> const& results)
+{
+	auto filename = result_filename(prefix, "components_benchmark", float_name);
+	std::ofstream out_file{ filename };
+	out_file << "component,number_of_inputs,ns_per_call\n";
+
+	std::cout << "\n" << std::left << std::setw(40) << "component" << std::right <<
+		std::setw(12) << "inputs" << std::setw(12) << "ns/call\n";
+	for (auto const& result : results) {
+		out_file << "\"" << result.name << "\"," << result.number_of_inputs << "," <<
+			result.nanoseconds_per_call << "\n";
+
+		std::cout << std::left << std::setw(40) << result.name << std::right <<
+			std::setw(12) << result.number_of_inputs << std::fixed << std::setprecision(2) <<
+			std::setw(11) << result.nanoseconds_per_call << "\n" <<
+			std::defaultfloat << std::setprecision(6);
+	}
+	std::cout << "\n";
+}
+
+// Run the benchmarks selected in params with the samples prepared in benchmark_holder<Float>
+template <class Float>
+static void run_benchmarks(std::string_view prefix, std::string_view float_name,
+	std::string_view description, benchmark_parameters const& params,
+	std::size_t number_of_uniform_samples, std::size_t number_of_digits_samples_per_digits)
+{
+	auto& inst = benchmark_holder<Float>::get_instance();
+	inst.prepare_datasets(params.number_of_dataset_samples);
+
+	if (params.verify && !verify_functions<Float>(description)) {
+		std::cout << "Verification failed.\n";
+		std::exit(EXIT_FAILURE);
+	}
+
+	if (params.measure_latency) {
+		typename benchmark_holder<Float>::output_type out;
+		typename benchmark_holder<Float>::counters_output_type counters;
+		typename benchmark_holder<Float>::repetition_means_output_type repetition_means;
+		inst.run(params, description, out, params.measure_perf_counters ? &counters : nullptr,
+			&repetition_means);
+
+		write_benchmark_results<Float>(prefix, float_name, out,
+			number_of_uniform_samples, number_of_digits_samples_per_digits,
+			params.measure_perf_counters ? &counters : nullptr);
+
+		typename benchmark_holder<Float>::datasets_output_type datasets_out;
+		typename benchmark_holder<Float>::datasets_repetition_means_output_type
+			datasets_repetition_means;
+		if (params.number_of_dataset_samples != 0) {
+			inst.run_datasets(params, description, datasets_out, &datasets_repetition_means);
+			write_datasets_results<Float>(prefix, float_name, datasets_out);
+		}
+
+		write_result_store<Float>(prefix, float_name, out, repetition_means,
+			datasets_out, datasets_repetition_means);
+	}
+
+	// Written with the prefix [prefix]decomposition_
+	if (params.measure_decompositions) {
+		typename benchmark_holder<Float>::output_type out;
+		inst.run_decompositions(params, description, out);
+		write_benchmark_results<Float>(std::string(prefix) + "decomposition_", float_name, out,
+			number_of_uniform_samples, number_of_digits_samples_per_digits);
+	}
+
+	if (params.measure_throughput) {
+		typename benchmark_holder<Float>::throughput_output_type out;
+		inst.run_throughput(params, description, out);
+		write_throughput_results<Float>(prefix, float_name, out);
+	}
+
+	if (params.measure_scaling) {
+		typename benchmark_holder<Float>::scaling_output_type out;
+		inst.run_scaling(params, description, out);
+		write_scaling_results<Float>(prefix, float_name, out);
+	}
+
+	if (params.number_of_cold_samples != 0) {
+		typename benchmark_holder<Float>::cold_output_type out;
+		inst.run_cold(params, description, out);
+		write_cold_results<Float>(prefix, float_name, out);
+	}
+
+	if (params.measure_tail_latency) {
+		typename benchmark_holder<Float>::tail_output_type out;
+		inst.run_tail(params, description, out);
+		write_tail_results<Float>(prefix, float_name, out);
+	}
+
+	if (params.measure_policies) {
+		typename benchmark_holder<Float>::policies_output_type out;
+		inst.run_policies(params, description, out);
+		write_policy_results<Float>(prefix, float_name, out);
+	}
+
+	if (params.measure_components) {
+		std::cout << "Benchmarking the steps of Grisu-Exact with " << description << "'s...\n";
+		write_component_results(prefix, float_name,
+			run_component_benchmarks(inst.shuffled_samples(), params.number_of_repetitions));
+	}
+}
+
+// Load the samples from the first of params.sample_files containing Float's, if any
+// The numbers of samples are updated to those in the file
+template <class Float>
+static bool load_samples(benchmark_parameters const& params,
+	std::size_t& number_of_uniform_samples, std::size_t& number_of_digits_samples_per_digits)
+{
+	auto& inst = benchmark_holder<Float>::get_instance();
+	for (auto const& filename : params.sample_files) {
+		sample_file file;
+		auto error = file.open(filename);
+		if (error.empty() && file.header().float_size != sizeof(Float)) {
+			continue;
+		}
+		if (error.empty()) {
+			error = inst.load_samples(file);
+		}
+		if (!error.empty()) {
+			std::cerr << error << "\n";
+			std::exit(EXIT_FAILURE);
+		}
+
+		std::cout << "Loaded samples from " << filename << " (seed " << file.header().seed << ").\n";
+		number_of_uniform_samples = inst.number_of_samples(0);
+		number_of_digits_samples_per_digits = inst.number_of_samples(1);
+		return true;
+	}
+	return false;
+}
+
+template <class Float>
+static void benchmark_test(std::string_view float_name,
+	std::size_t number_of_uniform_samples, std::size_t number_of_digits_samples_per_digits,
+	benchmark_parameters const& params)
+{
+	auto& inst = benchmark_holder<Float>::get_instance();
+	if (!load_samples<Float>(params, number_of_uniform_samples,
+		number_of_digits_samples_per_digits))
+	{
+		if (params.use_seed) {
+			inst.seed(params.seed);
+		}
+		std::cout << "Generating random samples...\n";
+		inst.prepare_samples(number_of_uniform_samples, number_of_digits_samples_per_digits);
+	}
+	run_benchmarks<Float>("", float_name, float_name, params,
+		number_of_uniform_samples, number_of_digits_samples_per_digits);
+
 #ifdef RUN_MATLAB
 	run_matlab();
 #endif
 }
 
+static benchmark_parameters make_parameters(std::size_t number_of_iterations)
+{
+	benchmark_parameters params;
+	params.number_of_iterations = number_of_iterations;
+	return params;
+}
+
 void benchmark_test_float(std::size_t number_of_uniform_samples,
-	std::size_t number_of_digits_samples_per_digits, std::size_t number_of_iterations)
+	std::size_t number_of_digits_samples_per_digits, benchmark_parameters const& params)
 {
 	std::cout << "[Running benchmark for binary32...]\n";
 	benchmark_test<float>("binary32", number_of_uniform_samples,
-		number_of_digits_samples_per_digits, number_of_iterations);
+		number_of_digits_samples_per_digits, params);
 	std::cout << "Done.\n\n\n";
 }
 
-void benchmark_test_double(std::size_t number_of_uniform_samples,
+void benchmark_test_float(std::size_t number_of_uniform_samples,
 	std::size_t number_of_digits_samples_per_digits, std::size_t number_of_iterations)
+{
+	benchmark_test_float(number_of_uniform_samples, number_of_digits_samples_per_digits,
+		make_parameters(number_of_iterations));
+}
+
+void benchmark_test_double(std::size_t number_of_uniform_samples,
+	std::size_t number_of_digits_samples_per_digits, benchmark_parameters const& params)
 {
 	std::cout << "[Running benchmark for binary64...]\n";
 	benchmark_test<double>("binary64", number_of_uniform_samples,
-		number_of_digits_samples_per_digits, number_of_iterations);
+		number_of_digits_samples_per_digits, params);
 	std::cout << "Done.\n\n\n";
+}
+
+void benchmark_test_double(std::size_t number_of_uniform_samples,
+	std::size_t number_of_digits_samples_per_digits, std::size_t number_of_iterations)
+{
+	benchmark_test_double(number_of_uniform_samples, number_of_digits_samples_per_digits,
+		make_parameters(number_of_iterations));
+}
+
+void benchmark_test_widened_float(std::size_t number_of_uniform_samples,
+	std::size_t number_of_digits_samples_per_digits, benchmark_parameters const& params)
+{
+	std::cout << "[Running benchmark for binary64 widened from binary32...]\n";
+	auto& inst = benchmark_holder<double>::get_instance();
+	if (params.use_seed) {
+		inst.seed(params.seed);
+	}
+	std::cout << "Generating random samples...\n";
+	inst.prepare_widened_samples<float>(number_of_uniform_samples,
+		number_of_digits_samples_per_digits);
+	run_benchmarks<double>("widened_float_", "binary64", "binary64 (widened from binary32)",
+		params, number_of_uniform_samples, number_of_digits_samples_per_digits);
+	std::cout << "Done.\n\n\n";
+}
+
+void benchmark_test_widened_float(std::size_t number_of_uniform_samples,
+	std::size_t number_of_digits_samples_per_digits, std::size_t number_of_iterations)
+{
+	benchmark_test_widened_float(number_of_uniform_samples, number_of_digits_samples_per_digits,
+		make_parameters(number_of_iterations));
 }
\ No newline at end of file
@@ -18,15 +18,114 @@
 #ifndef JKJ_GRISU_EXACT_BENCHMARK
 #define JKJ_GRISU_EXACT_BENCHMARK
 
-#include "../tests/random_float.h"
+#include "../common/random_float.h"
+#include "../common/sample_file.h"
+#include "cpu_utils.h"
+#include "datasets.h"
+#include "latency_histogram.h"
+#include "perf_counters.h"
+#include "statistics.h"
+#include "tsc_clock.h"
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
 #include <string_view>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include <unordered_map>
 #include <vector>
 
+struct benchmark_parameters {
+	// Number of calls timed together for each measurement
+	std::size_t number_of_iterations = 1000;
+	// Number of untimed calls made for each sample before measuring it
+	std::size_t number_of_warmup_iterations = 100;
+	// Each sample is measured this many times, and the median is taken
+	std::size_t number_of_repetitions = 1;
+	// Number of samples in each of the named datasets; no datasets if zero
+	std::size_t number_of_dataset_samples = 0;
+	// Collect hardware performance counters for each digits bucket
+	bool measure_perf_counters = false;
+
+	// Check the outputs of every function against jkj::fp_to_chars before measuring
+	bool verify = false;
+
+	// Measure the time for repeated calls on each sample
+	bool measure_latency = true;
+	// Measure the time for calls over shuffled arrays, one call per element
+	bool measure_throughput = false;
+	// Generate the samples from this seed instead of std::random_device
+	bool use_seed = false;
+	std::uint64_t seed = 0;
+	// Load the samples from these files (see make_sample_file.cpp) instead of generating them;
+	// each file is used for the type it contains
+	std::vector<std::string> sample_files;
+
+	// Measure the functions registered with register_decomposition_for_benchmark
+	// the same way as the latency benchmark
+	bool measure_decompositions = false;
+	// Measure the individual steps of Grisu-Exact over the shuffled samples
+	bool measure_components = false;
+	// Number of samples to measure with cold caches; no cold-cache measurement if zero
+	// A buffer of eviction_buffer_size bytes is walked before each call; it should be
+	// larger than the L2 to evict L1/L2, or larger than the LLC to evict everything
+	std::size_t number_of_cold_samples = 0;
+	std::size_t eviction_buffer_size = std::size_t(32) << 20;
+	// Time every call separately and report the percentiles of the latencies
+	bool measure_tail_latency = false;
+	// Measure the throughput of every combination of rounding mode and correct rounding search
+	bool measure_policies = false;
+
+	// Measure the aggregate throughput of 1 ~ max_number_of_threads threads,
+	// each converting a private shuffled copy of the uniform samples
+	bool measure_scaling = false;
+	std::size_t max_number_of_threads = 1;
+	// If pin_scaling_threads is true and there are enough CPUs, thread i is pinned to
+	// scaling_cpus[i]; otherwise, threads may run on any of scaling_cpus (if not empty)
+	std::vector<int> scaling_cpus;
+	bool pin_scaling_threads = true;
+	// Names of the functions to run; every function if empty
+	std::vector<std::string> scaling_function_names = {
+		"Grisu-Exact", "Grisu-Exact (w/o correct rounding)", "Ryu"
+	};
+};
+
+template <class FunctionPointer>
+struct benchmark_function_traits;
+
+template <class Float>
+struct benchmark_function_traits<void(*)(Float, char*)> {
+	using float_type = Float;
+};
+
+// Wraps a conversion function as a template argument,
+// so that the benchmark loops call it directly rather than through a pointer
+template <auto func>
+struct benchmark_function {
+	using float_type = typename benchmark_function_traits<decltype(func)>::float_type;
+
+	static void repeat(float_type x, std::size_t number_of_iterations, char* buffer) {
+		for (std::size_t i = 0; i < number_of_iterations; ++i) {
+			func(x, buffer);
+		}
+	}
+
+	static void stream(float_type const* first, float_type const* last, char* buffer) {
+		for (; first != last; ++first) {
+			func(*first, buffer);
+		}
+	}
+};
+
 template <class Float>
 class benchmark_holder
 {
@@ -43,14 +142,92 @@ public:
 	void prepare_samples(std::size_t number_of_general_samples,
 		std::size_t number_of_digits_samples_per_digits)
 	{
+		auto buckets = generate_benchmark_samples<Float>(number_of_general_samples,
+			number_of_digits_samples_per_digits, rg_);
+		for (unsigned int digits = 0; digits <= max_digits; ++digits) {
+			samples_[digits] = std::move(buckets[digits]);
+		}
+	}
+
+	// Copy the samples from a file written by make_sample_file.cpp
+	// Returns an empty string on success, or an error message
+	std::string load_samples(sample_file const& file)
+	{
+		if (file.header().float_size != sizeof(Float) ||
+			file.number_of_buckets() > max_digits + 1)
+		{
+			return "the sample file is not for this type";
+		}
+		for (unsigned int digits = 0; digits <= max_digits; ++digits) {
+			if (digits < file.number_of_buckets()) {
+				samples_[digits].assign(file.bucket_begin<Float>(digits),
+					file.bucket_end<Float>(digits));
+			}
+			else {
+				samples_[digits].clear();
+			}
+		}
+		return {};
+	}
+
+	// Samples are generated from std::random_device unless seeded
+	void seed(std::uint64_t value)
+	{
+		rg_.seed(value);
+	}
+
+	std::size_t number_of_samples(unsigned int digits) const
+	{
+		return samples_[digits].size();
+	}
+
+	// Generate the named datasets of realistic data; see datasets.h
+	void prepare_datasets(std::size_t number_of_samples_per_dataset)
+	{
+		datasets_.clear();
+		if (number_of_samples_per_dataset != 0) {
+			datasets_ = generate_datasets<Float>(number_of_samples_per_dataset);
+		}
+	}
+
+	// Every sample prepared so far, including the datasets, in a random order
+	std::vector<Float> shuffled_samples()
+	{
+		std::vector<Float> ret;
+		for (auto const& samples : samples_) {
+			ret.insert(ret.end(), samples.begin(), samples.end());
+		}
+		for (auto const& dataset : datasets_) {
+			ret.insert(ret.end(), dataset.second.begin(), dataset.second.end());
+		}
+		std::shuffle(ret.begin(), ret.end(), rg_);
+		return ret;
+	}
+
+	// Generate random samples of Narrower's and widen them into Float's
+	// Digits samples are generated only up to the max_digits of Narrower
+	template <class Narrower>
+	void prepare_widened_samples(std::size_t number_of_general_samples,
+		std::size_t number_of_digits_samples_per_digits)
+	{
+		static_assert(sizeof(Narrower) < sizeof(Float));
+		constexpr auto narrower_max_digits =
+			std::size_t(std::numeric_limits<Narrower>::max_digits10);
+
 		samples_[0].resize(number_of_general_samples);
 		for (auto& sample : samples_[0])
-			sample = uniformly_randomly_generate_general_float<Float>(rg_);
+			sample = Float(uniformly_randomly_generate_general_float<Narrower>(rg_));
 
 		for (unsigned int digits = 1; digits <= max_digits; ++digits) {
-			samples_[digits].resize(number_of_digits_samples_per_digits);
-			for (auto& sample : samples_[digits])
-				sample = randomly_generate_float_with_given_digits<Float>(digits, rg_);
+			if (digits <= narrower_max_digits) {
+				random_float_with_given_digits<Narrower> generator{ digits };
+				samples_[digits].resize(number_of_digits_samples_per_digits);
+				for (auto& sample : samples_[digits])
+					sample = Float(generator(rg_));
+			}
+			else {
+				samples_[digits].clear();
+			}
 		}
 	}
 
@@ -59,17 +236,59 @@ public:
 	using output_type = std::unordered_map<std::string,
 		std::array<std::vector<std::pair<Float, double>>, max_digits + 1>
 	>;
-	void run(std::size_t number_of_iterations, std::string_view float_name, output_type& out)
+	// { "name" : [per-call counter values for each digits] }
+	using counters_output_type = std::unordered_map<std::string,
+		std::array<perf_counters::values_type, max_digits + 1>
+	>;
+	// { "name" : [(digits, [mean over the samples of each repetition])] }
+	using repetition_means_output_type = std::unordered_map<std::string,
+		std::array<std::vector<double>, max_digits + 1>
+	>;
+
+	// Counters are enabled during the whole measurement of each digits bucket,
+	// and divided by the number of calls made, including warmup calls
+	void run(benchmark_parameters const& params, std::string_view float_name, output_type& out,
+		counters_output_type* counters_out = nullptr,
+		repetition_means_output_type* repetition_means_out = nullptr)
 	{
-		assert(number_of_iterations >= 1);
+		assert(params.number_of_iterations >= 1);
+		assert(params.number_of_repetitions >= 1);
 		char buffer[40];
 
-		for (auto const& name_func_pair : name_func_pairs_) {
+		std::unique_ptr<perf_counters> counters;
+		if (counters_out) {
+			counters = std::make_unique<perf_counters>();
+			if (!counters->is_any_available()) {
+				std::cout << "Warning: no hardware performance counter is available.\n";
+			}
+			for (std::size_t idx = 0; idx < perf_counters::number_of_events; ++idx) {
+				if (!counters->is_available(idx)) {
+					std::cout << "Warning: " << perf_counters::event_names[idx] <<
+						" counter is not available.\n";
+				}
+			}
+		}
+
+		for (auto const& name_func_pair : name_funcs_) {
 			auto [result_array_itr, is_inserted] = out.insert_or_assign(
 				name_func_pair.first,
 				std::array<std::vector<std::pair<Float, double>>, max_digits + 1>{});
+			if (counters_out) {
+				(*counters_out)[name_func_pair.first].fill(perf_counters::values_type{});
+			}
+			if (repetition_means_out) {
+				(*repetition_means_out)[name_func_pair.first].fill({});
+			}
+
+			// Warm up caches and branch predictors with every sample once
+			for (auto const& samples : samples_) {
+				name_func_pair.second.stream(samples.data(), samples.data() + samples.size(), buffer);
+			}
 
 			for (unsigned int digits = 0; digits <= max_digits; ++digits) {
+				if (samples_[digits].empty()) {
+					continue;
+				}
 				(*result_array_itr).second[digits].resize(samples_[digits].size());
 				auto out_itr = (*result_array_itr).second[digits].begin();
 
@@ -83,22 +302,88 @@ public:
 						"'s of " << digits << " digits...\n";
 				}
 
-				for (Float sample : samples_[digits]) {
-					auto from = std::chrono::high_resolution_clock::now();
-					for (std::size_t i = 0; i < number_of_iterations; ++i) {
-						name_func_pair.second(sample, buffer);
+				if (counters) {
+					counters->start();
+				}
+				measure_latencies(params, name_func_pair.second.repeat, samples_[digits], out_itr,
+					repetition_means_out ?
+					&(*repetition_means_out)[name_func_pair.first][digits] : nullptr);
+				if (counters) {
+					counters->stop();
+					auto values = counters->read();
+					auto const number_of_calls = double(samples_[digits].size()) *
+						double(params.number_of_warmup_iterations +
+							params.number_of_repetitions * params.number_of_iterations);
+					for (auto& value : values) {
+						value /= number_of_calls;
 					}
-					auto dur = std::chrono::high_resolution_clock::now() - from;
+					(*counters_out)[name_func_pair.first][digits] = values;
+				}
+			}
+		}
+	}
+
+	// { "name" : [(dataset name, [(sample, measured_time)])] }
+	using datasets_output_type = std::unordered_map<std::string,
+		std::vector<std::pair<std::string, std::vector<std::pair<Float, double>>>>
+	>;
+	// { "name" : [(dataset name, [mean over the samples of each repetition])] }
+	using datasets_repetition_means_output_type = std::unordered_map<std::string,
+		std::vector<std::pair<std::string, std::vector<double>>>
+	>;
+
+	// Same as run(), but with the named datasets
+	void run_datasets(benchmark_parameters const& params, std::string_view float_name,
+		datasets_output_type& out,
+		datasets_repetition_means_output_type* repetition_means_out = nullptr)
+	{
+		assert(params.number_of_iterations >= 1);
+		assert(params.number_of_repetitions >= 1);
+		char buffer[40];
 
-					*out_itr = { sample,
-						double(std::chrono::duration_cast<std::chrono::nanoseconds>(dur).count())
-						/ double(number_of_iterations) };
-					++out_itr;
+		for (auto const& name_func_pair : name_funcs_) {
+			auto& results = out[name_func_pair.first];
+			results.clear();
+			if (repetition_means_out) {
+				(*repetition_means_out)[name_func_pair.first].clear();
+			}
+
+			for (auto const& [dataset_name, samples] : datasets_) {
+				name_func_pair.second.stream(samples.data(), samples.data() + samples.size(), buffer);
+			}
+
+			for (auto const& [dataset_name, samples] : datasets_) {
+				std::cout << "Benchmarking " << name_func_pair.first << " with " <<
+					float_name << "'s from the dataset " << dataset_name << "...\n";
+
+				results.emplace_back(dataset_name,
+					std::vector<std::pair<Float, double>>(samples.size()));
+				std::vector<double>* repetition_means = nullptr;
+				if (repetition_means_out) {
+					auto& means = (*repetition_means_out)[name_func_pair.first];
+					means.emplace_back(dataset_name, std::vector<double>{});
+					repetition_means = &means.back().second;
 				}
+				measure_latencies(params, name_func_pair.second.repeat, samples,
+					results.back().second.begin(), repetition_means);
 			}
 		}
 	}
 
+	void run(std::size_t number_of_iterations, std::string_view float_name, output_type& out)
+	{
+		benchmark_parameters params;
+		params.number_of_iterations = number_of_iterations;
+		run(params, float_name, out);
+	}
+
+	output_type run(benchmark_parameters const& params, std::string_view float_name)
+	{
+		output_type out;
+		run(params, float_name, out);
+		return out;
+	}
+
 	output_type run(std::size_t number_of_iterations, std::string_view float_name)
 	{
 		output_type out;
@@ -106,9 +391,431 @@ public:
 		return out;
 	}
 
-	void register_function(std::string_view name, void(*func)(Float, char*))
+	struct throughput_result {
+		std::string	dataset_name;
+		std::size_t	number_of_values;
+		double		nanoseconds_per_value;
+	};
+	// { "name" : [results for each dataset] }
+	using throughput_output_type = std::unordered_map<std::string,
+		std::vector<throughput_result>
+	>;
+
+	// Call each function once for every element of shuffled arrays: the uniform samples,
+	// the digits samples of each digits, all digits samples mixed, and the named datasets
+	void run_throughput(benchmark_parameters const& params, std::string_view float_name,
+		throughput_output_type& out)
+	{
+		assert(params.number_of_repetitions >= 1);
+		char buffer[40];
+		std::vector<double> repetition_times(params.number_of_repetitions);
+
+		std::vector<std::pair<std::string, std::vector<Float>>> datasets;
+		datasets.emplace_back("uniform", samples_[0]);
+		std::vector<Float> mixed;
+		for (unsigned int digits = 1; digits <= max_digits; ++digits) {
+			datasets.emplace_back("digits_" + std::to_string(digits), samples_[digits]);
+			mixed.insert(mixed.end(), samples_[digits].begin(), samples_[digits].end());
+		}
+		datasets.emplace_back("mixed", std::move(mixed));
+		datasets.insert(datasets.end(), datasets_.begin(), datasets_.end());
+		for (auto& dataset : datasets) {
+			std::shuffle(dataset.second.begin(), dataset.second.end(), rg_);
+		}
+
+		for (auto const& name_func_pair : name_funcs_) {
+			auto& results = out[name_func_pair.first];
+			results.clear();
+			std::cout << "Benchmarking throughput of " << name_func_pair.first <<
+				" with " << float_name << "'s...\n";
+
+			for (auto const& [dataset_name, values] : datasets) {
+				if (values.empty()) {
+					continue;
+				}
+				auto const first = values.data();
+				auto const last = values.data() + values.size();
+
+				name_func_pair.second.stream(first, last, buffer);
+				for (auto& time : repetition_times) {
+					auto const from = tsc_clock::start();
+					name_func_pair.second.stream(first, last, buffer);
+					auto const to = tsc_clock::stop();
+					time = tsc_clock::to_nanoseconds(to - from) / double(values.size());
+				}
+				results.push_back({ dataset_name, values.size(), median_of(repetition_times) });
+			}
+		}
+	}
+
+	struct verification_result {
+		std::size_t	number_of_samples = 0;
+		std::size_t	number_of_round_trip_failures = 0;
+		// Compared to the number of significant digits in the output of the reference
+		std::size_t	number_of_longer_outputs = 0;
+		std::size_t	number_of_shorter_outputs = 0;
+		// Set for rows registered as narrowest; their outputs may be read back as float
+		bool		narrowest = false;
+	};
+	// { "name" : result }
+	using verification_output_type = std::unordered_map<std::string, verification_result>;
+
+	// Check that the output of each function reads back to the input,
+	// and compare its number of significant digits with that of the reference
+	void verify(void(*reference)(Float, char*), verification_output_type& out)
+	{
+		char buffer[40];
+		char reference_buffer[40];
+
+		for (auto const& name_func_pair : name_funcs_) {
+			auto& result = out[name_func_pair.first];
+			result = {};
+			result.narrowest = name_func_pair.second.narrowest;
+
+			auto check = [&](std::vector<Float> const& samples) {
+				for (Float sample : samples) {
+					// Outputs for NaN's and infinities are not meant to be read back
+					if (!std::isfinite(sample)) {
+						continue;
+					}
+					name_func_pair.second.stream(&sample, &sample + 1, buffer);
+					reference(sample, reference_buffer);
+					++result.number_of_samples;
+
+					Float parsed;
+					bool round_trip;
+					if constexpr (sizeof(Float) == 4) {
+						parsed = std::strtof(buffer, nullptr);
+						round_trip = std::memcmp(&parsed, &sample, sizeof(Float)) == 0;
+					}
+					else {
+						parsed = std::strtod(buffer, nullptr);
+						round_trip = std::memcmp(&parsed, &sample, sizeof(Float)) == 0 ||
+							// Outputs of narrowest rows for doubles that are exactly floats
+							// are meant to be read back as float
+							(name_func_pair.second.narrowest &&
+								double(std::strtof(buffer, nullptr)) == sample);
+					}
+					if (!round_trip) {
+						if (result.number_of_round_trip_failures++ == 0) {
+							std::cout << "Round-trip failure of " << name_func_pair.first <<
+								": " << reference_buffer << " was printed as " << buffer << "\n";
+						}
+					}
+
+					auto const digits = number_of_significant_digits(buffer);
+					auto const reference_digits = number_of_significant_digits(reference_buffer);
+					if (digits > reference_digits) {
+						++result.number_of_longer_outputs;
+					}
+					else if (digits < reference_digits) {
+						++result.number_of_shorter_outputs;
+					}
+				}
+			};
+			for (auto const& samples : samples_) {
+				check(samples);
+			}
+			for (auto const& dataset : datasets_) {
+				check(dataset.second);
+			}
+		}
+	}
+
+	struct scaling_result {
+		std::size_t	number_of_threads;
+		double		values_per_second;
+		// values_per_second divided by number_of_threads times the single-thread throughput
+		double		efficiency;
+	};
+	// { "name" : [results for each number of threads] }
+	using scaling_output_type = std::unordered_map<std::string,
+		std::vector<scaling_result>
+	>;
+
+	// Numbers of threads are powers of 2 up to max_number_of_threads, and max_number_of_threads
+	void run_scaling(benchmark_parameters const& params, std::string_view float_name,
+		scaling_output_type& out)
+	{
+		assert(params.number_of_repetitions >= 1);
+		assert(params.max_number_of_threads >= 1);
+
+		std::vector<std::size_t> thread_counts;
+		for (std::size_t n = 1; n < params.max_number_of_threads; n *= 2) {
+			thread_counts.push_back(n);
+		}
+		thread_counts.push_back(params.max_number_of_threads);
+
+		for (auto const& name_func_pair : name_funcs_) {
+			auto const& names = params.scaling_function_names;
+			if (!names.empty() &&
+				std::find(names.begin(), names.end(), name_func_pair.first) == names.end())
+			{
+				continue;
+			}
+
+			auto& results = out[name_func_pair.first];
+			results.clear();
+			std::cout << "Benchmarking scaling of " << name_func_pair.first <<
+				" with " << float_name << "'s...\n";
+
+			for (auto const number_of_threads : thread_counts) {
+				auto const values_per_second = measure_scaling(params,
+					name_func_pair.second.stream, number_of_threads);
+				auto const efficiency = results.empty() ? 1.0 : values_per_second /
+					(double(number_of_threads) * results.front().values_per_second);
+				results.push_back({ number_of_threads, values_per_second, efficiency });
+			}
+		}
+	}
+
+	struct cold_result {
+		std::size_t	number_of_samples;
+		// Single calls right after walking the eviction buffer
+		double		median;
+		double		percentile_90;
+		double		mean;
+		// The same single calls repeated right after the cold ones
+		double		warm_median;
+	};
+	// { "name" : result }
+	using cold_output_type = std::unordered_map<std::string, cold_result>;
+
+	// Time single calls on randomly chosen samples, each preceded by walking a buffer
+	// so that the tables used by the function have been evicted from the caches
+	// Whether the code is also evicted depends on the inclusiveness of the caches.
+	void run_cold(benchmark_parameters const& params, std::string_view float_name,
+		cold_output_type& out)
+	{
+		char buffer[40];
+		auto samples = shuffled_samples();
+		samples.erase(std::remove_if(samples.begin(), samples.end(),
+			[](Float x) { return !std::isfinite(x); }), samples.end());
+		if (samples.size() > params.number_of_cold_samples) {
+			samples.resize(params.number_of_cold_samples);
+		}
+		if (samples.empty()) {
+			return;
+		}
+
+		std::vector<unsigned char> eviction_buffer(params.eviction_buffer_size);
+		unsigned int eviction_sink = 0;
+		auto const overhead = tsc_clock::overhead();
+		auto time_one_call = [&](void(*repeat)(Float, std::size_t, char*), Float x) {
+			auto const from = tsc_clock::start();
+			repeat(x, 1, buffer);
+			auto const to = tsc_clock::stop();
+			auto ticks = to - from;
+			return tsc_clock::to_nanoseconds(ticks > overhead ? ticks - overhead : 0);
+		};
+
+		std::vector<double> cold_times(samples.size());
+		std::vector<double> warm_times(samples.size());
+		for (auto const& name_func_pair : name_funcs_) {
+			std::cout << "Benchmarking cold-cache latency of " << name_func_pair.first <<
+				" with " << float_name << "'s...\n";
+
+			auto const repeat = name_func_pair.second.repeat;
+			for (std::size_t i = 0; i < samples.size(); ++i) {
+				// Write to every cache line so that the lines are also dirty
+				for (std::size_t j = 0; j < eviction_buffer.size(); j += 64) {
+					eviction_sink += eviction_buffer[j]++;
+				}
+				// Finishes the walk before the call, and keeps it from being eliminated
+				eviction_sink_ = eviction_sink;
+				cold_times[i] = time_one_call(repeat, samples[i]);
+				warm_times[i] = time_one_call(repeat, samples[i]);
+			}
+
+			auto& result = out[name_func_pair.first];
+			result.number_of_samples = samples.size();
+			result.mean = std::accumulate(cold_times.begin(), cold_times.end(), 0.0) /
+				double(cold_times.size());
+			result.warm_median = median_of(warm_times);
+			std::sort(cold_times.begin(), cold_times.end());
+			result.median = median_of(cold_times);
+			result.percentile_90 = cold_times[cold_times.size() * 9 / 10];
+		}
+	}
+
+	struct tail_result {
+		// "uniform", "digits_[n]", the name of a dataset, or "all" for all of them merged
+		std::string			bucket;
+		// Per-call latencies in TSC ticks, with the timer overhead subtracted
+		latency_histogram	histogram;
+	};
+	// { "name" : [results for each bucket] }
+	using tail_output_type = std::unordered_map<std::string, std::vector<tail_result>>;
+
+	// Time every single call over shuffled samples of each bucket, number_of_repetitions times,
+	// and count the latencies in histograms, so that rare slow paths are not averaged away
+	void run_tail(benchmark_parameters const& params, std::string_view float_name,
+		tail_output_type& out)
+	{
+		assert(params.number_of_repetitions >= 1);
+		char buffer[40];
+
+		std::vector<std::pair<std::string, std::vector<Float>>> buckets;
+		buckets.emplace_back("uniform", samples_[0]);
+		for (unsigned int digits = 1; digits <= max_digits; ++digits) {
+			buckets.emplace_back("digits_" + std::to_string(digits), samples_[digits]);
+		}
+		buckets.insert(buckets.end(), datasets_.begin(), datasets_.end());
+		for (auto& bucket : buckets) {
+			std::shuffle(bucket.second.begin(), bucket.second.end(), rg_);
+		}
+
+		auto const overhead = tsc_clock::overhead();
+		for (auto const& name_func_pair : name_funcs_) {
+			auto& results = out[name_func_pair.first];
+			results.clear();
+			std::cout << "Benchmarking tail latency of " << name_func_pair.first <<
+				" with " << float_name << "'s...\n";
+
+			auto const repeat = name_func_pair.second.repeat;
+			latency_histogram all;
+			for (auto const& [bucket_name, values] : buckets) {
+				if (values.empty()) {
+					continue;
+				}
+				name_func_pair.second.stream(values.data(), values.data() + values.size(), buffer);
+
+				results.push_back({ bucket_name, {} });
+				auto& histogram = results.back().histogram;
+				for (std::size_t i = 0; i < params.number_of_repetitions; ++i) {
+					for (auto const x : values) {
+						auto const from = tsc_clock::start();
+						repeat(x, 1, buffer);
+						auto const to = tsc_clock::stop();
+						auto const ticks = to - from;
+						histogram.record(ticks > overhead ? ticks - overhead : 0);
+					}
+				}
+				all.merge(histogram);
+			}
+			results.push_back({ "all", all });
+		}
+	}
+
+	struct policy_result {
+		std::string	rounding_mode;
+		std::string	correct_rounding_search;
+		// "uniform", "digits" (all digits samples mixed), or "datasets" (all datasets mixed)
+		std::string	bucket;
+		double		nanoseconds_per_value;
+	};
+	using policies_output_type = std::vector<policy_result>;
+
+	// Call each policy combination once for every element of shuffled arrays, like
+	// run_throughput(); repetitions go over all the combinations in turn, so that a drift
+	// of the clock speed affects every combination alike, and the median is taken
+	void run_policies(benchmark_parameters const& params, std::string_view float_name,
+		policies_output_type& out)
+	{
+		assert(params.number_of_repetitions >= 1);
+		char buffer[40];
+
+		std::vector<std::pair<std::string, std::vector<Float>>> buckets;
+		buckets.emplace_back("uniform", samples_[0]);
+		buckets.emplace_back("digits", std::vector<Float>{});
+		for (unsigned int digits = 1; digits <= max_digits; ++digits) {
+			buckets.back().second.insert(buckets.back().second.end(),
+				samples_[digits].begin(), samples_[digits].end());
+		}
+		buckets.emplace_back("datasets", std::vector<Float>{});
+		for (auto const& dataset : datasets_) {
+			buckets.back().second.insert(buckets.back().second.end(),
+				dataset.second.begin(), dataset.second.end());
+		}
+		buckets.erase(std::remove_if(buckets.begin(), buckets.end(),
+			[](auto const& bucket) { return bucket.second.empty(); }), buckets.end());
+		for (auto& bucket : buckets) {
+			std::shuffle(bucket.second.begin(), bucket.second.end(), rg_);
+		}
+
+		std::cout << "Benchmarking " << policies_.size() << " policy combinations with " <<
+			float_name << "'s...\n";
+		for (auto const& [bucket_name, values] : buckets) {
+			auto const first = values.data();
+			auto const last = values.data() + values.size();
+
+			std::vector<std::vector<double>> times(policies_.size(),
+				std::vector<double>(params.number_of_repetitions));
+			for (auto const& policy : policies_) {
+				policy.function.stream(first, last, buffer);
+			}
+			for (std::size_t i = 0; i < params.number_of_repetitions; ++i) {
+				for (std::size_t policy_idx = 0; policy_idx < policies_.size(); ++policy_idx) {
+					auto const from = tsc_clock::start();
+					policies_[policy_idx].function.stream(first, last, buffer);
+					auto const to = tsc_clock::stop();
+					times[policy_idx][i] = tsc_clock::to_nanoseconds(to - from) / double(values.size());
+				}
+			}
+			for (std::size_t policy_idx = 0; policy_idx < policies_.size(); ++policy_idx) {
+				out.push_back({ policies_[policy_idx].rounding_mode,
+					policies_[policy_idx].correct_rounding_search, bucket_name,
+					median_of(times[policy_idx]) });
+			}
+		}
+	}
+
+	// Same as run() without counters, but with the decomposition functions
+	void run_decompositions(benchmark_parameters const& params, std::string_view float_name,
+		output_type& out)
+	{
+		assert(params.number_of_iterations >= 1);
+		assert(params.number_of_repetitions >= 1);
+		char buffer[40];
+
+		for (auto const& name_func_pair : name_decompositions_) {
+			auto& results = out[name_func_pair.first];
+
+			for (auto const& samples : samples_) {
+				name_func_pair.second.stream(samples.data(), samples.data() + samples.size(), buffer);
+			}
+
+			for (unsigned int digits = 0; digits <= max_digits; ++digits) {
+				if (samples_[digits].empty()) {
+					continue;
+				}
+				std::cout << "Benchmarking decomposition of " << name_func_pair.first <<
+					" with " << float_name << "'s";
+				if (digits != 0) {
+					std::cout << " of " << digits << " digits";
+				}
+				std::cout << "...\n";
+
+				results[digits].resize(samples_[digits].size());
+				measure_latencies(params, name_func_pair.second.repeat, samples_[digits],
+					results[digits].begin());
+			}
+		}
+	}
+
+	template <auto func>
+	void register_function(std::string_view name, bool narrowest = false)
+	{
+		static_assert(std::is_same_v<typename benchmark_function<func>::float_type, Float>);
+		name_funcs_.emplace(name, registered_function{
+			benchmark_function<func>::repeat, benchmark_function<func>::stream, narrowest });
+	}
+
+	template <auto func>
+	void register_decomposition(std::string_view name)
 	{
-		name_func_pairs_.emplace(name, func);
+		static_assert(std::is_same_v<typename benchmark_function<func>::float_type, Float>);
+		name_decompositions_.emplace(name, registered_function{
+			benchmark_function<func>::repeat, benchmark_function<func>::stream });
+	}
+
+	// Policy combinations are reported in the order of registration
+	template <auto func>
+	void register_policy(std::string_view rounding_mode, std::string_view correct_rounding_search)
+	{
+		static_assert(std::is_same_v<typename benchmark_function<func>::float_type, Float>);
+		policies_.push_back({ std::string(rounding_mode), std::string(correct_rounding_search),
+			{ benchmark_function<func>::repeat, benchmark_function<func>::stream } });
 	}
 
 private:
@@ -117,26 +824,180 @@ private:
 	// Digits samples for [1] ~ [max_digits], general samples for [0]
 	std::array<std::vector<Float>, max_digits + 1>			samples_;
 	std::mt19937_64											rg_;
-	std::unordered_map<std::string, void(*)(Float, char*)>	name_func_pairs_;
+	std::vector<std::pair<std::string, std::vector<Float>>>	datasets_;
+
+	// Number of digits of the significand, excluding leading and trailing zeros
+	static std::size_t number_of_significant_digits(char const* str)
+	{
+		char digits[40];
+		std::size_t length = 0;
+		for (; *str != '\0' && *str != 'e' && *str != 'E'; ++str) {
+			if (*str >= '0' && *str <= '9' && (length != 0 || *str != '0')) {
+				digits[length++] = *str;
+			}
+		}
+		while (length != 0 && digits[length - 1] == '0') {
+			--length;
+		}
+		return length;
+	}
+
+	// Measure each sample; the median of repetitions is written into *out_itr
+	// If repetition_means is not null, the mean over the samples of the time measured
+	// in each repetition is written into it
+	template <class OutputIterator>
+	static void measure_latencies(benchmark_parameters const& params,
+		void(*repeat)(Float, std::size_t, char*), std::vector<Float> const& samples,
+		OutputIterator out_itr, std::vector<double>* repetition_means = nullptr)
+	{
+		char buffer[40];
+		std::vector<double> repetition_times(params.number_of_repetitions);
+		std::vector<double> repetition_sums(params.number_of_repetitions);
+		auto const overhead = tsc_clock::overhead();
+
+		for (Float sample : samples) {
+			repeat(sample, params.number_of_warmup_iterations, buffer);
+
+			for (auto& time : repetition_times) {
+				auto const from = tsc_clock::start();
+				repeat(sample, params.number_of_iterations, buffer);
+				auto const to = tsc_clock::stop();
+
+				auto ticks = to - from;
+				ticks = ticks > overhead ? ticks - overhead : 0;
+				time = tsc_clock::to_nanoseconds(ticks) / double(params.number_of_iterations);
+			}
+			for (std::size_t i = 0; i < repetition_times.size(); ++i) {
+				repetition_sums[i] += repetition_times[i];
+			}
+
+			*out_itr = { sample, median_of(repetition_times) };
+			++out_itr;
+		}
+
+		if (repetition_means && !samples.empty()) {
+			repetition_means->resize(repetition_sums.size());
+			for (std::size_t i = 0; i < repetition_sums.size(); ++i) {
+				(*repetition_means)[i] = repetition_sums[i] / double(samples.size());
+			}
+		}
+	}
+
+	// Returns the aggregate number of values converted per second
+	double measure_scaling(benchmark_parameters const& params,
+		void(*stream)(Float const*, Float const*, char*), std::size_t number_of_threads)
+	{
+		auto const& samples = samples_[0];
+		bool const pin = params.pin_scaling_threads &&
+			params.scaling_cpus.size() >= number_of_threads;
+		std::atomic<std::size_t> number_of_ready_threads{ 0 };
+		std::atomic<bool> go{ false };
+		std::vector<double> seconds(number_of_threads);
+		std::vector<std::thread> threads;
+
+		for (std::size_t thread_idx = 0; thread_idx < number_of_threads; ++thread_idx) {
+			threads.emplace_back([&, thread_idx] {
+				if (pin) {
+					pin_current_thread_to_cpu(params.scaling_cpus[thread_idx]);
+				}
+				else if (!params.scaling_cpus.empty()) {
+					// Do not inherit the affinity of the benchmark thread
+					pin_current_thread_to_cpus(params.scaling_cpus);
+				}
+				// Private input, first touched by this thread
+				std::vector<Float> values(samples);
+				std::mt19937_64 rg{ thread_idx };
+				std::shuffle(values.begin(), values.end(), rg);
+				auto const first = values.data();
+				auto const last = values.data() + values.size();
+				char buffer[40];
+				stream(first, last, buffer);
+
+				++number_of_ready_threads;
+				while (!go.load(std::memory_order_acquire)) {}
+
+				auto const from = std::chrono::steady_clock::now();
+				for (std::size_t i = 0; i < params.number_of_repetitions; ++i) {
+					stream(first, last, buffer);
+				}
+				seconds[thread_idx] = std::chrono::duration<double>(
+					std::chrono::steady_clock::now() - from).count();
+			});
+		}
+
+		while (number_of_ready_threads.load() != number_of_threads) {
+			std::this_thread::yield();
+		}
+		go.store(true, std::memory_order_release);
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		// The slowest thread determines the aggregate throughput
+		auto const total_values = double(samples.size()) * double(number_of_threads) *
+			double(params.number_of_repetitions);
+		return total_values / *std::max_element(seconds.begin(), seconds.end());
+	}
+
+	struct registered_function {
+		void(*repeat)(Float, std::size_t, char*);
+		void(*stream)(Float const*, Float const*, char*);
+		// Output may be shorter than the shortest round-trip representation of Float
+		bool narrowest = false;
+	};
+	std::unordered_map<std::string, registered_function>	name_funcs_;
+	std::unordered_map<std::string, registered_function>	name_decompositions_;
+
+	struct registered_policy {
+		std::string			rounding_mode;
+		std::string			correct_rounding_search;
+		registered_function	function;
+	};
+	std::vector<registered_policy>							policies_;
+
+	// Sum of the bytes read while walking the eviction buffer
+	static inline volatile unsigned int						eviction_sink_;
 };
 
+// Usage: register_function_for_benchmark dummy("name",
+//     benchmark_function<float_to_chars>{}, benchmark_function<double_to_chars>{});
 struct register_function_for_benchmark {
-	template <class Float>
-	register_function_for_benchmark(
-		std::string_view name,
-		void(*func)(Float, char*))
+	template <auto... funcs>
+	register_function_for_benchmark(std::string_view name, benchmark_function<funcs>...)
 	{
-		benchmark_holder<Float>::get_instance().register_function(name, func);
-	};
+		(benchmark_holder<typename benchmark_function<funcs>::float_type>::get_instance()
+			.template register_function<funcs>(name), ...);
+	}
+};
 
-	register_function_for_benchmark(
-		std::string_view name,
-		void(*func_float)(float, char*),
-		void(*func_double)(double, char*))
+// Functions printing doubles that are exactly floats as float,
+// e.g., jkj::fp_to_chars_narrowest; verification accepts their shorter outputs
+struct register_narrowest_function_for_benchmark {
+	template <auto... funcs>
+	register_narrowest_function_for_benchmark(std::string_view name, benchmark_function<funcs>...)
 	{
-		benchmark_holder<float>::get_instance().register_function(name, func_float);
-		benchmark_holder<double>::get_instance().register_function(name, func_double);
-	};
+		(benchmark_holder<typename benchmark_function<funcs>::float_type>::get_instance()
+			.template register_function<funcs>(name, true), ...);
+	}
+};
+
+// Functions computing only the decimal significand and exponent, without the string;
+// they should store the result into the buffer so that it cannot be optimized away
+struct register_decomposition_for_benchmark {
+	template <auto... funcs>
+	register_decomposition_for_benchmark(std::string_view name, benchmark_function<funcs>...)
+	{
+		(benchmark_holder<typename benchmark_function<funcs>::float_type>::get_instance()
+			.template register_decomposition<funcs>(name), ...);
+	}
 };
 
+// Entry points; defined in benchmark.cpp
+void benchmark_test_float(std::size_t number_of_uniform_samples,
+	std::size_t number_of_digits_samples_per_digits, benchmark_parameters const& params);
+void benchmark_test_double(std::size_t number_of_uniform_samples,
+	std::size_t number_of_digits_samples_per_digits, benchmark_parameters const& params);
+void benchmark_test_widened_float(std::size_t number_of_uniform_samples,
+	std::size_t number_of_digits_samples_per_digits, benchmark_parameters const& params);
+
 #endif
\ No newline at end of file
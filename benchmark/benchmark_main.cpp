@@ -0,0 +1,249 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// Stand-alone benchmark driver
+// tests/main.cpp remains the entry point for the Visual Studio project;
+// this one is used for the CMake target grisu_exact_benchmark.
+
+#include "benchmark.h"
+#include "cpu_utils.h"
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+namespace {
+	void print_usage(char const* program_name)
+	{
+		std::cout << "Usage: " << program_name << " [options]\n"
+			"  --float                 benchmark binary32 (default: binary32 and binary64)\n"
+			"  --double                benchmark binary64\n"
+			"  --widened-float         benchmark binary64 widened from binary32\n"
+			"  --mode M                latency, throughput, both, or none (default: latency)\n"
+			"  --scaling N             also measure throughput of 1 ~ N threads\n"
+			"  --placement P           for --scaling, pin threads to separate \"cores\" first,\n"
+			"                          to \"smt\" siblings first, or \"none\" (default: cores)\n"
+			"  --uniform-samples N     number of uniformly random samples (default: 1000000)\n"
+			"  --digits-samples N      number of samples per digits (default: 100000)\n"
+			"  --dataset-samples N     number of samples in each realistic dataset (default: 100000)\n"
+			"  --seed S                generate the samples from the seed S instead of random_device\n"
+			"  --samples-file F        load the samples from F, written by grisu_exact_samples,\n"
+			"                          instead of generating them (can be repeated for each type)\n"
+			"  --iterations N          calls timed together per measurement (default: 1000)\n"
+			"  --warmup N              untimed calls per sample before measuring (default: 100)\n"
+			"  --repetitions N         measurements per sample; the median is taken (default: 3)\n"
+			"  --decomposition         also measure the decimal decomposition alone (no string)\n"
+			"  --cold N                also measure single calls on N samples with cold caches\n"
+			"  --evict-bytes N         size of the buffer walked before each cold call\n"
+			"                          (default: 33554432)\n"
+			"  --tail                  also time every call separately and report the p50, p90,\n"
+			"                          p99, p99.9, and max of the latencies\n"
+			"  --policies              also measure the throughput of every combination of\n"
+			"                          rounding mode and correct rounding search\n"
+			"  --components            also measure the individual steps of Grisu-Exact\n"
+			"  --verify                check round-trip of every function's output before measuring;\n"
+			"                          exit with failure if any output does not read back\n"
+			"  --perf-counters         collect hardware performance counters (Linux only)\n"
+			"  --cpu N                 pin to CPU N (default: the current CPU)\n"
+			"  --no-pin                do not pin to any CPU\n"
+			"  --help                  print this message\n";
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bool run_float = false;
+	bool run_double = false;
+	bool run_widened_float = false;
+	std::size_t number_of_uniform_samples = 1000000;
+	std::size_t number_of_digits_samples_per_digits = 100000;
+	benchmark_parameters params;
+	params.number_of_repetitions = 3;
+	params.number_of_dataset_samples = 100000;
+	int cpu = current_cpu();
+	bool pin = true;
+	std::string_view placement = "cores";
+
+	for (int i = 1; i < argc; ++i) {
+		std::string_view arg = argv[i];
+		auto next_number = [&]() -> std::size_t {
+			if (i + 1 >= argc) {
+				std::cerr << "Missing value for " << arg << "\n";
+				std::exit(EXIT_FAILURE);
+			}
+			return std::size_t(std::stoull(argv[++i]));
+		};
+
+		if (arg == "--float") {
+			run_float = true;
+		}
+		else if (arg == "--double") {
+			run_double = true;
+		}
+		else if (arg == "--widened-float") {
+			run_widened_float = true;
+		}
+		else if (arg == "--mode") {
+			if (i + 1 >= argc) {
+				std::cerr << "Missing value for " << arg << "\n";
+				return EXIT_FAILURE;
+			}
+			std::string_view mode = argv[++i];
+			params.measure_latency = (mode == "latency" || mode == "both");
+			params.measure_throughput = (mode == "throughput" || mode == "both");
+			if (!params.measure_latency && !params.measure_throughput && mode != "none") {
+				std::cerr << "Unknown mode: " << mode << "\n";
+				return EXIT_FAILURE;
+			}
+		}
+		else if (arg == "--scaling") {
+			params.measure_scaling = true;
+			params.max_number_of_threads = next_number();
+		}
+		else if (arg == "--placement") {
+			if (i + 1 >= argc) {
+				std::cerr << "Missing value for " << arg << "\n";
+				return EXIT_FAILURE;
+			}
+			placement = argv[++i];
+			if (placement != "cores" && placement != "smt" && placement != "none") {
+				std::cerr << "Unknown placement: " << placement << "\n";
+				return EXIT_FAILURE;
+			}
+		}
+		else if (arg == "--uniform-samples") {
+			number_of_uniform_samples = next_number();
+		}
+		else if (arg == "--digits-samples") {
+			number_of_digits_samples_per_digits = next_number();
+		}
+		else if (arg == "--dataset-samples") {
+			params.number_of_dataset_samples = next_number();
+		}
+		else if (arg == "--seed") {
+			params.use_seed = true;
+			params.seed = std::uint64_t(next_number());
+		}
+		else if (arg == "--samples-file") {
+			if (i + 1 >= argc) {
+				std::cerr << "Missing value for " << arg << "\n";
+				return EXIT_FAILURE;
+			}
+			params.sample_files.emplace_back(argv[++i]);
+		}
+		else if (arg == "--iterations") {
+			params.number_of_iterations = next_number();
+		}
+		else if (arg == "--warmup") {
+			params.number_of_warmup_iterations = next_number();
+		}
+		else if (arg == "--repetitions") {
+			params.number_of_repetitions = next_number();
+		}
+		else if (arg == "--decomposition") {
+			params.measure_decompositions = true;
+		}
+		else if (arg == "--cold") {
+			params.number_of_cold_samples = next_number();
+		}
+		else if (arg == "--evict-bytes") {
+			params.eviction_buffer_size = next_number();
+		}
+		else if (arg == "--tail") {
+			params.measure_tail_latency = true;
+		}
+		else if (arg == "--policies") {
+			params.measure_policies = true;
+		}
+		else if (arg == "--components") {
+			params.measure_components = true;
+		}
+		else if (arg == "--verify") {
+			params.verify = true;
+		}
+		else if (arg == "--perf-counters") {
+			params.measure_perf_counters = true;
+		}
+		else if (arg == "--cpu") {
+			cpu = int(next_number());
+		}
+		else if (arg == "--no-pin") {
+			pin = false;
+		}
+		else if (arg == "--help") {
+			print_usage(argv[0]);
+			return EXIT_SUCCESS;
+		}
+		else {
+			std::cerr << "Unknown option: " << arg << "\n";
+			print_usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if (!run_float && !run_double && !run_widened_float) {
+		run_float = true;
+		run_double = true;
+	}
+	if (params.number_of_iterations == 0 || params.number_of_repetitions == 0 ||
+		(params.measure_scaling && params.max_number_of_threads == 0))
+	{
+		std::cerr << "--iterations, --repetitions, and --scaling must be positive\n";
+		return EXIT_FAILURE;
+	}
+
+	// Computed before pinning the main thread, which narrows the affinity mask
+	if (params.measure_scaling) {
+		params.scaling_cpus = cpus_for_threads(placement == "smt");
+		params.pin_scaling_threads = (placement != "none");
+		if (params.pin_scaling_threads && params.scaling_cpus.size() < params.max_number_of_threads) {
+			std::cout << "Warning: only " << params.scaling_cpus.size() <<
+				" CPUs are available; threads will not be pinned when there are more.\n";
+		}
+	}
+
+	if (pin) {
+		if (pin_current_thread_to_cpu(cpu)) {
+			std::cout << "Pinned to CPU " << cpu << ".\n";
+		}
+		else {
+			std::cout << "Warning: failed to pin to CPU " << cpu << ".\n";
+		}
+	}
+	if (auto governor = cpu_scaling_governor(cpu); !governor.empty() && governor != "performance") {
+		std::cout << "Warning: the scaling governor of CPU " << cpu << " is \"" << governor <<
+			"\"; results may be noisy. Consider setting it to \"performance\".\n";
+	}
+	std::cout << (tsc_clock::is_tsc ? "Using TSC; " : "Using steady_clock; ") <<
+		tsc_clock::ticks_per_nanosecond() << " ticks/ns, timer overhead " <<
+		tsc_clock::overhead() << " ticks.\n\n";
+
+	std::filesystem::create_directories("benchmark_results");
+
+	if (run_float) {
+		benchmark_test_float(number_of_uniform_samples,
+			number_of_digits_samples_per_digits, params);
+	}
+	if (run_double) {
+		benchmark_test_double(number_of_uniform_samples,
+			number_of_digits_samples_per_digits, params);
+	}
+	if (run_widened_float) {
+		benchmark_test_widened_float(number_of_uniform_samples,
+			number_of_digits_samples_per_digits, params);
+	}
+}
\ No newline at end of file
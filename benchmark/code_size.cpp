@@ -0,0 +1,48 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// Instantiates Grisu-Exact for every combination of Float, RoundingMode, and
+// CorrectRoundingSearch, so that benchmark/code_size_report.cmake can report
+// the size of each instantiation and of the static tables with nm.
+// Each combination gets its own entry point code_size_instance<...>;
+// the entry points of static-boundary rounding modes dispatch to several
+// instantiations of grisu_exact_impl<Float>::compute, which are reported separately.
+
+#include "../common/policy_list.h"
+#include <array>
+
+template <class Float, class RoundingMode, class CorrectRoundingSearch>
+jkj::unsigned_fp_t<Float> code_size_instance(Float x)
+{
+	return jkj::grisu_exact<false>(x, RoundingMode{}, CorrectRoundingSearch{});
+}
+
+namespace {
+	template <class Float, class RoundingMode, class... CorrectRoundingSearch>
+	constexpr auto instances_of(type_list<CorrectRoundingSearch...>) {
+		return std::array{ &code_size_instance<Float, RoundingMode, CorrectRoundingSearch>... };
+	}
+
+	template <class Float, class... RoundingMode>
+	constexpr auto instances_of(type_list<RoundingMode...>) {
+		return std::array{ instances_of<Float, RoundingMode>(correct_rounding_searches{})... };
+	}
+}
+
+// Taking the addresses makes every instance emitted
+extern auto const code_size_float_instances = instances_of<float>(rounding_modes{});
+extern auto const code_size_double_instances = instances_of<double>(rounding_modes{});
\ No newline at end of file
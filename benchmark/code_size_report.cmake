@@ -0,0 +1,88 @@
+# Report the sizes of the instantiations of Grisu-Exact and of the static tables
+# Run by the target code_size_report as
+#   cmake -DNM=<nm> -DOBJECTS=<objects of grisu_exact_code_size> -DLIBRARY=<fp_to_chars>
+#         -DOUTPUT=<csv file> -P code_size_report.cmake
+#
+# Every instantiation of grisu_exact_impl<Float>::compute is a separate symbol, named by
+# the interval type provider (the rounding mode, or the one it dispatches to) and the
+# correct rounding search. Static-boundary rounding modes dispatch to several of them,
+# and the entry points code_size_instance<...> show which.
+
+cmake_minimum_required(VERSION 3.12)
+
+foreach(var NM OBJECTS LIBRARY OUTPUT)
+  if(NOT DEFINED ${var})
+    message(FATAL_ERROR "${var} is not defined")
+  endif()
+endforeach()
+
+set(_csv "kind,float,rounding_mode,correct_rounding_search,bytes,symbol\n")
+set(_total_compute_float 0)
+set(_total_compute_double 0)
+set(_total_tables 0)
+set(_total_fp_to_chars 0)
+
+function(_shorten str out)
+  string(REGEX REPLACE "jkj::grisu_exact_[a-z_]+::(detail::)?" "" str "${str}")
+  string(REGEX REPLACE "jkj::fp_to_chars_detail::" "" str "${str}")
+  set(${out} "${str}" PARENT_SCOPE)
+endfunction()
+
+foreach(file IN LISTS OBJECTS LIBRARY)
+  execute_process(COMMAND ${NM} --size-sort -C -t d ${file}
+    OUTPUT_VARIABLE _nm_output RESULT_VARIABLE _result)
+  if(NOT _result EQUAL 0)
+    message(FATAL_ERROR "${NM} failed on ${file}")
+  endif()
+  string(REPLACE ";" "," _nm_output "${_nm_output}")
+  string(REPLACE "\n" ";" _lines "${_nm_output}")
+
+  foreach(line IN LISTS _lines)
+    if(NOT line MATCHES "^([0-9]+) ([A-Za-z]) (.*)$")
+      continue()
+    endif()
+    math(EXPR bytes "${CMAKE_MATCH_1}")
+    set(symbol "${CMAKE_MATCH_3}")
+    set(kind "")
+    set(float "")
+    set(mode "")
+    set(crs "")
+
+    if(symbol MATCHES "grisu_exact_impl<([a-z]+)>::compute<false, ([^,]+), ([^>]+)>")
+      set(kind "compute")
+      set(float "${CMAKE_MATCH_1}")
+      _shorten("${CMAKE_MATCH_2}" mode)
+      _shorten("${CMAKE_MATCH_3}" crs)
+      math(EXPR _total_compute_${float} "${_total_compute_${float}} + ${bytes}")
+    elseif(symbol MATCHES "code_size_instance<([a-z]+), ([^,]+), ([^>]+)>")
+      set(kind "entry")
+      set(float "${CMAKE_MATCH_1}")
+      _shorten("${CMAKE_MATCH_2}" mode)
+      _shorten("${CMAKE_MATCH_3}" crs)
+    elseif(symbol MATCHES "cache_holder<([a-z]+)>::cache|divisibility_test_table_holder<|radix_100_table")
+      set(kind "table")
+      math(EXPR _total_tables "${_total_tables} + ${bytes}")
+    elseif(file STREQUAL LIBRARY)
+      set(kind "fp_to_chars")
+      math(EXPR _total_fp_to_chars "${_total_fp_to_chars} + ${bytes}")
+    elseif(symbol MATCHES "jkj::")
+      set(kind "helper")
+    else()
+      continue()
+    endif()
+
+    _shorten("${symbol}" symbol)
+    string(REPLACE "\"" "\"\"" symbol "${symbol}")
+    string(APPEND _csv "${kind},${float},${mode},${crs},${bytes},\"${symbol}\"\n")
+    if(kind STREQUAL "table")
+      message(STATUS "table ${bytes} bytes: ${symbol}")
+    endif()
+  endforeach()
+endforeach()
+
+file(WRITE ${OUTPUT} "${_csv}")
+message(STATUS "compute instantiations for float: ${_total_compute_float} bytes in total")
+message(STATUS "compute instantiations for double: ${_total_compute_double} bytes in total")
+message(STATUS "static tables: ${_total_tables} bytes in total")
+message(STATUS "fp_to_chars library: ${_total_fp_to_chars} bytes in total")
+message(STATUS "Written ${OUTPUT}")
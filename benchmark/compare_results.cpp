@@ -0,0 +1,211 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// Compare two result files written by the benchmark (benchmark_results/results_*.json)
+// For each (algorithm, bucket) present in both files, the difference of the means is
+// reported with its confidence interval (Welch's approximation). Both are computed from
+// the means over the samples of each repetition, so the interval reflects how much
+// the whole bucket varies from repetition to repetition, not how much the samples differ
+// from each other. A regression is significant if the whole confidence interval of the
+// relative difference lies above the threshold. Records measured with fewer than two
+// repetitions have no confidence interval, and are only reported.
+//
+// Exit code: 0 if there is no significant regression, 1 if there is one, 2 on errors.
+
+#include "result_store.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+	// Mean and the squared standard error of the mean of the finite values
+	struct mean_and_variance {
+		std::size_t	count = 0;
+		double		mean = 0;
+		double		variance_of_mean = 0;
+	};
+	mean_and_variance summarize_repetitions(std::vector<double> const& values)
+	{
+		mean_and_variance ret;
+		double sum = 0;
+		for (auto const value : values) {
+			if (std::isfinite(value)) {
+				++ret.count;
+				sum += value;
+			}
+		}
+		if (ret.count == 0) {
+			return ret;
+		}
+		ret.mean = sum / double(ret.count);
+		if (ret.count >= 2) {
+			double squared_sum = 0;
+			for (auto const value : values) {
+				if (std::isfinite(value)) {
+					squared_sum += (value - ret.mean) * (value - ret.mean);
+				}
+			}
+			ret.variance_of_mean = squared_sum / double(ret.count - 1) / double(ret.count);
+		}
+		return ret;
+	}
+
+	void print_usage(char const* program_name)
+	{
+		std::cout << "Usage: " << program_name << " [options] baseline.json candidate.json\n"
+			"  --threshold T    relative slowdown regarded as a regression (default: 0.02)\n"
+			"  --z Z            z-score of the confidence intervals (default: 1.96, i.e., 95%)\n"
+			"  --name NAME      compare only the given algorithm (can be repeated)\n";
+	}
+
+	void print_file_info(char const* title, benchmark_result_file const& file)
+	{
+		std::cout << title << ": " << file.float_name << ", commit " << file.commit <<
+			", " << file.timestamp << "\n  " << file.compiler << "\n  " << file.flags <<
+			"\n  " << file.cpu << "\n";
+	}
+}
+
+int main(int argc, char** argv)
+{
+	double threshold = 0.02;
+	double z = 1.96;
+	std::vector<std::string> names;
+	std::vector<std::string> filenames;
+
+	for (int i = 1; i < argc; ++i) {
+		std::string_view arg = argv[i];
+		if ((arg == "--threshold" || arg == "--z" || arg == "--name") && i + 1 < argc) {
+			if (arg == "--threshold") {
+				threshold = std::strtod(argv[++i], nullptr);
+			}
+			else if (arg == "--z") {
+				z = std::strtod(argv[++i], nullptr);
+			}
+			else {
+				names.emplace_back(argv[++i]);
+			}
+		}
+		else if (arg == "--help") {
+			print_usage(argv[0]);
+			return EXIT_SUCCESS;
+		}
+		else if (!arg.empty() && arg[0] != '-') {
+			filenames.emplace_back(arg);
+		}
+		else {
+			print_usage(argv[0]);
+			return 2;
+		}
+	}
+	if (filenames.size() != 2) {
+		print_usage(argv[0]);
+		return 2;
+	}
+
+	benchmark_result_file baseline, candidate;
+	for (auto [filename, file] : { std::pair{ &filenames[0], &baseline },
+		std::pair{ &filenames[1], &candidate } })
+	{
+		if (auto const error = read_result_file(*filename, *file); !error.empty()) {
+			std::cerr << error << "\n";
+			return 2;
+		}
+	}
+
+	print_file_info("Baseline", baseline);
+	print_file_info("Candidate", candidate);
+	if (baseline.float_name != candidate.float_name) {
+		std::cerr << "Warning: comparing results of different types.\n";
+	}
+	if (baseline.cpu != candidate.cpu) {
+		std::cerr << "Warning: comparing results from different CPUs.\n";
+	}
+
+	std::cout << "\n" << std::left << std::setw(40) << "name" << std::setw(18) << "bucket" <<
+		std::right << std::setw(10) << "old(ns)" << std::setw(10) << "new(ns)" <<
+		std::setw(10) << "delta" << std::setw(22) << "CI" << "\n";
+
+	std::size_t number_of_regressions = 0;
+	std::size_t number_of_improvements = 0;
+	std::size_t number_of_compared = 0;
+	std::size_t number_of_records_without_intervals = 0;
+	for (auto const& new_record : candidate.records) {
+		if (!names.empty() &&
+			std::find(names.begin(), names.end(), new_record.name) == names.end())
+		{
+			continue;
+		}
+		auto const old_record = std::find_if(baseline.records.begin(), baseline.records.end(),
+			[&new_record](benchmark_record const& r) {
+				return r.name == new_record.name && r.bucket == new_record.bucket;
+			});
+		if (old_record == baseline.records.end()) {
+			continue;
+		}
+		auto const o = summarize_repetitions(old_record->repetition_means);
+		auto const n = summarize_repetitions(new_record.repetition_means);
+		if (o.count == 0 || n.count == 0 || o.mean <= 0) {
+			continue;
+		}
+		++number_of_compared;
+
+		auto const delta = n.mean - o.mean;
+		std::cout << std::left << std::setw(40) << new_record.name <<
+			std::setw(18) << new_record.bucket << std::right << std::fixed <<
+			std::setprecision(2) << std::setw(10) << o.mean << std::setw(10) << n.mean <<
+			std::showpos << std::setprecision(1) << std::setw(9) << 100 * delta / o.mean << "%";
+
+		if (o.count < 2 || n.count < 2) {
+			++number_of_records_without_intervals;
+			std::cout << std::noshowpos << std::setw(22) << "n/a" << "\n";
+			continue;
+		}
+
+		auto const standard_error = std::sqrt(o.variance_of_mean + n.variance_of_mean);
+		auto const lower = (delta - z * standard_error) / o.mean;
+		auto const upper = (delta + z * standard_error) / o.mean;
+
+		char const* verdict = "";
+		if (lower > threshold) {
+			verdict = "  REGRESSION";
+			++number_of_regressions;
+		}
+		else if (upper < -threshold) {
+			verdict = "  improvement";
+			++number_of_improvements;
+		}
+
+		std::cout << "  [" << std::setw(6) << 100 * lower << "%, " << std::setw(6) <<
+			100 * upper << "%]" << std::noshowpos << verdict << "\n";
+	}
+
+	if (number_of_records_without_intervals != 0) {
+		std::cout << "\n" << number_of_records_without_intervals << " records have no confidence " <<
+			"interval; measure with --repetitions 2 or more to compare them.\n";
+	}
+	std::cout << "\n" << number_of_compared << " compared, " << number_of_regressions <<
+		" significant regressions, " << number_of_improvements << " significant improvements" <<
+		" (threshold " << std::setprecision(1) << 100 * threshold << "%).\n";
+	return number_of_regressions == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
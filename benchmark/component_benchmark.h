@@ -0,0 +1,333 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_GRISU_EXACT_BENCHMARK_COMPONENT_BENCHMARK
+#define JKJ_GRISU_EXACT_BENCHMARK_COMPONENT_BENCHMARK
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Microbenchmarks of the individual steps of grisu_exact_impl<Float>::compute
+// with nearest-to-even rounding and tie-to-even correct rounding search
+// The inputs of each step are captured by running the algorithm step by step over
+// the samples, so that each step sees the inputs it sees in full runs.
+// Each step is then called over its captured inputs in a loop, and the results are
+// folded into a sink so that the calls cannot be eliminated. The reported time per
+// call includes the loop overhead, which is reported separately as "(loop)".
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include "statistics.h"
+#include "tsc_clock.h"
+#include "../fp_to_chars.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+struct component_result {
+	std::string	name;
+	std::size_t	number_of_inputs;
+	double		nanoseconds_per_call;
+};
+
+namespace component_benchmark_detail {
+	template <class Float>
+	using extended_significand_type =
+		typename jkj::grisu_exact_detail::grisu_exact_impl<Float>::extended_significand_type;
+	template <class Float>
+	using cache_entry_type =
+		typename jkj::grisu_exact_detail::grisu_exact_impl<Float>::cache_entry_type;
+
+	constexpr auto to_nearest_tag = jkj::grisu_exact_rounding_modes::to_nearest_tag;
+
+	// Inputs computed in Step 1
+	template <class Float>
+	struct step_1_inputs {
+		extended_significand_type<Float>	significand;
+		extended_significand_type<Float>	fr;
+		cache_entry_type<Float>				cache;
+		int									exponent;
+		int									minus_k;
+		int									minus_beta;
+		bool								is_edge_case;
+		bool								is_closed;
+	};
+
+	// State at the beginning of the increasing search
+	template <class Float>
+	struct increasing_search_state {
+		step_1_inputs<Float>							step_1;
+		jkj::unsigned_fp_t<Float>						ret_value;
+		extended_significand_type<Float>				r;
+		std::uint32_t									deltai;
+		typename jkj::grisu_exact_detail::grisu_exact_impl<Float>::zf_vs_deltaf_t	zf_vs_deltaf;
+	};
+
+	// Same as Step 1 of grisu_exact_impl<Float>::compute for nearest rounding
+	template <class Float>
+	step_1_inputs<Float> compute_step_1_inputs(jkj::bit_representation_t<Float> br) {
+		using impl = jkj::grisu_exact_detail::grisu_exact_impl<Float>;
+		step_1_inputs<Float> ret;
+
+		ret.significand = br.f << impl::exponent_bits;
+		ret.exponent = int((br.f >> impl::precision) &
+			(impl::exponent_bits_mask >> impl::precision));
+		if (ret.exponent != 0) {
+			ret.significand |= impl::sign_bit_mask;
+			ret.exponent = ret.exponent + impl::exponent_bias - int(impl::extended_precision) + 1;
+		}
+		else {
+			ret.exponent = impl::min_exponent;
+		}
+		ret.fr = ret.significand | impl::boundary_bit;
+
+		ret.minus_k = jkj::grisu_exact_detail::floor_log10_pow2(ret.exponent + 1 - impl::alpha);
+		ret.minus_beta = -(ret.exponent +
+			jkj::grisu_exact_detail::floor_log2_pow10(-ret.minus_k) + 1);
+		ret.cache = jkj::grisu_exact_detail::get_cache<Float>(-ret.minus_k);
+		ret.is_edge_case = ret.significand == impl::sign_bit_mask &&
+			ret.exponent != impl::min_exponent;
+		ret.is_closed = br.f % 2 == 0;
+		return ret;
+	}
+
+	// Same as the increasing search of grisu_exact_impl<Float>::compute
+	template <class Float>
+	void increasing_search(increasing_search_state<Float>& s) {
+		using impl = jkj::grisu_exact_detail::grisu_exact_impl<Float>;
+		auto const& in = s.step_1;
+		jkj::grisu_exact_rounding_modes::interval_type::symmetric_boundary interval_type{
+			in.is_closed };
+		extended_significand_type<Float> divisor = impl::template power_of_10<impl::initial_kappa>;
+
+		auto search = [&](auto lambda, auto is_initial_search) {
+			impl::template increasing_search<decltype(lambda)::value, to_nearest_tag,
+				decltype(is_initial_search)::value>(s.ret_value, interval_type,
+				s.zf_vs_deltaf, in.exponent, in.minus_k, in.minus_beta, in.significand,
+				s.r, divisor, s.deltai, in.cache);
+		};
+		using lambda_type = extended_significand_type<Float>;
+		// The number of steps depends on the range of kappa
+		if constexpr (impl::max_kappa - impl::initial_kappa < 8) {
+			search(std::integral_constant<lambda_type, 4>{}, std::true_type{});
+		}
+		else {
+			static_assert(impl::max_kappa - impl::initial_kappa < 16);
+
+			search(std::integral_constant<lambda_type, 8>{}, std::true_type{});
+			search(std::integral_constant<lambda_type, 4>{}, std::false_type{});
+		}
+		search(std::integral_constant<lambda_type, 2>{}, std::false_type{});
+		search(std::integral_constant<lambda_type, 1>{}, std::false_type{});
+	}
+
+	// Arguments of an integer check, together with the case compute chooses for it
+	template <class Float>
+	struct integer_check_inputs {
+		using case_id = typename jkj::grisu_exact_detail::grisu_exact_impl<Float>::integer_check_case_id;
+
+		extended_significand_type<Float>	f;
+		int									exponent;
+		int									minus_k;
+		case_id								id;
+	};
+
+	template <class Float>
+	bool is_product_integer(integer_check_inputs<Float> const& in) {
+		using impl = jkj::grisu_exact_detail::grisu_exact_impl<Float>;
+		using case_id = typename integer_check_inputs<Float>::case_id;
+		switch (in.id) {
+		case case_id::fc_minus_2_to_the_q_mp_m3_edge:
+			return impl::template is_product_integer<case_id::fc_minus_2_to_the_q_mp_m3_edge>(
+				in.f, in.exponent, in.minus_k);
+		case case_id::fc_pm_2_to_the_q_mp_m2_generic:
+			return impl::template is_product_integer<case_id::fc_pm_2_to_the_q_mp_m2_generic>(
+				in.f, in.exponent, in.minus_k);
+		case case_id::fc_pm_2_to_the_q_mp_m2_edge:
+			return impl::template is_product_integer<case_id::fc_pm_2_to_the_q_mp_m2_edge>(
+				in.f, in.exponent, in.minus_k);
+		case case_id::two_times_fc:
+			return impl::template is_product_integer<case_id::two_times_fc>(
+				in.f, in.exponent, in.minus_k);
+		default:
+			return impl::template is_product_integer<case_id::other>(
+				in.f, in.exponent, in.minus_k);
+		}
+	}
+
+	template <class Float>
+	std::uint64_t fold(cache_entry_type<Float> const& cache) noexcept {
+		if constexpr (sizeof(Float) == 4) {
+			return cache;
+		}
+		else {
+			return cache.high() ^ cache.low();
+		}
+	}
+
+	// Written at the end of every timed loop, so that the calls cannot be eliminated
+	// nor moved out of the loop
+	inline volatile std::uint64_t sink;
+
+	// Median over repetitions of the average time of func(0), ... , func(n - 1)
+	template <class Func>
+	double measure(std::size_t n, std::size_t number_of_repetitions, Func&& func) {
+		std::uint64_t folded = 0;
+		for (std::size_t i = 0; i < n; ++i) {
+			folded += std::uint64_t(func(i));
+		}
+		sink = folded;
+
+		std::vector<double> times(number_of_repetitions);
+		for (auto& time : times) {
+			auto const from = tsc_clock::start();
+			for (std::size_t i = 0; i < n; ++i) {
+				folded += std::uint64_t(func(i));
+			}
+			sink = folded;
+			auto const to = tsc_clock::stop();
+			time = tsc_clock::to_nanoseconds(to - from) / double(n);
+		}
+		return median_of(times);
+	}
+}
+
+template <class Float>
+std::vector<component_result> run_component_benchmarks(std::vector<Float> const& samples,
+	std::size_t number_of_repetitions)
+{
+	using namespace component_benchmark_detail;
+	using impl = jkj::grisu_exact_detail::grisu_exact_impl<Float>;
+	using jkj::grisu_exact_rounding_modes::nearest_to_even;
+	using zf_vs_deltaf_t = typename impl::zf_vs_deltaf_t;
+	using case_id = typename impl::integer_check_case_id;
+	constexpr auto initial_power = impl::template power_of_10<impl::initial_kappa>;
+
+	// Capture the inputs of each step
+	std::vector<jkj::bit_representation_t<Float>> brs;
+	std::vector<step_1_inputs<Float>> step_1;
+	std::vector<extended_significand_type<Float>> zis;
+	std::vector<increasing_search_state<Float>> searches;
+	std::vector<integer_check_inputs<Float>> integer_checks;
+	std::vector<jkj::unsigned_fp_t<Float>> outputs;
+	for (auto const x : samples) {
+		auto const br = jkj::get_bit_representation(x);
+		if (!br.is_finite() || !br.is_nonzero()) {
+			continue;
+		}
+		auto const in = compute_step_1_inputs(br);
+		auto const zi = impl::compute_mul(in.fr, in.cache, in.minus_beta);
+		auto const deltai = impl::template compute_delta<to_nearest_tag>(
+			in.is_edge_case, in.cache, in.minus_beta);
+		brs.push_back(br);
+		step_1.push_back(in);
+		zis.push_back(zi);
+		outputs.push_back(jkj::grisu_exact<false>(x));
+
+		increasing_search_state<Float> s{ in,
+			{ zi / initial_power, impl::initial_kappa + in.minus_k },
+			zi % initial_power, deltai, zf_vs_deltaf_t::not_compared_yet };
+		if (s.r == deltai) {
+			jkj::grisu_exact_rounding_modes::interval_type::symmetric_boundary interval_type{
+				in.is_closed };
+			s.zf_vs_deltaf = impl::template is_zf_smaller_than_deltaf<to_nearest_tag>(
+				in.significand, in.minus_beta, in.cache, interval_type, in.exponent, in.minus_k) ?
+				zf_vs_deltaf_t::zf_smaller : zf_vs_deltaf_t::zf_larger;
+			// The left endpoint is checked when it is included and the comparison
+			// of the fractional parts is inconclusive; fl and the case are chosen
+			// as in equal_fractional_parts
+			auto const fl = in.is_edge_case ?
+				impl::sign_bit_mask - impl::edge_case_boundary_bit :
+				in.significand - impl::boundary_bit;
+			if (in.is_closed &&
+				!impl::is_zf_strictly_smaller_than_deltaf(fl, in.minus_beta, in.cache))
+			{
+				integer_checks.push_back({ fl, in.exponent, in.minus_k, in.is_edge_case ?
+					case_id::fc_minus_2_to_the_q_mp_m3_edge :
+					case_id::fc_pm_2_to_the_q_mp_m2_generic });
+			}
+		}
+		if (s.r < deltai || s.zf_vs_deltaf == zf_vs_deltaf_t::zf_smaller) {
+			searches.push_back(s);
+			increasing_search(s);
+			// The right endpoint is checked when it might have been chosen
+			if (!in.is_closed && s.r == 0) {
+				integer_checks.push_back({ in.fr, in.exponent, in.minus_k,
+					case_id::fc_pm_2_to_the_q_mp_m2_generic });
+			}
+		}
+	}
+
+	std::vector<component_result> ret;
+	auto add = [&](char const* name, std::size_t n, auto&& func) {
+		if (n != 0) {
+			ret.push_back({ name, n, measure(n, number_of_repetitions, func) });
+		}
+	};
+
+	add("(loop)", step_1.size(), [&](std::size_t i) {
+		return step_1[i].fr;
+	});
+	add("get_cache", step_1.size(), [&](std::size_t i) {
+		return fold<Float>(jkj::grisu_exact_detail::get_cache<Float>(-step_1[i].minus_k));
+	});
+	add("compute_mul", step_1.size(), [&](std::size_t i) {
+		return impl::compute_mul(step_1[i].fr, step_1[i].cache, step_1[i].minus_beta);
+	});
+	add("compute_delta", step_1.size(), [&](std::size_t i) {
+		return impl::template compute_delta<to_nearest_tag>(
+			step_1[i].is_edge_case, step_1[i].cache, step_1[i].minus_beta);
+	});
+	add("initial division", zis.size(), [&](std::size_t i) {
+		return zis[i] / initial_power + zis[i] % initial_power;
+	});
+	add("increasing_search", searches.size(), [&](std::size_t i) {
+		auto s = searches[i];
+		increasing_search(s);
+		return s.ret_value.significand + s.r;
+	});
+	add("is_product_integer", integer_checks.size(), [&](std::size_t i) {
+		return is_product_integer(integer_checks[i]);
+	});
+	add("compute (w/o correct rounding)", brs.size(), [&](std::size_t i) {
+		return impl::template compute<false, nearest_to_even,
+			jkj::grisu_exact_correct_rounding::do_not_care>(brs[i]).significand;
+	});
+	add("compute", brs.size(), [&](std::size_t i) {
+		return impl::template compute<false, nearest_to_even,
+			jkj::grisu_exact_correct_rounding::tie_to_even>(brs[i]).significand;
+	});
+	// The correct rounding search is not a separate function
+	if (brs.size() != 0) {
+		auto const& without = ret[ret.size() - 2];
+		auto const& with = ret[ret.size() - 1];
+		ret.push_back({ "correct rounding search (difference)", brs.size(),
+			with.nanoseconds_per_call - without.nanoseconds_per_call });
+	}
+	char buffer[40];
+	add("digit writing", outputs.size(), [&](std::size_t i) {
+		if constexpr (sizeof(Float) == 4) {
+			return jkj::fp_to_chars_detail::float_to_chars(outputs[i], buffer) - buffer;
+		}
+		else {
+			return jkj::fp_to_chars_detail::double_to_chars(outputs[i], buffer) - buffer;
+		}
+	});
+
+	return ret;
+}
+
+#endif
\ No newline at end of file
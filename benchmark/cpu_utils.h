@@ -0,0 +1,140 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_GRISU_EXACT_CPU_UTILS
+#define JKJ_GRISU_EXACT_CPU_UTILS
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Platform-dependent utilities for benchmarks
+// Everything here is implemented only for Linux, and is a no-op elsewhere
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+// Returns the CPU the calling thread is running on, or -1 if unknown
+inline int current_cpu() noexcept {
+#if defined(__linux__)
+	return sched_getcpu();
+#else
+	return -1;
+#endif
+}
+
+// Pin the calling thread to the given CPU; returns false on failure
+inline bool pin_current_thread_to_cpu(int cpu) noexcept {
+#if defined(__linux__)
+	if (cpu < 0 || cpu >= CPU_SETSIZE) {
+		return false;
+	}
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+	(void)cpu;
+	return false;
+#endif
+}
+
+// Allow the calling thread to run on any of the given CPUs; returns false on failure
+inline bool pin_current_thread_to_cpus(std::vector<int> const& cpus) noexcept {
+#if defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (auto const cpu : cpus) {
+		if (cpu < 0 || cpu >= CPU_SETSIZE) {
+			return false;
+		}
+		CPU_SET(cpu, &set);
+	}
+	return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+	(void)cpus;
+	return false;
+#endif
+}
+
+// Returns the cpufreq scaling governor of the given CPU (e.g., "performance"),
+// or an empty string if unknown
+inline std::string cpu_scaling_governor(int cpu) {
+	std::string governor;
+#if defined(__linux__)
+	std::ifstream in{ "/sys/devices/system/cpu/cpu" + std::to_string(cpu) +
+		"/cpufreq/scaling_governor" };
+	std::getline(in, governor);
+#else
+	(void)cpu;
+#endif
+	return governor;
+}
+
+// Returns the CPUs the calling thread may run on, ordered for placing threads
+// If smt_siblings_first is true, hardware threads sharing a core come next to each other;
+// otherwise, one hardware thread of each core comes first, then the second ones, etc.
+// Returns an empty vector if unknown
+inline std::vector<int> cpus_for_threads(bool smt_siblings_first) {
+	std::vector<int> ret;
+#if defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+		return ret;
+	}
+
+	// (package, core) -> CPUs
+	std::map<std::pair<int, int>, std::vector<int>> cores;
+	for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+		if (!CPU_ISSET(cpu, &set)) {
+			continue;
+		}
+		auto const topology = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+		int package_id = 0, core_id = cpu;
+		std::ifstream{ topology + "physical_package_id" } >> package_id;
+		std::ifstream{ topology + "core_id" } >> core_id;
+		cores[{ package_id, core_id }].push_back(cpu);
+	}
+
+	if (smt_siblings_first) {
+		for (auto const& core : cores) {
+			ret.insert(ret.end(), core.second.begin(), core.second.end());
+		}
+	}
+	else {
+		for (std::size_t sibling = 0; ret.size() < std::size_t(CPU_COUNT(&set)); ++sibling) {
+			for (auto const& core : cores) {
+				if (sibling < core.second.size()) {
+					ret.push_back(core.second[sibling]);
+				}
+			}
+		}
+	}
+#else
+	(void)smt_siblings_first;
+#endif
+	return ret;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,190 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_GRISU_EXACT_BENCHMARK_DATASETS
+#define JKJ_GRISU_EXACT_BENCHMARK_DATASETS
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Deterministic generators of datasets resembling real-world data
+// Every dataset is generated from a fixed seed, so results are comparable across runs
+// and machines (as long as the standard library implements the same distributions).
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace datasets_detail {
+	// significand / 10^exp, correctly rounded for double as both of the operands are exact
+	// For float, the result may be off by one ulp due to double rounding in rare cases,
+	// which does not matter for benchmarking
+	template <class Float>
+	Float decimal_to_float(std::int64_t significand, int exp) {
+		constexpr double powers_of_10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+		return Float(double(significand) / powers_of_10[exp]);
+	}
+
+	// GeoJSON-style coordinates (as in canada.json): longitude/latitude pairs
+	// in decimal degrees with 5 ~ 7 decimal places
+	template <class Float, class RandGen>
+	std::vector<Float> geo_coordinates(std::size_t n, RandGen& rg) {
+		std::uniform_real_distribution<double> longitude{ -141.0, -52.0 };
+		std::uniform_real_distribution<double> latitude{ 41.0, 83.0 };
+		std::uniform_int_distribution<int> decimal_places{ 5, 7 };
+		std::vector<Float> ret(n);
+		for (std::size_t i = 0; i < n; ++i) {
+			auto const places = decimal_places(rg);
+			auto const degrees = (i % 2 == 0) ? longitude(rg) : latitude(rg);
+			ret[i] = decimal_to_float<Float>(
+				std::int64_t(std::llround(degrees * std::pow(10.0, places))), places);
+		}
+		return ret;
+	}
+
+	// Prices with 2 decimal places, log-uniformly distributed between 0.01 and 100000
+	template <class Float, class RandGen>
+	std::vector<Float> prices(std::size_t n, RandGen& rg) {
+		std::uniform_real_distribution<double> log_cents{ 0.0, std::log(1e7) };
+		std::vector<Float> ret(n);
+		for (auto& value : ret) {
+			value = decimal_to_float<Float>(std::int64_t(std::exp(log_cents(rg))), 2);
+		}
+		return ret;
+	}
+
+	// Half of them are temperatures rounded to 0.1 degree,
+	// the other half are 12-bit ADC codes converted into voltages in Float arithmetic
+	template <class Float, class RandGen>
+	std::vector<Float> sensor_readings(std::size_t n, RandGen& rg) {
+		std::normal_distribution<double> temperature{ 20.0, 5.0 };
+		std::uniform_int_distribution<int> adc_code{ 0, 4095 };
+		Float const volts_per_code = Float(3.3) / Float(4096);
+		std::vector<Float> ret(n);
+		for (std::size_t i = 0; i < n; ++i) {
+			if (i % 2 == 0) {
+				ret[i] = decimal_to_float<Float>(std::llround(temperature(rg) * 10), 1);
+			}
+			else {
+				ret[i] = Float(adc_code(rg)) * volts_per_code;
+			}
+		}
+		return ret;
+	}
+
+	// Nonnegative integers, log-uniformly distributed below 10^7
+	template <class Float, class RandGen>
+	std::vector<Float> integer_counts(std::size_t n, RandGen& rg) {
+		std::uniform_real_distribution<double> log_count{ 0.0, std::log(1e7) };
+		std::vector<Float> ret(n);
+		for (auto& value : ret) {
+			value = Float(std::int64_t(std::exp(log_count(rg))) - 1);
+		}
+		return ret;
+	}
+
+	// Normally distributed values computed in float; widened if Float is double
+	template <class Float, class RandGen>
+	std::vector<Float> widened_floats(std::size_t n, RandGen& rg) {
+		std::normal_distribution<float> dist{ 0.0f, 100.0f };
+		std::vector<Float> ret(n);
+		for (auto& value : ret) {
+			value = Float(dist(rg));
+		}
+		return ret;
+	}
+
+	// Coordinates of vertices on spheres of various radii, computed in Float arithmetic
+	template <class Float, class RandGen>
+	std::vector<Float> mesh_vertices(std::size_t n, RandGen& rg) {
+		constexpr Float pi = Float(3.14159265358979323846);
+		std::uniform_int_distribution<int> subdivisions{ 8, 256 };
+		std::uniform_real_distribution<Float> radius{ Float(0.1), Float(100) };
+		std::vector<Float> ret;
+		ret.reserve(n);
+		while (ret.size() < n) {
+			auto const m = subdivisions(rg);
+			auto const r = radius(rg);
+			for (int i = 0; i < m && ret.size() < n; ++i) {
+				auto const theta = Float(2) * pi * Float(i) / Float(m);
+				auto const phi = pi * Float(rg() % std::uint64_t(m)) / Float(m);
+				Float const coordinates[] = {
+					r * std::cos(theta) * std::sin(phi),
+					r * std::sin(theta) * std::sin(phi),
+					r * std::cos(phi)
+				};
+				for (auto const coordinate : coordinates) {
+					if (ret.size() < n) {
+						ret.push_back(coordinate);
+					}
+				}
+			}
+		}
+		return ret;
+	}
+
+	// Edges of equal-width histogram bins, computed as min + i * width in Float arithmetic
+	template <class Float, class RandGen>
+	std::vector<Float> histogram_bins(std::size_t n, RandGen& rg) {
+		std::uniform_int_distribution<int> number_of_bins{ 10, 1000 };
+		std::uniform_int_distribution<int> range_exponent{ -3, 4 };
+		std::vector<Float> ret;
+		ret.reserve(n);
+		while (ret.size() < n) {
+			auto const bins = number_of_bins(rg);
+			auto const half_range = Float(std::pow(10.0, range_exponent(rg)));
+			auto const width = (half_range + half_range) / Float(bins);
+			for (int i = 0; i <= bins && ret.size() < n; ++i) {
+				ret.push_back(-half_range + Float(i) * width);
+			}
+		}
+		return ret;
+	}
+}
+
+// Returns (name, samples) pairs
+template <class Float>
+std::vector<std::pair<std::string, std::vector<Float>>> generate_datasets(std::size_t n) {
+	std::vector<std::pair<std::string, std::vector<Float>>> ret;
+	std::uint64_t seed = 0;
+	auto add = [&](char const* name, auto&& generator) {
+		std::mt19937_64 rg{ seed++ };
+		ret.emplace_back(name, generator(n, rg));
+	};
+
+	add("geo_coordinates", [](std::size_t n, auto& rg) {
+		return datasets_detail::geo_coordinates<Float>(n, rg); });
+	add("prices", [](std::size_t n, auto& rg) {
+		return datasets_detail::prices<Float>(n, rg); });
+	add("sensor_readings", [](std::size_t n, auto& rg) {
+		return datasets_detail::sensor_readings<Float>(n, rg); });
+	add("integer_counts", [](std::size_t n, auto& rg) {
+		return datasets_detail::integer_counts<Float>(n, rg); });
+	add("widened_floats", [](std::size_t n, auto& rg) {
+		return datasets_detail::widened_floats<Float>(n, rg); });
+	add("mesh_vertices", [](std::size_t n, auto& rg) {
+		return datasets_detail::mesh_vertices<Float>(n, rg); });
+	add("histogram_bins", [](std::size_t n, auto& rg) {
+		return datasets_detail::histogram_bins<Float>(n, rg); });
+
+	return ret;
+}
+
+#endif
\ No newline at end of file
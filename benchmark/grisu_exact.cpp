@@ -32,6 +32,6 @@ namespace {
 			jkj::grisu_exact_correct_rounding::tie_to_even{});
 	}
 	register_function_for_benchmark dummy("Grisu-Exact",
-		grisu_exact_float_to_chars,
-		grisu_exact_double_to_chars);
+		benchmark_function<grisu_exact_float_to_chars>{},
+		benchmark_function<grisu_exact_double_to_chars>{});
 }
\ No newline at end of file
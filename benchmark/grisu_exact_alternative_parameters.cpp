@@ -0,0 +1,39 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "benchmark.h"
+#include "../fp_to_chars.h"
+#include "../parameters/alternative_parameters.h"
+
+// Not registered by default; define GRISU_EXACT_BENCHMARK_ALTERNATIVE_PARAMETERS
+// (with CMake, configure with -DGRISU_EXACT_BENCHMARK_ALTERNATIVE_PARAMETERS=ON) to compare
+// the parameters in alternative_parameters.h with the default ones
+#if defined(GRISU_EXACT_BENCHMARK_ALTERNATIVE_PARAMETERS)
+namespace {
+	template <class Float>
+	void grisu_exact_alternative_parameters_to_chars(Float x, char* buffer)
+	{
+		jkj::fp_to_chars<Float,
+			jkj::grisu_exact_rounding_modes::nearest_to_even,
+			jkj::grisu_exact_correct_rounding::tie_to_even,
+			grisu_exact_alternative_parameters<Float>>(x, buffer);
+	}
+	register_function_for_benchmark dummy("Grisu-Exact (alternative parameters)",
+		benchmark_function<grisu_exact_alternative_parameters_to_chars<float>>{},
+		benchmark_function<grisu_exact_alternative_parameters_to_chars<double>>{});
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,39 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "benchmark.h"
+#include "../grisu_exact.h"
+#include <cstring>
+
+namespace {
+	// Store the result into the buffer so that the computation is not optimized away
+	// The significand returned by grisu_exact never has trailing zeros, so nothing is removed
+	// here; d2d_decompose removes them from small integers so that Ryu returns the same result
+	template <class Float>
+	void grisu_exact_decompose(Float x, char* buffer)
+	{
+		auto const br = jkj::get_bit_representation(x);
+		if (br.is_finite() && br.is_nonzero()) {
+			auto const v = jkj::grisu_exact<false>(x);
+			std::memcpy(buffer, &v.significand, sizeof(v.significand));
+			std::memcpy(buffer + sizeof(v.significand), &v.exponent, sizeof(v.exponent));
+		}
+	}
+	register_decomposition_for_benchmark dummy("Grisu-Exact",
+		benchmark_function<grisu_exact_decompose<float>>{},
+		benchmark_function<grisu_exact_decompose<double>>{});
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// Registers fp_to_chars with every combination of RoundingMode and CorrectRoundingSearch
+// for the policy matrix benchmark (--policies)
+
+#include "benchmark.h"
+#include "../common/policy_list.h"
+#include "../fp_to_chars.h"
+
+namespace {
+	template <class Float, class RoundingMode, class CorrectRoundingSearch>
+	void grisu_exact_to_chars(Float x, char* buffer)
+	{
+		jkj::fp_to_chars(x, buffer, RoundingMode{}, CorrectRoundingSearch{});
+	}
+
+	template <class Float, class RoundingMode, class... CorrectRoundingSearch>
+	void register_policies(type_list<CorrectRoundingSearch...>)
+	{
+		(benchmark_holder<Float>::get_instance().template register_policy<
+			grisu_exact_to_chars<Float, RoundingMode, CorrectRoundingSearch>>(
+				policy_name<RoundingMode>, policy_name<CorrectRoundingSearch>), ...);
+	}
+
+	template <class Float, class... RoundingMode>
+	void register_policies(type_list<RoundingMode...>)
+	{
+		(register_policies<Float, RoundingMode>(correct_rounding_searches{}), ...);
+	}
+
+	struct register_all_policies {
+		register_all_policies()
+		{
+			register_policies<float>(rounding_modes{});
+			register_policies<double>(rounding_modes{});
+		}
+	} dummy;
+}
\ No newline at end of file
@@ -32,6 +32,6 @@ namespace {
 			jkj::grisu_exact_correct_rounding::do_not_care{});
 	}
 	register_function_for_benchmark dummy("Grisu-Exact (w/o correct rounding)",
-		grisu_exact_wo_correct_rounding_float_to_chars,
-		grisu_exact_wo_correct_rounding_double_to_chars);
+		benchmark_function<grisu_exact_wo_correct_rounding_float_to_chars>{},
+		benchmark_function<grisu_exact_wo_correct_rounding_double_to_chars>{});
 }
\ No newline at end of file
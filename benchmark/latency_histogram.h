@@ -0,0 +1,125 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_GRISU_EXACT_BENCHMARK_LATENCY_HISTOGRAM
+#define JKJ_GRISU_EXACT_BENCHMARK_LATENCY_HISTOGRAM
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+// Log-linear histogram of nonnegative integers (e.g., TSC ticks)
+// Values below 2^sub_bucket_bits are counted exactly; above them, each power of 2
+// is divided into 2^sub_bucket_bits buckets of equal width, so the relative error
+// of a reported value is below 2^-sub_bucket_bits. The maximum is kept exactly.
+class latency_histogram {
+public:
+	using value_type = std::uint64_t;
+
+	static constexpr int sub_bucket_bits = 5;
+	static constexpr std::size_t sub_bucket_count = std::size_t(1) << sub_bucket_bits;
+	static constexpr std::size_t number_of_buckets =
+		sub_bucket_count * (64 - sub_bucket_bits + 1);
+
+	void record(value_type value) noexcept {
+		++counts_[index_of(value)];
+		++total_count_;
+		max_ = std::max(max_, value);
+	}
+
+	void merge(latency_histogram const& other) noexcept {
+		for (std::size_t i = 0; i < number_of_buckets; ++i) {
+			counts_[i] += other.counts_[i];
+		}
+		total_count_ += other.total_count_;
+		max_ = std::max(max_, other.max_);
+	}
+
+	std::uint64_t total_count() const noexcept {
+		return total_count_;
+	}
+
+	value_type max() const noexcept {
+		return max_;
+	}
+
+	std::uint64_t count(std::size_t bucket) const noexcept {
+		return counts_[bucket];
+	}
+
+	// The smallest value belonging to the bucket
+	static value_type lower_bound(std::size_t bucket) noexcept {
+		if (bucket < sub_bucket_count) {
+			return value_type(bucket);
+		}
+		auto const shift = int(bucket / sub_bucket_count) - 1;
+		return value_type(sub_bucket_count + bucket % sub_bucket_count) << shift;
+	}
+
+	// The largest value belonging to the bucket
+	static value_type upper_bound(std::size_t bucket) noexcept {
+		if (bucket < sub_bucket_count) {
+			return value_type(bucket);
+		}
+		auto const shift = int(bucket / sub_bucket_count) - 1;
+		return lower_bound(bucket) + ((value_type(1) << shift) - 1);
+	}
+
+	// The largest value of the bucket containing the given percentile (0 ~ 100),
+	// but not above the maximum; 0 if empty
+	value_type value_at_percentile(double percentile) const noexcept {
+		assert(percentile >= 0 && percentile <= 100);
+		if (total_count_ == 0) {
+			return 0;
+		}
+		// The rank of the value, counting from 1
+		auto rank = std::uint64_t(percentile / 100 * double(total_count_) + 0.5);
+		rank = std::clamp(rank, std::uint64_t(1), total_count_);
+
+		std::uint64_t cumulative_count = 0;
+		for (std::size_t i = 0; i < number_of_buckets; ++i) {
+			cumulative_count += counts_[i];
+			if (cumulative_count >= rank) {
+				return std::min(upper_bound(i), max_);
+			}
+		}
+		return max_;
+	}
+
+private:
+	std::array<std::uint64_t, number_of_buckets>	counts_{};
+	std::uint64_t									total_count_ = 0;
+	value_type										max_ = 0;
+
+	static std::size_t index_of(value_type value) noexcept {
+		if (value < sub_bucket_count) {
+			return std::size_t(value);
+		}
+		// Position of the leading 1, at least sub_bucket_bits
+		int leading_one_pos = sub_bucket_bits;
+		while ((value >> leading_one_pos) > 1) {
+			++leading_one_pos;
+		}
+		auto const shift = leading_one_pos - sub_bucket_bits;
+		return std::size_t(shift + 1) * sub_bucket_count +
+			std::size_t(value >> shift) % sub_bucket_count;
+	}
+};
+
+#endif
\ No newline at end of file
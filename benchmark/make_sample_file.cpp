@@ -0,0 +1,117 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// Generate the benchmark samples once from an explicit seed, and write them into
+// [directory]/samples_binary32.bin and [directory]/samples_binary64.bin (see common/sample_file.h)
+// The benchmark driver loads them with --samples-file.
+
+#include "../common/random_float.h"
+#include "../common/sample_file.h"
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+
+namespace {
+	void print_usage(char const* program_name)
+	{
+		std::cout << "Usage: " << program_name << " [options]\n"
+			"  --float                 write binary32 samples (default: binary32 and binary64)\n"
+			"  --double                write binary64 samples\n"
+			"  --seed S                seed of std::mt19937_64 (default: 0)\n"
+			"  --uniform-samples N     number of uniformly random samples (default: 1000000)\n"
+			"  --digits-samples N      number of samples per digits (default: 100000)\n"
+			"  --directory D           output directory (default: the current directory)\n";
+	}
+
+	template <class Float>
+	bool write_samples(std::string const& filename, std::uint64_t seed,
+		std::size_t number_of_uniform_samples, std::size_t number_of_digits_samples_per_digits)
+	{
+		std::mt19937_64 rg{ seed };
+		std::cout << "Generating " << filename << "...\n";
+		if (!write_sample_file<Float>(filename, seed, generate_benchmark_samples<Float>(
+			number_of_uniform_samples, number_of_digits_samples_per_digits, rg)))
+		{
+			std::cerr << "Failed to write " << filename << "\n";
+			return false;
+		}
+		return true;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bool write_float = false;
+	bool write_double = false;
+	std::uint64_t seed = 0;
+	std::size_t number_of_uniform_samples = 1000000;
+	std::size_t number_of_digits_samples_per_digits = 100000;
+	std::string directory = ".";
+
+	for (int i = 1; i < argc; ++i) {
+		std::string_view arg = argv[i];
+		if (arg == "--float") {
+			write_float = true;
+		}
+		else if (arg == "--double") {
+			write_double = true;
+		}
+		else if ((arg == "--seed" || arg == "--uniform-samples" || arg == "--digits-samples" ||
+			arg == "--directory") && i + 1 < argc)
+		{
+			char const* value = argv[++i];
+			if (arg == "--seed") {
+				seed = std::stoull(value);
+			}
+			else if (arg == "--uniform-samples") {
+				number_of_uniform_samples = std::size_t(std::stoull(value));
+			}
+			else if (arg == "--digits-samples") {
+				number_of_digits_samples_per_digits = std::size_t(std::stoull(value));
+			}
+			else {
+				directory = value;
+			}
+		}
+		else if (arg == "--help") {
+			print_usage(argv[0]);
+			return EXIT_SUCCESS;
+		}
+		else {
+			print_usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if (!write_float && !write_double) {
+		write_float = true;
+		write_double = true;
+	}
+
+	if (write_float && !write_samples<float>(directory + "/samples_binary32.bin", seed,
+		number_of_uniform_samples, number_of_digits_samples_per_digits))
+	{
+		return EXIT_FAILURE;
+	}
+	if (write_double && !write_samples<double>(directory + "/samples_binary64.bin", seed,
+		number_of_uniform_samples, number_of_digits_samples_per_digits))
+	{
+		return EXIT_FAILURE;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "benchmark.h"
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+namespace {
+	// Enough digits for round-trip, but not the shortest
+	// A stream is constructed for each call, as is typical in real code
+	template <class Float>
+	void ostringstream_to_chars(Float x, char* buffer)
+	{
+		std::ostringstream out;
+		out.precision(std::numeric_limits<Float>::max_digits10);
+		out << x;
+		auto const str = out.str();
+		std::memcpy(buffer, str.c_str(), str.size() + 1);
+	}
+	register_function_for_benchmark dummy("std::ostringstream",
+		benchmark_function<ostringstream_to_chars<float>>{},
+		benchmark_function<ostringstream_to_chars<double>>{});
+}
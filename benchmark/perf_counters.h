@@ -0,0 +1,171 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_GRISU_EXACT_PERF_COUNTERS
+#define JKJ_GRISU_EXACT_PERF_COUNTERS
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Hardware performance counters through Linux perf_event_open(2)
+// Counters that cannot be opened (no permission, no PMU in a VM, unknown CPU, etc.)
+// are reported as NaN; on other platforms, every counter is unavailable.
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <string>
+
+#if defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+class perf_counters {
+public:
+	static constexpr std::size_t number_of_events = 5;
+	static constexpr std::array<char const*, number_of_events> event_names = {
+		"cycles", "instructions", "branch_misses", "l1d_read_misses", "uops"
+	};
+	using values_type = std::array<double, number_of_events>;
+
+	perf_counters() {
+		fds_.fill(-1);
+#if defined(__linux__)
+		open_event(0, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+		open_event(1, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+		open_event(2, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+		open_event(3, PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+			(PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+		// There is no generic event for uops; use the raw event of known vendors
+		if (auto const vendor = cpu_vendor(); vendor == "GenuineIntel") {
+			// UOPS_ISSUED.ANY
+			open_event(4, PERF_TYPE_RAW, 0x010e);
+		}
+		else if (vendor == "AuthenticAMD") {
+			// Retired ops (Zen)
+			open_event(4, PERF_TYPE_RAW, 0x00c1);
+		}
+#endif
+	}
+
+	~perf_counters() {
+#if defined(__linux__)
+		for (auto fd : fds_) {
+			if (fd >= 0) {
+				close(fd);
+			}
+		}
+#endif
+	}
+
+	perf_counters(perf_counters const&) = delete;
+	perf_counters& operator=(perf_counters const&) = delete;
+
+	bool is_available(std::size_t idx) const noexcept {
+		return fds_[idx] >= 0;
+	}
+	bool is_any_available() const noexcept {
+		for (std::size_t idx = 0; idx < number_of_events; ++idx) {
+			if (is_available(idx)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void start() noexcept {
+#if defined(__linux__)
+		for (auto fd : fds_) {
+			if (fd >= 0) {
+				ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+				ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+			}
+		}
+#endif
+	}
+
+	void stop() noexcept {
+#if defined(__linux__)
+		for (auto fd : fds_) {
+			if (fd >= 0) {
+				ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+			}
+		}
+#endif
+	}
+
+	// Counts since the last start(), scaled up if the counters were multiplexed
+	values_type read() const noexcept {
+		values_type ret;
+		ret.fill(std::numeric_limits<double>::quiet_NaN());
+#if defined(__linux__)
+		for (std::size_t idx = 0; idx < number_of_events; ++idx) {
+			if (fds_[idx] < 0) {
+				continue;
+			}
+			// value, time_enabled, time_running
+			std::uint64_t data[3];
+			if (::read(fds_[idx], data, sizeof(data)) != sizeof(data) || data[2] == 0) {
+				continue;
+			}
+			ret[idx] = double(data[0]) * double(data[1]) / double(data[2]);
+		}
+#endif
+		return ret;
+	}
+
+private:
+	std::array<int, number_of_events>	fds_;
+
+#if defined(__linux__)
+	void open_event(std::size_t idx, std::uint32_t type, std::uint64_t config) noexcept {
+		perf_event_attr attr;
+		std::memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = type;
+		attr.config = config;
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		// Measure the calling thread on any CPU
+		fds_[idx] = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+	}
+
+	static std::string cpu_vendor() {
+		std::ifstream in{ "/proc/cpuinfo" };
+		std::string line;
+		while (std::getline(in, line)) {
+			if (line.compare(0, 9, "vendor_id") == 0) {
+				auto const pos = line.find(':');
+				if (pos != std::string::npos && pos + 2 <= line.size()) {
+					return line.substr(pos + 2);
+				}
+			}
+		}
+		return {};
+	}
+#endif
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,418 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_GRISU_EXACT_BENCHMARK_RESULT_STORE
+#define JKJ_GRISU_EXACT_BENCHMARK_RESULT_STORE
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Compact JSON files of summarized benchmark results, together with the information
+// about the build and the machine, to be compared by compare_results.cpp
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include "statistics.h"
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Defined by the build system
+#ifndef GRISU_EXACT_BENCHMARK_COMMIT
+#define GRISU_EXACT_BENCHMARK_COMMIT "unknown"
+#endif
+#ifndef GRISU_EXACT_BENCHMARK_FLAGS
+#define GRISU_EXACT_BENCHMARK_FLAGS "unknown"
+#endif
+
+struct benchmark_record {
+	// Name of the algorithm
+	std::string		name;
+	// "uniform", "digits_[n]", or the name of a dataset
+	std::string		bucket;
+	robust_summary	summary;
+	// Mean over the samples of each repetition, from which compare_results.cpp
+	// computes the confidence intervals
+	std::vector<double>	repetition_means;
+};
+
+struct benchmark_result_file {
+	std::string		float_name;
+	std::string		commit;
+	std::string		compiler;
+	std::string		flags;
+	std::string		cpu;
+	std::string		timestamp;
+	std::vector<benchmark_record>	records;
+};
+
+namespace result_store_detail {
+	inline std::string compiler_description() {
+#if defined(__clang__)
+		return "clang " __clang_version__;
+#elif defined(__GNUC__)
+		return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+		return "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+		return "unknown";
+#endif
+	}
+
+	inline std::string cpu_model_name() {
+		std::ifstream in{ "/proc/cpuinfo" };
+		std::string line;
+		while (std::getline(in, line)) {
+			if (line.compare(0, 10, "model name") == 0) {
+				auto const pos = line.find(':');
+				if (pos != std::string::npos && pos + 2 <= line.size()) {
+					return line.substr(pos + 2);
+				}
+			}
+		}
+		return "unknown";
+	}
+
+	inline std::string utc_timestamp() {
+		auto const t = std::time(nullptr);
+		char buffer[32];
+		std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&t));
+		return buffer;
+	}
+
+	// JSON has no representation of NaN's and infinities; they are written as null,
+	// which is read back as NaN
+	inline void write_number(std::ostream& out, double value) {
+		if (std::isfinite(value)) {
+			out << value;
+		}
+		else {
+			out << "null";
+		}
+	}
+
+	inline void write_string(std::ostream& out, std::string const& str) {
+		out << '"';
+		for (auto const c : str) {
+			if (c == '"' || c == '\\') {
+				out << '\\' << c;
+			}
+			else if ((unsigned char)c < 0x20) {
+				char buffer[8];
+				std::snprintf(buffer, sizeof(buffer), "\\u%04x", (unsigned int)c);
+				out << buffer;
+			}
+			else {
+				out << c;
+			}
+		}
+		out << '"';
+	}
+
+	// Minimal JSON reader; enough for the files written by write_result_file
+	struct json_value {
+		enum kind_t { null, boolean, number, string, array, object } kind = null;
+		double										number_value = 0;
+		std::string									string_value;
+		std::vector<json_value>						elements;
+		std::vector<std::pair<std::string, json_value>>	members;
+
+		json_value const* find(std::string const& key) const {
+			for (auto const& member : members) {
+				if (member.first == key) {
+					return &member.second;
+				}
+			}
+			return nullptr;
+		}
+	};
+
+	class json_parser {
+	public:
+		explicit json_parser(std::string const& text) : ptr_(text.c_str()) {}
+
+		bool parse(json_value& value) {
+			skip_whitespaces();
+			switch (*ptr_) {
+			case '{':
+				return parse_object(value);
+
+			case '[':
+				return parse_array(value);
+
+			case '"':
+				value.kind = json_value::string;
+				return parse_string(value.string_value);
+
+			case 't':
+			case 'f':
+			case 'n':
+				return parse_literal(value);
+
+			default:
+				return parse_number(value);
+			}
+		}
+
+	private:
+		char const* ptr_;
+
+		void skip_whitespaces() {
+			while (std::isspace((unsigned char)*ptr_)) {
+				++ptr_;
+			}
+		}
+
+		bool consume(char c) {
+			skip_whitespaces();
+			if (*ptr_ != c) {
+				return false;
+			}
+			++ptr_;
+			return true;
+		}
+
+		bool parse_object(json_value& value) {
+			value.kind = json_value::object;
+			++ptr_;
+			if (consume('}')) {
+				return true;
+			}
+			do {
+				std::pair<std::string, json_value> member;
+				skip_whitespaces();
+				if (*ptr_ != '"' || !parse_string(member.first) || !consume(':') ||
+					!parse(member.second))
+				{
+					return false;
+				}
+				value.members.push_back(std::move(member));
+			} while (consume(','));
+			return consume('}');
+		}
+
+		bool parse_array(json_value& value) {
+			value.kind = json_value::array;
+			++ptr_;
+			if (consume(']')) {
+				return true;
+			}
+			do {
+				value.elements.emplace_back();
+				if (!parse(value.elements.back())) {
+					return false;
+				}
+			} while (consume(','));
+			return consume(']');
+		}
+
+		// Only \uXXXX escapes below 0x80 are supported
+		bool parse_string(std::string& str) {
+			++ptr_;
+			for (; *ptr_ != '"'; ++ptr_) {
+				if (*ptr_ == '\0') {
+					return false;
+				}
+				if (*ptr_ != '\\') {
+					str += *ptr_;
+					continue;
+				}
+				++ptr_;
+				switch (*ptr_) {
+				case 'n': str += '\n'; break;
+				case 't': str += '\t'; break;
+				case 'r': str += '\r'; break;
+				case 'u':
+					if (std::isxdigit((unsigned char)ptr_[1]) && std::isxdigit((unsigned char)ptr_[2]) &&
+						std::isxdigit((unsigned char)ptr_[3]) && std::isxdigit((unsigned char)ptr_[4]))
+					{
+						str += char(std::strtol(std::string(ptr_ + 1, 4).c_str(), nullptr, 16));
+						ptr_ += 4;
+						break;
+					}
+					return false;
+				case '\0': return false;
+				default: str += *ptr_;
+				}
+			}
+			++ptr_;
+			return true;
+		}
+
+		bool parse_literal(json_value& value) {
+			for (auto const literal : { "true", "false", "null" }) {
+				auto const length = std::char_traits<char>::length(literal);
+				if (std::char_traits<char>::compare(ptr_, literal, length) == 0) {
+					value.kind = literal[0] == 'n' ? json_value::null : json_value::boolean;
+					value.number_value = literal[0] == 't' ? 1 : 0;
+					ptr_ += length;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool parse_number(json_value& value) {
+			char* end;
+			value.kind = json_value::number;
+			value.number_value = std::strtod(ptr_, &end);
+			if (end == ptr_) {
+				return false;
+			}
+			ptr_ = end;
+			return true;
+		}
+	};
+}
+
+// Fills in the information about the build and the machine
+inline benchmark_result_file make_result_file(std::string float_name) {
+	benchmark_result_file ret;
+	ret.float_name = std::move(float_name);
+	ret.commit = GRISU_EXACT_BENCHMARK_COMMIT;
+	ret.compiler = result_store_detail::compiler_description();
+	ret.flags = GRISU_EXACT_BENCHMARK_FLAGS;
+	ret.cpu = result_store_detail::cpu_model_name();
+	ret.timestamp = result_store_detail::utc_timestamp();
+	return ret;
+}
+
+inline bool write_result_file(std::string const& filename, benchmark_result_file const& file) {
+	using result_store_detail::write_number;
+	using result_store_detail::write_string;
+	std::ofstream out{ filename };
+	out.precision(17);
+
+	out << "{\n\"format\":\"grisu-exact-benchmark\",\"version\":2,\n\"float\":";
+	write_string(out, file.float_name);
+	out << ",\n\"commit\":";
+	write_string(out, file.commit);
+	out << ",\n\"compiler\":";
+	write_string(out, file.compiler);
+	out << ",\n\"flags\":";
+	write_string(out, file.flags);
+	out << ",\n\"cpu\":";
+	write_string(out, file.cpu);
+	out << ",\n\"timestamp\":";
+	write_string(out, file.timestamp);
+	out << ",\n\"records\":[";
+
+	bool first = true;
+	for (auto const& record : file.records) {
+		out << (first ? "\n" : ",\n") << "{\"name\":";
+		first = false;
+		write_string(out, record.name);
+		out << ",\"bucket\":";
+		write_string(out, record.bucket);
+		auto const& s = record.summary;
+		out << ",\"count\":" << s.count << ",\"outliers\":" << s.number_of_outliers;
+		for (auto const& [key, value] : { std::pair{ "median", s.median },
+			std::pair{ "mad", s.mad }, std::pair{ "mean", s.mean },
+			std::pair{ "stddev", s.stddev }, std::pair{ "min", s.min }, std::pair{ "max", s.max } })
+		{
+			out << ",\"" << key << "\":";
+			write_number(out, value);
+		}
+		out << ",\"repetition_means\":[";
+		for (std::size_t i = 0; i < record.repetition_means.size(); ++i) {
+			if (i != 0) {
+				out << ",";
+			}
+			write_number(out, record.repetition_means[i]);
+		}
+		out << "]}";
+	}
+	out << "\n]\n}\n";
+	return bool(out);
+}
+
+// Returns an empty string on success, or an error message
+inline std::string read_result_file(std::string const& filename, benchmark_result_file& file) {
+	using result_store_detail::json_value;
+
+	std::ifstream in{ filename };
+	if (!in) {
+		return "cannot open " + filename;
+	}
+	std::string const text{ std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+
+	json_value root;
+	if (!result_store_detail::json_parser{ text }.parse(root) || root.kind != json_value::object) {
+		return "malformed JSON in " + filename;
+	}
+	auto const format = root.find("format");
+	if (!format || format->string_value != "grisu-exact-benchmark") {
+		return filename + " is not a benchmark result file";
+	}
+
+	auto get_string = [&root](char const* key) {
+		auto const value = root.find(key);
+		return value ? value->string_value : std::string{};
+	};
+	file.float_name = get_string("float");
+	file.commit = get_string("commit");
+	file.compiler = get_string("compiler");
+	file.flags = get_string("flags");
+	file.cpu = get_string("cpu");
+	file.timestamp = get_string("timestamp");
+
+	auto const records = root.find("records");
+	if (!records || records->kind != json_value::array) {
+		return "no records in " + filename;
+	}
+	file.records.clear();
+	for (auto const& element : records->elements) {
+		auto get_number = [&element](char const* key) {
+			auto const value = element.find(key);
+			if (!value) {
+				return 0.0;
+			}
+			return value->kind == json_value::null ?
+				std::numeric_limits<double>::quiet_NaN() : value->number_value;
+		};
+		benchmark_record record;
+		if (auto const name = element.find("name")) {
+			record.name = name->string_value;
+		}
+		if (auto const bucket = element.find("bucket")) {
+			record.bucket = bucket->string_value;
+		}
+		record.summary.count = std::size_t(get_number("count"));
+		record.summary.number_of_outliers = std::size_t(get_number("outliers"));
+		record.summary.median = get_number("median");
+		record.summary.mad = get_number("mad");
+		record.summary.mean = get_number("mean");
+		record.summary.stddev = get_number("stddev");
+		record.summary.min = get_number("min");
+		record.summary.max = get_number("max");
+		if (auto const means = element.find("repetition_means")) {
+			for (auto const& mean : means->elements) {
+				record.repetition_means.push_back(mean.kind == json_value::null ?
+					std::numeric_limits<double>::quiet_NaN() : mean.number_value);
+			}
+		}
+		file.records.push_back(std::move(record));
+	}
+	return {};
+}
+
+#endif
\ No newline at end of file
@@ -20,5 +20,5 @@
 
 namespace {
 	register_function_for_benchmark dummy("Ryu",
-		f2s_buffered, d2s_buffered);
+		benchmark_function<f2s_buffered>{}, benchmark_function<d2s_buffered>{});
 }
\ No newline at end of file
@@ -507,3 +507,39 @@ char* d2s(double f) {
   d2s_buffered(f, result);
   return result;
 }
+
+// Not in the original Ryu: the decimal significand and exponent computed by d2s_buffered_n,
+// without the conversion into a string, for benchmarking the decomposition alone.
+// Returns 0 without computing anything for NaN's, infinities, and zeros.
+int d2d_decompose(double f, uint64_t* mantissa, int32_t* exponent) {
+  const uint64_t bits = double_to_bits(f);
+  const uint64_t ieeeMantissa = bits & ((1ull << DOUBLE_MANTISSA_BITS) - 1);
+  const uint32_t ieeeExponent = (uint32_t) ((bits >> DOUBLE_MANTISSA_BITS) & ((1u << DOUBLE_EXPONENT_BITS) - 1));
+  if (ieeeExponent == ((1u << DOUBLE_EXPONENT_BITS) - 1u) || (ieeeExponent == 0 && ieeeMantissa == 0)) {
+    return 0;
+  }
+
+  floating_decimal_64 v;
+  const bool isSmallInt = d2d_small_int(ieeeMantissa, ieeeExponent, &v);
+  if (isSmallInt) {
+    // The trailing zeros of small integers are removed, as d2s_buffered_n does before printing.
+    // This is kept, rather than removed, so that the result is the shortest representation,
+    // which is what grisu_exact returns (it never has trailing zeros); the Ryu and Grisu-Exact
+    // decomposition rows then compute the same significand and exponent for every input.
+    for (;;) {
+      const uint64_t q = div10(v.mantissa);
+      const uint32_t r = ((uint32_t) v.mantissa) - 10 * ((uint32_t) q);
+      if (r != 0) {
+        break;
+      }
+      v.mantissa = q;
+      ++v.exponent;
+    }
+  } else {
+    v = d2d(ieeeMantissa, ieeeExponent);
+  }
+
+  *mantissa = v.mantissa;
+  *exponent = v.exponent;
+  return 1;
+}
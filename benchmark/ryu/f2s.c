@@ -343,3 +343,20 @@ char* f2s(float f) {
   f2s_buffered(f, result);
   return result;
 }
+
+// Not in the original Ryu: the decimal significand and exponent computed by f2s_buffered_n,
+// without the conversion into a string, for benchmarking the decomposition alone.
+// Returns 0 without computing anything for NaN's, infinities, and zeros.
+int f2d_decompose(float f, uint32_t* mantissa, int32_t* exponent) {
+  const uint32_t bits = float_to_bits(f);
+  const uint32_t ieeeMantissa = bits & ((1u << FLOAT_MANTISSA_BITS) - 1);
+  const uint32_t ieeeExponent = (bits >> FLOAT_MANTISSA_BITS) & ((1u << FLOAT_EXPONENT_BITS) - 1);
+  if (ieeeExponent == ((1u << FLOAT_EXPONENT_BITS) - 1u) || (ieeeExponent == 0 && ieeeMantissa == 0)) {
+    return 0;
+  }
+
+  const floating_decimal_32 v = f2d(ieeeMantissa, ieeeExponent);
+  *mantissa = v.mantissa;
+  *exponent = v.exponent;
+  return 1;
+}
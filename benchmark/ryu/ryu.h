@@ -39,6 +39,10 @@ int d2exp_buffered_n(double d, uint32_t precision, char* result);
 void d2exp_buffered(double d, uint32_t precision, char* result);
 char* d2exp(double d, uint32_t precision);
 
+// Not in the original Ryu; see d2s.c and f2s.c
+int d2d_decompose(double f, uint64_t* mantissa, int32_t* exponent);
+int f2d_decompose(float f, uint32_t* mantissa, int32_t* exponent);
+
 #ifdef __cplusplus
 }
 #endif
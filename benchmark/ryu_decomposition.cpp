@@ -0,0 +1,45 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "benchmark.h"
+#include "ryu/ryu.h"
+#include <cstdint>
+#include <cstring>
+
+namespace {
+	// Store the result into the buffer so that the computation is not optimized away
+	void ryu_float_decompose(float x, char* buffer)
+	{
+		std::uint32_t mantissa;
+		std::int32_t exponent;
+		if (f2d_decompose(x, &mantissa, &exponent)) {
+			std::memcpy(buffer, &mantissa, sizeof(mantissa));
+			std::memcpy(buffer + sizeof(mantissa), &exponent, sizeof(exponent));
+		}
+	}
+	void ryu_double_decompose(double x, char* buffer)
+	{
+		std::uint64_t mantissa;
+		std::int32_t exponent;
+		if (d2d_decompose(x, &mantissa, &exponent)) {
+			std::memcpy(buffer, &mantissa, sizeof(mantissa));
+			std::memcpy(buffer + sizeof(mantissa), &exponent, sizeof(exponent));
+		}
+	}
+	register_decomposition_for_benchmark dummy("Ryu",
+		benchmark_function<ryu_float_decompose>{}, benchmark_function<ryu_double_decompose>{});
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "benchmark.h"
+#include <cstdio>
+
+namespace {
+	// Enough digits for round-trip, but not the shortest
+	void snprintf_float_to_chars(float x, char* buffer)
+	{
+		std::snprintf(buffer, 40, "%.9g", x);
+	}
+	void snprintf_double_to_chars(double x, char* buffer)
+	{
+		std::snprintf(buffer, 40, "%.17g", x);
+	}
+	register_function_for_benchmark dummy("snprintf",
+		benchmark_function<snprintf_float_to_chars>{},
+		benchmark_function<snprintf_double_to_chars>{});
+}
@@ -0,0 +1,97 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_GRISU_EXACT_BENCHMARK_STATISTICS
+#define JKJ_GRISU_EXACT_BENCHMARK_STATISTICS
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Destroys the order of the input
+inline double median_of(std::vector<double>& v) {
+	assert(!v.empty());
+	auto const mid = v.begin() + v.size() / 2;
+	std::nth_element(v.begin(), mid, v.end());
+	if (v.size() % 2 == 1) {
+		return *mid;
+	}
+	return (*std::max_element(v.begin(), mid) + *mid) / 2;
+}
+
+struct robust_summary {
+	std::size_t	count = 0;
+	std::size_t	number_of_outliers = 0;
+	double		median = 0;
+	// Median absolute deviation
+	double		mad = 0;
+	// Mean, standard deviation, min and max after rejecting outliers
+	double		mean = 0;
+	double		stddev = 0;
+	double		min = 0;
+	double		max = 0;
+};
+
+// Values farther than outlier_threshold * 1.4826 * MAD from the median are
+// considered as outliers; 1.4826 * MAD estimates the standard deviation for normal data
+inline robust_summary summarize(std::vector<double> values, double outlier_threshold = 3.5) {
+	robust_summary ret;
+	ret.count = values.size();
+	if (values.empty()) {
+		return ret;
+	}
+
+	ret.median = median_of(values);
+
+	std::vector<double> deviations(values.size());
+	for (std::size_t i = 0; i < values.size(); ++i) {
+		deviations[i] = std::abs(values[i] - ret.median);
+	}
+	ret.mad = median_of(deviations);
+
+	auto const bound = outlier_threshold * 1.4826 * ret.mad;
+	double sum = 0;
+	std::size_t kept = 0;
+	ret.min = ret.median;
+	ret.max = ret.median;
+	for (auto const v : values) {
+		if (std::abs(v - ret.median) > bound) {
+			++ret.number_of_outliers;
+			continue;
+		}
+		sum += v;
+		++kept;
+		ret.min = std::min(ret.min, v);
+		ret.max = std::max(ret.max, v);
+	}
+	ret.mean = sum / double(kept);
+
+	if (kept >= 2) {
+		double squared_sum = 0;
+		for (auto const v : values) {
+			if (std::abs(v - ret.median) <= bound) {
+				squared_sum += (v - ret.mean) * (v - ret.mean);
+			}
+		}
+		ret.stddev = std::sqrt(squared_sum / double(kept - 1));
+	}
+	return ret;
+}
+
+#endif
\ No newline at end of file
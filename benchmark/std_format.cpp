@@ -0,0 +1,75 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// {fmt} should be included before fp_formatter.h
+#if defined(GRISU_EXACT_HAS_FMT)
+#include <fmt/format.h>
+#endif
+#include "benchmark.h"
+#include "../fp_formatter.h"
+
+// Compare the default std::format("{}", x) against std::formatter<jkj::fp_format_t<...>>
+// CMake builds this file as C++20 if the compiler supports it; if <format> is still not
+// available, only the {fmt} comparison below is registered
+#if defined(__cpp_lib_format)
+namespace {
+	template <class Float>
+	void std_format_to_chars(Float x, char* buffer)
+	{
+		*std::format_to(buffer, "{}", x) = '\0';
+	}
+	register_function_for_benchmark dummy1("std::format",
+		benchmark_function<std_format_to_chars<float>>{},
+		benchmark_function<std_format_to_chars<double>>{});
+
+	template <class Float>
+	void grisu_exact_std_format_to_chars(Float x, char* buffer)
+	{
+		*std::format_to(buffer, "{}", jkj::fp_format(x,
+			jkj::grisu_exact_rounding_modes::nearest_to_even{},
+			jkj::grisu_exact_correct_rounding::tie_to_even{})) = '\0';
+	}
+	register_function_for_benchmark dummy2("Grisu-Exact (std::format)",
+		benchmark_function<grisu_exact_std_format_to_chars<float>>{},
+		benchmark_function<grisu_exact_std_format_to_chars<double>>{});
+}
+#endif
+
+// The same comparison with {fmt}, if CMake found it
+#if defined(FMT_VERSION)
+namespace {
+	template <class Float>
+	void fmt_format_to_chars(Float x, char* buffer)
+	{
+		*fmt::format_to(buffer, "{}", x) = '\0';
+	}
+	register_function_for_benchmark dummy3("fmt::format",
+		benchmark_function<fmt_format_to_chars<float>>{},
+		benchmark_function<fmt_format_to_chars<double>>{});
+
+	template <class Float>
+	void grisu_exact_fmt_format_to_chars(Float x, char* buffer)
+	{
+		*fmt::format_to(buffer, "{}", jkj::fp_format(x,
+			jkj::grisu_exact_rounding_modes::nearest_to_even{},
+			jkj::grisu_exact_correct_rounding::tie_to_even{})) = '\0';
+	}
+	register_function_for_benchmark dummy4("Grisu-Exact (fmt::format)",
+		benchmark_function<grisu_exact_fmt_format_to_chars<float>>{},
+		benchmark_function<grisu_exact_fmt_format_to_chars<double>>{});
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,33 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#include "benchmark.h"
+#include <charconv>
+
+// Floating-point std::to_chars is not available in every standard library
+#if defined(__cpp_lib_to_chars)
+namespace {
+	template <class Float>
+	void std_to_chars(Float x, char* buffer)
+	{
+		*std::to_chars(buffer, buffer + 39, x).ptr = '\0';
+	}
+	register_function_for_benchmark dummy("std::to_chars",
+		benchmark_function<std_to_chars<float>>{},
+		benchmark_function<std_to_chars<double>>{});
+}
+#endif
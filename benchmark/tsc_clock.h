@@ -0,0 +1,125 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_GRISU_EXACT_TSC_CLOCK
+#define JKJ_GRISU_EXACT_TSC_CLOCK
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define JKJ_HAS_TSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define JKJ_HAS_TSC 1
+#else
+#define JKJ_HAS_TSC 0
+#endif
+
+// Time-stamp counter based clock
+// On x86, start() and stop() read the TSC with fences so that the measured code
+// cannot be reordered across them. Elsewhere, std::chrono::steady_clock is used
+// and one tick is one nanosecond.
+class tsc_clock {
+public:
+	using rep = std::uint64_t;
+
+	static constexpr bool is_tsc = JKJ_HAS_TSC != 0;
+
+	// Read the counter after every preceding instruction is completed,
+	// and before any following instruction begins
+	static rep start() noexcept {
+#if JKJ_HAS_TSC
+		_mm_lfence();
+		auto const t = __rdtsc();
+		_mm_lfence();
+		return t;
+#else
+		return steady_now();
+#endif
+	}
+
+	// Read the counter after every preceding instruction is completed
+	static rep stop() noexcept {
+#if JKJ_HAS_TSC
+		unsigned int aux;
+		auto const t = __rdtscp(&aux);
+		_mm_lfence();
+		return t;
+#else
+		return steady_now();
+#endif
+	}
+
+	// Calibrated once against std::chrono::steady_clock
+	static double ticks_per_nanosecond() {
+		static double const value = calibrate();
+		return value;
+	}
+
+	static double to_nanoseconds(rep ticks) {
+		return double(ticks) / ticks_per_nanosecond();
+	}
+
+	// The cost of a start()/stop() pair without anything in between, in ticks
+	static rep overhead() {
+		static rep const value = [] {
+			rep best = ~rep(0);
+			for (int i = 0; i < 1000; ++i) {
+				auto const from = start();
+				auto const to = stop();
+				best = std::min(best, rep(to - from));
+			}
+			return best;
+		}();
+		return value;
+	}
+
+private:
+	static rep steady_now() noexcept {
+		return rep(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	static double calibrate() {
+#if JKJ_HAS_TSC
+		// Take the median of a few 20ms measurements
+		double results[5];
+		for (auto& result : results) {
+			auto const from_time = std::chrono::steady_clock::now();
+			auto const from_ticks = start();
+			std::chrono::steady_clock::time_point to_time;
+			do {
+				to_time = std::chrono::steady_clock::now();
+			} while (to_time - from_time < std::chrono::milliseconds(20));
+			auto const to_ticks = stop();
+
+			result = double(to_ticks - from_ticks) / double(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(to_time - from_time).count());
+		}
+		std::sort(std::begin(results), std::end(results));
+		return results[2];
+#else
+		return 1.0;
+#endif
+	}
+};
+
+#undef JKJ_HAS_TSC
+#endif
\ No newline at end of file
@@ -0,0 +1,1007 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_GRISU_EXACT_BIGINT
+#define JKJ_GRISU_EXACT_BIGINT
+
+////////////////////////////////////////////////////////////////////////////////////////
+// This file is only used for cache generation, and need not be included for real use
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../grisu_exact.h"
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace jkj {
+	namespace grisu_exact_detail {
+		constexpr std::size_t log2p1(std::uint64_t x) noexcept {
+			// C++20 std::log2p1 is not yet supported
+			//return std::log2p1(x);
+
+			std::size_t ret = 0;
+			auto inspect = [&x, &ret](int shft) {
+				if ((x >> shft) != 0) {
+					x >>= shft;
+					ret += shft;
+				}
+			};
+
+			inspect(32);
+			inspect(16);
+			inspect(8);
+			inspect(4);
+			inspect(2);
+			inspect(1);
+
+			return ret + x;
+		}
+
+		struct bigint_base {
+			using element_type = std::uint64_t;
+			static constexpr std::size_t element_number_of_bits =
+				sizeof(element_type) * std::numeric_limits<unsigned char>::digits;
+
+			struct leading_one_pos_t {
+				std::size_t		element_pos;
+				std::size_t		bit_pos;		// 1 ~ element_number_of_bits
+			};
+
+			// Operands with fewer elements than this are multiplied by the schoolbook method
+			static constexpr std::size_t karatsuba_threshold = 32;
+
+		protected:
+			// Divide (high * 2^64 + low) by divisor
+			// Precondition: high < divisor
+			static element_type divide_elements(element_type high, element_type low,
+				element_type divisor, element_type& remainder) noexcept
+			{
+				assert(high < divisor);
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+				// unsigned __int128 division calls a library function even though high < divisor
+				element_type quotient;
+				__asm__("divq %[divisor]" : "=a"(quotient), "=d"(remainder) :
+					[divisor] "rm"(divisor), "a"(low), "d"(high));
+				return quotient;
+#elif defined(_MSC_VER) && _MSC_VER >= 1923 && defined(_M_X64)
+				return _udiv128(high, low, divisor, &remainder);
+#else
+				// Knuth's Algorithm D with 32-bit digits (see Hacker's Delight, divlu)
+				constexpr element_type b = element_type(1) << 32;
+				constexpr element_type mask = b - 1;
+
+				auto const shft = element_number_of_bits - log2p1(divisor);
+				divisor <<= shft;
+				auto const divisor_high = divisor >> 32;
+				auto const divisor_low = divisor & mask;
+
+				auto const dividend_high = shft == 0 ? high :
+					((high << shft) | (low >> (element_number_of_bits - shft)));
+				auto const dividend_low = low << shft;
+
+				auto estimate = [&](element_type numerator, element_type next_digit) {
+					auto q = numerator / divisor_high;
+					auto r = numerator - q * divisor_high;
+					while (q >= b || q * divisor_low > b * r + next_digit) {
+						--q;
+						r += divisor_high;
+						if (r >= b)
+							break;
+					}
+					return q;
+				};
+
+				auto const q1 = estimate(dividend_high, dividend_low >> 32);
+				auto const middle = dividend_high * b + (dividend_low >> 32) - q1 * divisor;
+				auto const q0 = estimate(middle, dividend_low & mask);
+
+				remainder = (middle * b + (dividend_low & mask) - q0 * divisor) >> shft;
+				return q1 * b + q0;
+#endif
+			}
+
+			// x[0, x_size) += y[0, y_size); returns the carry
+			// Precondition: y_size <= x_size
+			static element_type add_elements(element_type* x, std::size_t x_size,
+				element_type const* y, std::size_t y_size) noexcept
+			{
+				assert(y_size <= x_size);
+				element_type carry = 0;
+				std::size_t idx = 0;
+				for (; idx < y_size; ++idx) {
+					auto with_carry = x[idx] + carry;
+					element_type first_carry = with_carry < carry ? 1 : 0;
+
+					x[idx] = with_carry + y[idx];
+					carry = first_carry | (x[idx] < y[idx] ? 1 : 0);
+				}
+				for (; carry != 0 && idx < x_size; ++idx) {
+					carry = ++x[idx] == 0 ? 1 : 0;
+				}
+				return carry;
+			}
+
+			// x[0, x_size) -= y[0, y_size); returns the borrow
+			// Precondition: y_size <= x_size
+			static element_type subtract_elements(element_type* x, std::size_t x_size,
+				element_type const* y, std::size_t y_size) noexcept
+			{
+				assert(y_size <= x_size);
+				element_type borrow = 0;
+				std::size_t idx = 0;
+				for (; idx < y_size; ++idx) {
+					auto with_borrow = y[idx] + borrow;
+					element_type first_borrow = with_borrow < borrow ? 1 : 0;
+
+					borrow = first_borrow | (x[idx] < with_borrow ? 1 : 0);
+					x[idx] -= with_borrow;
+				}
+				for (; borrow != 0 && idx < x_size; ++idx) {
+					borrow = x[idx]-- == 0 ? 1 : 0;
+				}
+				return borrow;
+			}
+
+			// result[0, x_size + y_size) = x[0, x_size) * y[0, y_size)
+			// result should not overlap with x or y
+			static void schoolbook_multiply(element_type* result,
+				element_type const* x, std::size_t x_size,
+				element_type const* y, std::size_t y_size) noexcept
+			{
+				// The first row is written directly, and each of the others is accumulated
+				// one element above the previous one
+				element_type first_carry = 0;
+				for (std::size_t i = 0; i < x_size; ++i) {
+					auto mul = umul128(x[i], y[0]);
+					result[i] = mul.low() + first_carry;
+					first_carry = mul.high() + (result[i] < mul.low() ? 1 : 0);
+				}
+				result[x_size] = first_carry;
+
+				for (std::size_t j = 1; j < y_size; ++j) {
+					element_type carry = 0;
+					for (std::size_t i = 0; i < x_size; ++i) {
+						auto mul = umul128(x[i], y[j]);
+						auto low = mul.low() + carry;
+						auto high = mul.high() + (low < carry ? 1 : 0);
+
+						result[i + j] += low;
+						carry = high + (result[i + j] < low ? 1 : 0);
+					}
+					result[x_size + j] = carry;
+				}
+			}
+
+			// Upper bound on the scratch space used by karatsuba_multiply,
+			// when the longer operand has the given number of elements
+			static std::size_t karatsuba_scratch_size(std::size_t size) noexcept {
+				std::size_t ret = 0;
+				while (size >= karatsuba_threshold) {
+					ret += 2 * size + 6;
+					size = size / 2 + 2;
+				}
+				return ret;
+			}
+
+			// result[0, x_size + y_size) = x[0, x_size) * y[0, y_size)
+			// result should not overlap with x, y, or scratch
+			static void karatsuba_multiply(element_type* result,
+				element_type const* x, std::size_t x_size,
+				element_type const* y, std::size_t y_size, element_type* scratch) noexcept
+			{
+				if (x_size < y_size) {
+					std::swap(x, y);
+					std::swap(x_size, y_size);
+				}
+				if (y_size < karatsuba_threshold) {
+					schoolbook_multiply(result, x, x_size, y, y_size);
+					return;
+				}
+
+				// If x is at least twice as long, multiply y to each chunk of x
+				if (2 * y_size <= x_size) {
+					std::fill_n(result, x_size + y_size, 0);
+					for (std::size_t offset = 0; offset < x_size; offset += y_size) {
+						auto const chunk_size = std::min(y_size, x_size - offset);
+						karatsuba_multiply(scratch, x + offset, chunk_size, y, y_size,
+							scratch + chunk_size + y_size);
+						[[maybe_unused]] auto const carry = add_elements(result + offset,
+							x_size + y_size - offset, scratch, chunk_size + y_size);
+						assert(carry == 0);
+					}
+					return;
+				}
+
+				// x = x1 * 2^(64m) + x0, y = y1 * 2^(64m) + y0,
+				// and x * y = z2 * 2^(128m) + z1 * 2^(64m) + z0, where
+				// z2 = x1 * y1, z0 = x0 * y0, z1 = (x0 + x1) * (y0 + y1) - z2 - z0
+				// Since y_size > x_size / 2 >= m, y1 is not empty
+				auto const m = x_size / 2;
+				auto const sum_x_size = x_size - m + 1;
+				auto const sum_y_size = std::max(m, y_size - m) + 1;
+				auto const sum_x = scratch;
+				auto const sum_y = sum_x + sum_x_size;
+				auto const z1 = sum_y + sum_y_size;
+				auto const next_scratch = z1 + sum_x_size + sum_y_size;
+
+				std::copy_n(x + m, x_size - m, sum_x);
+				sum_x[x_size - m] = add_elements(sum_x, x_size - m, x, m);
+				if (y_size - m >= m) {
+					std::copy_n(y + m, y_size - m, sum_y);
+					sum_y[y_size - m] = add_elements(sum_y, y_size - m, y, m);
+				}
+				else {
+					std::copy_n(y, m, sum_y);
+					sum_y[m] = add_elements(sum_y, m, y + m, y_size - m);
+				}
+
+				karatsuba_multiply(result, x, m, y, m, next_scratch);
+				karatsuba_multiply(result + 2 * m, x + m, x_size - m, y + m, y_size - m, next_scratch);
+				karatsuba_multiply(z1, sum_x, sum_x_size, sum_y, sum_y_size, next_scratch);
+
+				auto z1_size = sum_x_size + sum_y_size;
+				[[maybe_unused]] auto borrow = subtract_elements(z1, z1_size, result, 2 * m);
+				assert(borrow == 0);
+				borrow = subtract_elements(z1, z1_size, result + 2 * m, x_size + y_size - 2 * m);
+				assert(borrow == 0);
+
+				// z1 = x0 * y1 + x1 * y0 is less than 2^(64(x_size + 1)),
+				// but may have more elements than that
+				while (z1_size > 0 && z1[z1_size - 1] == 0) {
+					--z1_size;
+				}
+				[[maybe_unused]] auto const carry =
+					add_elements(result + m, x_size + y_size - m, z1, z1_size);
+				assert(carry == 0);
+			}
+
+			// result[0, x_size + y_size) = x[0, x_size) * y[0, y_size)
+			// result should not overlap with x or y
+			static void multiply_elements(element_type* result,
+				element_type const* x, std::size_t x_size,
+				element_type const* y, std::size_t y_size)
+			{
+				// The inner loop runs over the longer operand
+				if (x_size < y_size) {
+					std::swap(x, y);
+					std::swap(x_size, y_size);
+				}
+				if (y_size < karatsuba_threshold) {
+					schoolbook_multiply(result, x, x_size, y, y_size);
+				}
+				else {
+					std::vector<element_type> scratch(
+						karatsuba_scratch_size(std::max(x_size, y_size)));
+					karatsuba_multiply(result, x, x_size, y, y_size, scratch.data());
+				}
+			}
+
+			// Left-shift x[0, size) by shft bits, discarding the bits shifted out
+			// Precondition: shft < element_number_of_bits
+			static void shift_left_elements(element_type* x, std::size_t size, std::size_t shft) noexcept {
+				if (shft == 0 || size == 0)
+					return;
+				for (auto idx = size - 1; idx > 0; --idx) {
+					x[idx] = (x[idx] << shft) | (x[idx - 1] >> (element_number_of_bits - shft));
+				}
+				x[0] <<= shft;
+			}
+
+			// Right-shift x[0, size) by shft bits
+			// Precondition: shft < element_number_of_bits
+			static void shift_right_elements(element_type* x, std::size_t size, std::size_t shft) noexcept {
+				if (shft == 0 || size == 0)
+					return;
+				for (std::size_t idx = 0; idx + 1 < size; ++idx) {
+					x[idx] = (x[idx] >> shft) | (x[idx + 1] << (element_number_of_bits - shft));
+				}
+				x[size - 1] >>= shft;
+			}
+		};
+
+		template <std::size_t array_size>
+		struct bigint_impl;
+		
+		template <std::size_t max_bits>
+		using bigint = bigint_impl<(max_bits + bigint_base::element_number_of_bits - 1) /
+			bigint_base::element_number_of_bits>;
+
+		template <std::size_t array_size_>
+		struct bigint_impl : public bigint_base {
+			static constexpr std::size_t array_size = array_size_;
+
+			element_type		elements[array_size];
+			leading_one_pos_t	leading_one_pos;
+
+			bigint_impl() = default;
+
+			bigint_impl(element_type x) :
+				leading_one_pos{ 0, log2p1(x) }
+			{
+				elements[0] = x;
+				std::fill_n(std::begin(elements) + 1, array_size - 1, 0);
+			}
+
+			static bigint_impl power_of_2(std::size_t exp) noexcept {
+				assert(exp < array_size * element_number_of_bits);
+				bigint_impl ret;
+				std::fill_n(std::begin(ret.elements), array_size, 0);
+
+				ret.leading_one_pos.element_pos = exp / element_number_of_bits;
+				ret.leading_one_pos.bit_pos = exp % element_number_of_bits + 1;
+
+				ret.elements[ret.leading_one_pos.element_pos] =
+					(element_type(1) << (ret.leading_one_pos.bit_pos - 1));
+
+				return ret;
+			}
+
+			// Repeat multiplying 2 until the number becomes bigger than or equal to the given number
+			// Returns the number of multiplications
+			// Precondition: n should be bigger than or equal to the current number
+			// Note that this function need not require &n != this
+			std::size_t multiply_2_until(bigint_impl const& n) & {
+				assert(leading_one_pos.bit_pos != 0);
+
+				std::size_t number_of_multiplications = 0;
+
+				// Perform left-shift to match the leading-1 position
+				// Perform element-wise shift first
+				assert(leading_one_pos.element_pos <= n.leading_one_pos.element_pos);
+				auto element_pos_offset = n.leading_one_pos.element_pos - leading_one_pos.element_pos;
+				if (element_pos_offset > 0) {
+					number_of_multiplications = element_pos_offset * element_number_of_bits;
+
+					std::move_backward(std::begin(elements),
+						std::begin(elements) + leading_one_pos.element_pos + 1,
+						std::begin(elements) + n.leading_one_pos.element_pos + 1);
+
+					std::fill_n(std::begin(elements), element_pos_offset, 0);
+
+					leading_one_pos.element_pos += element_pos_offset;
+				}
+				// And then perform bit-wise shift
+				auto bit_pos_offset = std::ptrdiff_t(n.leading_one_pos.bit_pos) -
+					std::ptrdiff_t(leading_one_pos.bit_pos);
+				number_of_multiplications += bit_pos_offset;
+				if (bit_pos_offset > 0) {
+					// Left-shfit
+					auto shft = std::size_t(bit_pos_offset);
+					auto remaining_bits = element_number_of_bits - shft;
+					for (auto idx = leading_one_pos.element_pos; idx > 0; --idx) {
+						auto bits_to_transfer = elements[idx - 1] >> remaining_bits;
+
+						elements[idx] <<= shft;
+						elements[idx] |= bits_to_transfer;
+					}
+					elements[0] <<= shft;
+				}
+				else if (bit_pos_offset < 0) {
+					// Right-shift
+					auto shft = std::size_t(-bit_pos_offset);
+					auto remaining_bits = element_number_of_bits - shft;
+					elements[0] >>= shft;
+					for (std::size_t idx = 1; idx <= leading_one_pos.element_pos; ++idx) {
+						auto bits_to_transfer = elements[idx] << remaining_bits;
+
+						elements[idx - 1] |= bits_to_transfer;
+						elements[idx] >>= shft;
+					}
+				}
+				leading_one_pos.bit_pos = n.leading_one_pos.bit_pos;
+
+				// Compare the shifted number with the given number
+				bool is_bigger_than_or_equal_to = true;
+				for (auto idx = std::ptrdiff_t(leading_one_pos.element_pos); idx >= 0; --idx) {
+					if (elements[idx] > n.elements[idx])
+						break;
+					else if (elements[idx] < n.elements[idx]) {
+						is_bigger_than_or_equal_to = false;
+						break;
+					}
+				}
+
+				// If our number is still less
+				if (!is_bigger_than_or_equal_to) {
+					// Shift one more bit
+					++number_of_multiplications;
+					if (leading_one_pos.bit_pos == element_number_of_bits) {
+						leading_one_pos.bit_pos = 1;
+						++leading_one_pos.element_pos;
+						assert(leading_one_pos.element_pos != array_size);
+					}
+					else
+						++leading_one_pos.bit_pos;
+
+					constexpr auto remaining_bits = element_number_of_bits - 1;
+					for (auto idx = leading_one_pos.element_pos; idx > 0; --idx) {
+						elements[idx] <<= 1;
+						elements[idx] |= (elements[idx - 1] >> remaining_bits);
+					}
+					elements[0] <<= 1;
+				}
+
+				return number_of_multiplications;
+			}
+
+			// Multiply 5 to the current number
+			void multiply_5() & {
+				assert(leading_one_pos.bit_pos != 0);
+
+				decltype(elements) times_4;
+				leading_one_pos_t times_4_leading_one_pos{
+					leading_one_pos.element_pos,
+					leading_one_pos.bit_pos + 2
+				};
+
+				// Fix leading-1 position
+				if (times_4_leading_one_pos.bit_pos > element_number_of_bits) {
+					assert(leading_one_pos.element_pos + 1 != array_size);
+
+					times_4_leading_one_pos.bit_pos -= element_number_of_bits;
+					++times_4_leading_one_pos.element_pos;
+				}
+
+				// Calculate times_4
+				for (auto idx = times_4_leading_one_pos.element_pos; idx > 0; --idx) {
+					times_4[idx] = elements[idx] << 2;
+					times_4[idx] |= (elements[idx - 1] >> (element_number_of_bits - 2));
+				}
+				times_4[0] = elements[0] << 2;
+
+				// Add
+				elements[0] += times_4[0];
+				unsigned int carry = (elements[0] < times_4[0]) ? 1 : 0;
+
+				for (std::size_t idx = 1; idx <= times_4_leading_one_pos.element_pos; ++idx) {
+					auto copied_with_carry = elements[idx] + carry;
+					unsigned int first_carry = (copied_with_carry < elements[idx]) ? 1 : 0;
+
+					elements[idx] = copied_with_carry + times_4[idx];
+					carry = first_carry | ((elements[idx] < times_4[idx]) ? 1 : 0);
+				}
+
+				if (carry != 0) {
+					leading_one_pos.element_pos = times_4_leading_one_pos.element_pos + 1;
+					leading_one_pos.bit_pos = 1;
+
+					elements[leading_one_pos.element_pos] = 1;
+				}
+				else {
+					leading_one_pos.element_pos = times_4_leading_one_pos.element_pos;
+
+					// The expression "element_type(1) << times_4_leading_one_pos.bit_pos"
+					// is UB if times_4_leading_one_pos.bit_pos == element_number_of_bits,
+					// so we have to use the following instead:
+					auto threshold = element_type(-1) >>
+						(element_number_of_bits - times_4_leading_one_pos.bit_pos);
+					if (elements[leading_one_pos.element_pos] > threshold)
+						leading_one_pos.bit_pos = times_4_leading_one_pos.bit_pos + 1;
+					else
+						leading_one_pos.bit_pos = times_4_leading_one_pos.bit_pos;
+				}
+
+				assert(leading_one_pos.element_pos != array_size);
+				assert(leading_one_pos.bit_pos <= element_number_of_bits);
+			}
+
+		private:
+			constexpr int compare_common(bigint_impl const& n) const noexcept {
+				if (leading_one_pos.element_pos < n.leading_one_pos.element_pos)
+					return 1;
+				else if (leading_one_pos.element_pos > n.leading_one_pos.element_pos)
+					return -1;
+
+				for (std::size_t idx = leading_one_pos.element_pos; idx > 0; --idx) {
+					if (elements[idx] < n.elements[idx])
+						return 1;
+					else if (elements[idx] > n.elements[idx])
+						return -1;
+				}
+
+				return 0;
+			}
+
+		public:
+			constexpr bool operator<(bigint_impl const& n) const noexcept {
+				auto c = compare_common(n);
+				if (c > 0)
+					return true;
+				else if (c < 0)
+					return false;
+
+				if (elements[0] < n.elements[0])
+					return true;
+				else
+					return false;
+			}
+			constexpr bool operator<=(bigint_impl const& n) const noexcept {
+				auto c = compare_common(n);
+				if (c > 0)
+					return true;
+				else if (c < 0)
+					return false;
+
+				if (elements[0] <= n.elements[0])
+					return true;
+				else
+					return false;
+			}
+			constexpr bool operator>(bigint_impl const& n) const noexcept {
+				auto c = compare_common(n);
+				if (c < 0)
+					return true;
+				else if (c > 0)
+					return false;
+
+				if (elements[0] > n.elements[0])
+					return true;
+				else
+					return false;
+			}
+			constexpr bool operator>=(bigint_impl const& n) const noexcept {
+				auto c = compare_common(n);
+				if (c < 0)
+					return true;
+				else if (c > 0)
+					return false;
+
+				if (elements[0] >= n.elements[0])
+					return true;
+				else
+					return false;
+			}
+			constexpr bool operator==(bigint_impl const& n) const noexcept {
+				auto c = compare_common(n);
+				if (c != 0)
+					return false;
+
+				return elements[0] == n.elements[0];
+			}
+			constexpr bool operator!=(bigint_impl const& n) const noexcept {
+				auto c = compare_common(n);
+				if (c != 0)
+					return true;
+
+				return elements[0] != n.elements[0];
+			}
+
+			constexpr bool operator<(element_type n) const noexcept {
+				if (leading_one_pos.element_pos != 0)
+					return false;
+				return elements[0] < n;
+			}
+			constexpr bool operator<=(element_type n) const noexcept {
+				if (leading_one_pos.element_pos != 0)
+					return false;
+				return elements[0] <= n;
+			}
+			constexpr bool operator>(element_type n) const noexcept {
+				if (leading_one_pos.element_pos != 0)
+					return true;
+				return elements[0] > n;
+			}
+			constexpr bool operator>=(element_type n) const noexcept {
+				if (leading_one_pos.element_pos != 0)
+					return true;
+				return elements[0] >= n;
+			}
+			constexpr bool operator==(element_type n) const noexcept {
+				if (leading_one_pos.element_pos != 0)
+					return false;
+				return elements[0] == n;
+			}
+			constexpr bool operator!=(element_type n) const noexcept {
+				if (leading_one_pos.element_pos != 0)
+					return true;
+				return elements[0] != n;
+			}
+
+			// Add another number
+			constexpr bigint_impl& operator+=(bigint_impl const& n) & {
+				// This auxiliary variable is necessary to avoid the problem of a += a
+				auto n_element = n.elements[0];
+
+				elements[0] += n_element;
+				unsigned int carry = (elements[0] < n_element) ? 1 : 0;
+
+				std::size_t idx = 1;
+				auto add_common = [&](std::size_t min_idx) {
+					for (; idx <= min_idx; ++idx) {
+						auto with_carry = elements[idx] + carry;
+						unsigned int first_carry = (with_carry < elements[idx]) ? 1 : 0;
+
+						n_element = n.elements[idx];
+						elements[idx] = with_carry + n_element;
+						carry = first_carry | ((elements[idx] < n_element) ? 1 : 0);
+					}
+				};
+				auto set_leading_one_pos = [&](std::size_t max_idx) {
+					if (carry != 0) {
+						assert(max_idx + 1 < array_size);
+						leading_one_pos.element_pos = max_idx + 1;
+						leading_one_pos.bit_pos = 1;
+						elements[max_idx + 1] = 1;
+					}
+					else {
+						leading_one_pos.element_pos = max_idx;
+						leading_one_pos.bit_pos = log2p1(elements[max_idx]);
+					}
+				};
+
+				if (leading_one_pos.element_pos < n.leading_one_pos.element_pos) {
+					add_common(leading_one_pos.element_pos);
+
+					for (; idx <= n.leading_one_pos.element_pos; ++idx) {
+						elements[idx] = n.elements[idx] + carry;
+						carry = elements[idx] < carry ? 1 : 0;
+					}
+
+					set_leading_one_pos(n.leading_one_pos.element_pos);
+				}
+				else {
+					add_common(n.leading_one_pos.element_pos);
+
+					for (; idx <= leading_one_pos.element_pos; ++idx) {
+						elements[idx] += carry;
+						carry = elements[idx] < carry ? 1 : 0;
+					}
+
+					set_leading_one_pos(leading_one_pos.element_pos);
+				}
+
+				return *this;
+			}
+
+			constexpr bigint_impl& operator+=(element_type n) & {
+				elements[0] += n;
+				unsigned int carry = (elements[0] < n) ? 1 : 0;
+
+				for (std::size_t idx = 1; idx <= leading_one_pos.element_pos; ++idx) {
+					elements[idx] += carry;
+					carry = elements[idx] < carry ? 1 : 0;
+				}
+
+				if (carry != 0) {
+					assert(leading_one_pos.element_pos + 1 < array_size);
+					++leading_one_pos.element_pos;
+					leading_one_pos.bit_pos = 1;
+					elements[leading_one_pos.element_pos] = 1;
+				}
+
+				return *this;
+			}
+
+			// Subtract another number
+			// Precondition: n should be strictly smaller than or equal to the current number
+			constexpr bigint_impl& operator-=(bigint_impl const& n) & {
+				unsigned int carry = elements[0] < n.elements[0] ? 1 : 0;
+				elements[0] -= n.elements[0];
+
+				std::size_t idx = 1;
+				for (; idx <= n.leading_one_pos.element_pos; ++idx) {
+					auto with_carry = n.elements[idx] + carry;
+					unsigned int first_carry = (with_carry < carry) ? 1 : 0;
+
+					carry = first_carry | ((elements[idx] < with_carry) ? 1 : 0);
+					elements[idx] -= with_carry;
+				}
+
+				// The borrow stops at the leading element at the latest, since n is not larger
+				if (carry != 0) {
+					for (; idx < leading_one_pos.element_pos && elements[idx] == 0; ++idx) {
+						elements[idx] = element_type(-1);
+					}
+					--elements[idx];
+				}
+
+				// Find the new leading-1 position
+				for (idx = leading_one_pos.element_pos; idx > 0; --idx) {
+					if (elements[idx] != 0)
+						break;
+				}
+
+				leading_one_pos.element_pos = idx;
+				leading_one_pos.bit_pos = log2p1(elements[idx]);
+
+				return *this;
+			}
+
+			// Subtract one
+			// Precondition: *this should be nonzero
+			constexpr bigint_impl& operator--() & {
+				std::size_t idx = 0;
+				while (elements[idx] == 0) {
+					elements[idx] = element_type(-1);
+					++idx;
+					assert(idx <= leading_one_pos.element_pos);
+				}
+				--elements[idx];
+
+				// Find the new leading-1 position
+				if (elements[idx] == 0) {
+					if (idx == 0) {
+						leading_one_pos.bit_pos = 0;
+					}
+					else {
+						--leading_one_pos.element_pos;
+						leading_one_pos.bit_pos = element_number_of_bits;
+					}
+				}
+				else {
+					leading_one_pos.bit_pos = log2p1(elements[idx]);
+				}
+
+				return *this;
+			}
+
+			// Multiply a single element
+			bigint_impl& operator*=(element_type n) & {
+				element_type carry = 0;
+				for (std::size_t idx = 0; idx <= leading_one_pos.element_pos; ++idx) {
+					auto mul = umul128(elements[idx], n);
+					elements[idx] = mul.low() + carry;
+					carry = mul.high() + (elements[idx] < mul.low() ? 1 : 0);
+				}
+				if (carry != 0) {
+					assert(leading_one_pos.element_pos < array_size - 1);
+					elements[++leading_one_pos.element_pos] = carry;
+					leading_one_pos.bit_pos = log2p1(carry);
+				}
+				else {
+					leading_one_pos.bit_pos = log2p1(elements[leading_one_pos.element_pos]);
+				}
+				return *this;
+			}
+
+			// Multiplication
+			friend bigint_impl operator*(bigint_impl const& x, bigint_impl const& y) {
+				// Leaky overflow check
+				assert(x.leading_one_pos.element_pos + y.leading_one_pos.element_pos < array_size);
+
+				auto const x_size = x.leading_one_pos.element_pos + 1;
+				auto const y_size = y.leading_one_pos.element_pos + 1;
+
+				bigint_impl result;
+				if (x_size + y_size <= array_size) {
+					multiply_elements(result.elements, x.elements, x_size, y.elements, y_size);
+					std::fill(std::begin(result.elements) + x_size + y_size, std::end(result.elements), 0);
+					result.find_leading_one_pos(x_size + y_size - 1);
+				}
+				else {
+					// The product has one more element than the result can hold, which should be zero
+					element_type product[array_size + 1];
+					multiply_elements(product, x.elements, x_size, y.elements, y_size);
+					assert(product[array_size] == 0);
+
+					std::copy_n(product, array_size, std::begin(result.elements));
+					result.find_leading_one_pos(array_size - 1);
+				}
+
+				return result;
+			}
+
+			// Left-shift; whole elements are moved first, and then the remaining bits are shifted
+			bigint_impl& operator<<=(std::size_t shft) & {
+				if (leading_one_pos.bit_pos == 0)
+					return *this;
+
+				auto const element_shft = shft / element_number_of_bits;
+				auto const bit_shft = shft % element_number_of_bits;
+				auto const new_element_pos = leading_one_pos.element_pos + element_shft +
+					(leading_one_pos.bit_pos + bit_shft > element_number_of_bits ? 1 : 0);
+				assert(new_element_pos < array_size);
+
+				if (element_shft != 0) {
+					std::move_backward(std::begin(elements),
+						std::begin(elements) + leading_one_pos.element_pos + 1,
+						std::begin(elements) + leading_one_pos.element_pos + 1 + element_shft);
+					std::fill_n(std::begin(elements), element_shft, 0);
+				}
+				// The element above the old leading one is zero
+				shift_left_elements(elements + element_shft,
+					new_element_pos - element_shft + 1, bit_shft);
+
+				leading_one_pos.element_pos = new_element_pos;
+				leading_one_pos.bit_pos =
+					(leading_one_pos.bit_pos + bit_shft - 1) % element_number_of_bits + 1;
+
+				return *this;
+			}
+
+			// Right-shift; whole elements are moved first, and then the remaining bits are shifted
+			bigint_impl& operator>>=(std::size_t shft) & {
+				if (shft >= leading_one_pos.element_pos * element_number_of_bits + leading_one_pos.bit_pos) {
+					std::fill_n(std::begin(elements), leading_one_pos.element_pos + 1, 0);
+					leading_one_pos = { 0, 0 };
+					return *this;
+				}
+
+				auto const element_shft = shft / element_number_of_bits;
+				auto const bit_shft = shft % element_number_of_bits;
+				auto const new_size = leading_one_pos.element_pos - element_shft + 1;
+
+				if (element_shft != 0) {
+					std::move(std::begin(elements) + element_shft,
+						std::begin(elements) + leading_one_pos.element_pos + 1, std::begin(elements));
+					std::fill_n(std::begin(elements) + new_size, element_shft, 0);
+				}
+				shift_right_elements(elements, new_size, bit_shft);
+
+				if (leading_one_pos.bit_pos > bit_shft) {
+					leading_one_pos.element_pos = new_size - 1;
+					leading_one_pos.bit_pos -= bit_shft;
+				}
+				else {
+					leading_one_pos.element_pos = new_size - 2;
+					leading_one_pos.bit_pos += element_number_of_bits - bit_shft;
+				}
+
+				return *this;
+			}
+
+			// Perform long division
+			// *this becomes the remainder, returns the quotient
+			// Precondition: n != 0
+			bigint_impl long_division(bigint_impl const& n) & {
+				assert(n.leading_one_pos.bit_pos != 0);
+				bigint_impl quotient = 0;
+
+				if (*this < n)
+					return quotient;
+
+				auto const divisor_size = n.leading_one_pos.element_pos + 1;
+				auto const dividend_size = leading_one_pos.element_pos + 1;
+				auto const divisor_leading_element = n.elements[divisor_size - 1];
+
+				// Division by a power of 2 is a shift
+				if ((divisor_leading_element & (divisor_leading_element - 1)) == 0 &&
+					std::all_of(std::begin(n.elements), std::begin(n.elements) + divisor_size - 1,
+						[](element_type x) { return x == 0; }))
+				{
+					auto const element_shft = divisor_size - 1;
+					auto const bit_shft = n.leading_one_pos.bit_pos - 1;
+					auto const quotient_size = dividend_size - element_shft;
+
+					std::copy_n(std::begin(elements) + element_shft, quotient_size,
+						std::begin(quotient.elements));
+					shift_right_elements(quotient.elements, quotient_size, bit_shft);
+					quotient.find_leading_one_pos(quotient_size - 1);
+
+					// Leave only the lower bits
+					elements[element_shft] &= divisor_leading_element - 1;
+					std::fill(std::begin(elements) + divisor_size, std::begin(elements) + dividend_size, 0);
+					find_leading_one_pos(element_shft);
+
+					return quotient;
+				}
+
+				// Division by a single element
+				if (divisor_size == 1) {
+					element_type remainder = 0;
+					for (auto idx = dividend_size; idx > 0; --idx) {
+						quotient.elements[idx - 1] =
+							divide_elements(remainder, elements[idx - 1], divisor_leading_element, remainder);
+					}
+					quotient.find_leading_one_pos(dividend_size - 1);
+
+					std::fill_n(std::begin(elements) + 1, dividend_size - 1, 0);
+					elements[0] = remainder;
+					leading_one_pos = { 0, log2p1(remainder) };
+
+					return quotient;
+				}
+
+				// Knuth's Algorithm D (TAOCP Vol. 2, 4.3.1)
+				// Each element of the quotient is estimated from the leading elements of the
+				// dividend and the divisor, left-shifted so that the leading element of the divisor
+				// has its highest bit set. The shifted elements are computed only when needed,
+				// and the estimate times the divisor is subtracted from *this in place.
+				auto const shft = element_number_of_bits - n.leading_one_pos.bit_pos;
+				auto normalize = [shft](element_type high, element_type low) {
+					return shft == 0 ? high : ((high << shft) | (low >> (element_number_of_bits - shft)));
+				};
+				auto const divisor_high = normalize(n.elements[divisor_size - 1], n.elements[divisor_size - 2]);
+				auto const divisor_low = normalize(n.elements[divisor_size - 2],
+					divisor_size > 2 ? n.elements[divisor_size - 3] : 0);
+
+				for (auto j = dividend_size - divisor_size + 1; j > 0; --j) {
+					auto const base = elements + j - 1;
+
+					// The element above the dividend is regarded as zero
+					auto const top_idx = j - 1 + divisor_size;
+					auto const top = top_idx < dividend_size ? elements[top_idx] : 0;
+					auto const u2 = normalize(top, elements[top_idx - 1]);
+					auto const u1 = normalize(elements[top_idx - 1], elements[top_idx - 2]);
+					auto const u0 = normalize(elements[top_idx - 2], top_idx >= 3 ? elements[top_idx - 3] : 0);
+
+					// The estimate is either correct or one bigger than the correct one
+					element_type q_hat, r_hat;
+					bool r_hat_overflow;
+					if (u2 == divisor_high) {
+						q_hat = element_type(-1);
+						r_hat = u1 + divisor_high;
+						r_hat_overflow = r_hat < divisor_high;
+					}
+					else {
+						q_hat = divide_elements(u2, u1, divisor_high, r_hat);
+						r_hat_overflow = false;
+					}
+					while (!r_hat_overflow) {
+						auto mul = umul128(q_hat, divisor_low);
+						if (mul.high() < r_hat || (mul.high() == r_hat && mul.low() <= u0))
+							break;
+
+						--q_hat;
+						r_hat += divisor_high;
+						r_hat_overflow = r_hat < divisor_high;
+					}
+
+					// Subtract q_hat * n; quotients in the Euclid algorithm are mostly 0 or 1
+					element_type mul_carry = 0;
+					element_type borrow = 0;
+					if (q_hat == 1) {
+						borrow = subtract_elements(base, divisor_size, n.elements, divisor_size);
+					}
+					else if (q_hat != 0) {
+						for (std::size_t idx = 0; idx < divisor_size; ++idx) {
+							auto mul = umul128(q_hat, n.elements[idx]);
+							auto low = mul.low() + mul_carry;
+							mul_carry = mul.high() + (low < mul_carry ? 1 : 0);
+
+							auto with_borrow = low + borrow;
+							element_type first_borrow = with_borrow < borrow ? 1 : 0;
+
+							borrow = first_borrow | (base[idx] < with_borrow ? 1 : 0);
+							base[idx] -= with_borrow;
+						}
+					}
+
+					// If the estimate was too big, add n back
+					if (top < mul_carry || top - mul_carry < borrow) {
+						--q_hat;
+						add_elements(base, divisor_size, n.elements, divisor_size);
+					}
+
+					// What remains is less than n * 2^(64(j-1))
+					if (top_idx < dividend_size) {
+						elements[top_idx] = 0;
+					}
+					quotient.elements[j - 1] = q_hat;
+				}
+				quotient.find_leading_one_pos(dividend_size - divisor_size);
+				find_leading_one_pos(divisor_size - 1);
+
+				return quotient;
+			}
+
+		private:
+			// Find the leading-1 position, given that every element above max_idx is zero
+			void find_leading_one_pos(std::size_t max_idx) & noexcept {
+				while (max_idx > 0 && elements[max_idx] == 0) {
+					--max_idx;
+				}
+				leading_one_pos.element_pos = max_idx;
+				leading_one_pos.bit_pos = log2p1(elements[max_idx]);
+			}
+		};
+
+
+	}
+}
+
+#endif
\ No newline at end of file
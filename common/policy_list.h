@@ -0,0 +1,85 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_GRISU_EXACT_POLICY_LIST
+#define JKJ_GRISU_EXACT_POLICY_LIST
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Every rounding mode and correct rounding search policy of Grisu-Exact as type lists,
+// for code that instantiates or benchmarks each combination
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../grisu_exact.h"
+
+template <class... T>
+struct type_list {};
+
+using rounding_modes = type_list<
+	jkj::grisu_exact_rounding_modes::nearest_to_even,
+	jkj::grisu_exact_rounding_modes::nearest_to_odd,
+	jkj::grisu_exact_rounding_modes::nearest_toward_plus_infinity,
+	jkj::grisu_exact_rounding_modes::nearest_toward_minus_infinity,
+	jkj::grisu_exact_rounding_modes::nearest_toward_zero,
+	jkj::grisu_exact_rounding_modes::nearest_away_from_zero,
+	jkj::grisu_exact_rounding_modes::nearest_to_even_static_boundary,
+	jkj::grisu_exact_rounding_modes::nearest_to_odd_static_boundary,
+	jkj::grisu_exact_rounding_modes::nearest_toward_plus_infinity_static_boundary,
+	jkj::grisu_exact_rounding_modes::nearest_toward_minus_infinity_static_boundary,
+	jkj::grisu_exact_rounding_modes::toward_plus_infinity,
+	jkj::grisu_exact_rounding_modes::toward_minus_infinity,
+	jkj::grisu_exact_rounding_modes::toward_zero,
+	jkj::grisu_exact_rounding_modes::away_from_zero
+>;
+
+using correct_rounding_searches = type_list<
+	jkj::grisu_exact_correct_rounding::do_not_care,
+	jkj::grisu_exact_correct_rounding::tie_to_even,
+	jkj::grisu_exact_correct_rounding::tie_to_odd,
+	jkj::grisu_exact_correct_rounding::tie_to_up,
+	jkj::grisu_exact_correct_rounding::tie_to_down
+>;
+
+// Name of each policy, without the namespace
+template <class Policy>
+constexpr char const* policy_name = nullptr;
+
+#define JKJ_POLICY_NAME(ns, name) \
+	template <> constexpr char const* policy_name<jkj::ns::name> = #name
+
+JKJ_POLICY_NAME(grisu_exact_rounding_modes, nearest_to_even);
+JKJ_POLICY_NAME(grisu_exact_rounding_modes, nearest_to_odd);
+JKJ_POLICY_NAME(grisu_exact_rounding_modes, nearest_toward_plus_infinity);
+JKJ_POLICY_NAME(grisu_exact_rounding_modes, nearest_toward_minus_infinity);
+JKJ_POLICY_NAME(grisu_exact_rounding_modes, nearest_toward_zero);
+JKJ_POLICY_NAME(grisu_exact_rounding_modes, nearest_away_from_zero);
+JKJ_POLICY_NAME(grisu_exact_rounding_modes, nearest_to_even_static_boundary);
+JKJ_POLICY_NAME(grisu_exact_rounding_modes, nearest_to_odd_static_boundary);
+JKJ_POLICY_NAME(grisu_exact_rounding_modes, nearest_toward_plus_infinity_static_boundary);
+JKJ_POLICY_NAME(grisu_exact_rounding_modes, nearest_toward_minus_infinity_static_boundary);
+JKJ_POLICY_NAME(grisu_exact_rounding_modes, toward_plus_infinity);
+JKJ_POLICY_NAME(grisu_exact_rounding_modes, toward_minus_infinity);
+JKJ_POLICY_NAME(grisu_exact_rounding_modes, toward_zero);
+JKJ_POLICY_NAME(grisu_exact_rounding_modes, away_from_zero);
+JKJ_POLICY_NAME(grisu_exact_correct_rounding, do_not_care);
+JKJ_POLICY_NAME(grisu_exact_correct_rounding, tie_to_even);
+JKJ_POLICY_NAME(grisu_exact_correct_rounding, tie_to_odd);
+JKJ_POLICY_NAME(grisu_exact_correct_rounding, tie_to_up);
+JKJ_POLICY_NAME(grisu_exact_correct_rounding, tie_to_down);
+
+#undef JKJ_POLICY_NAME
+
+#endif
\ No newline at end of file
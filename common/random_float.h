@@ -0,0 +1,400 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_GRISU_RANDOM_FLOAT
+#define JKJ_GRISU_RANDOM_FLOAT
+
+#include "../grisu_exact.h"
+#include "bigint.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+// For correct seeding
+class repeating_seed_seq {
+public:
+	using result_type = std::uint32_t;
+
+	repeating_seed_seq() : stored_values{ 0 } {}
+	template <class InputIterator>
+	repeating_seed_seq(InputIterator first, InputIterator last) :
+		stored_values(first, last) {}
+	template <class T>
+	repeating_seed_seq(std::initializer_list<T> list) :
+		stored_values(list) {}
+
+	repeating_seed_seq(std::random_device&& rd, std::size_t count) {
+		stored_values.resize(count);
+		for (auto& elem : stored_values)
+			elem = rd();
+	}
+
+	template <class RandomAccessIterator>
+	void generate(RandomAccessIterator first, RandomAccessIterator last)
+	{
+		auto count = last - first;
+		auto q = count / stored_values.size();
+		for (std::size_t i = 0; i < q; ++i) {
+			std::copy_n(stored_values.cbegin(), stored_values.size(), first);
+			first += stored_values.size();
+		}
+		count -= q * stored_values.size();
+		std::copy_n(stored_values.cbegin(), count, first);
+	}
+
+	std::size_t size() const noexcept {
+		return stored_values.size();
+	}
+
+	template <class OutputIterator>
+	void param(OutputIterator first) const {
+		std::copy(stored_values.begin(), stored_values.end(), first);
+	}
+
+private:
+	std::vector<std::uint32_t>		stored_values;
+};
+
+inline std::mt19937_64 generate_correctly_seeded_mt19937_64()
+{
+	repeating_seed_seq seed_seq{ std::random_device{},
+		std::mt19937_64::state_size * std::mt19937_64::word_size / (sizeof(std::uint32_t) * 8) };
+	return std::mt19937_64{ seed_seq };
+}
+
+template <class Float, class RandGen>
+Float uniformly_randomly_generate_finite_float(RandGen& rg)
+{
+	using common_info = jkj::grisu_exact_detail::common_info<Float>;
+	using extended_significand_type =
+		typename common_info::extended_significand_type;
+	using uniform_distribution = std::uniform_int_distribution<extended_significand_type>;
+
+	// Generate sign bit
+	auto sign_bit = uniform_distribution{ 0, 1 }(rg);
+
+	// Generate exponent bits
+	auto exponent_bits = uniform_distribution{ 0,
+		(extended_significand_type(1) << common_info::exponent_bits) - 2 }(rg);
+
+	// Generate significand bits
+	auto significand_bits = uniform_distribution{ 0,
+		(extended_significand_type(1) << common_info::precision) - 1 }(rg);
+
+	auto bit_representation = (sign_bit << (common_info::extended_precision - 1))
+		| (exponent_bits << (common_info::precision))
+		| significand_bits;
+
+	Float ret;
+	std::memcpy(&ret, &bit_representation, sizeof(Float));
+	return ret;
+}
+
+template <class Float, class RandGen>
+Float uniformly_randomly_generate_general_float(RandGen& rg)
+{
+	using common_info = jkj::grisu_exact_detail::common_info<Float>;
+	using extended_significand_type =
+		typename common_info::extended_significand_type;
+	using uniform_distribution = std::uniform_int_distribution<extended_significand_type>;
+
+	// Generate sign bit
+	auto bit_representation = uniform_distribution{
+		0, std::numeric_limits<extended_significand_type>::max() }(rg);
+	Float ret;
+	std::memcpy(&ret, &bit_representation, sizeof(Float));
+	return ret;
+}
+
+namespace random_float_detail {
+	using jkj::grisu_exact_detail::uint128;
+
+	// Upper 128 bits of x * y
+	inline uint128 umul192_upper128(std::uint64_t x, uint128 y) noexcept {
+		using jkj::grisu_exact_detail::umul128;
+		auto const g0 = umul128(x, y.high());
+		auto const g1 = umul128(x, y.low());
+		auto const low = g0.low() + g1.high();
+		return{ g0.high() + (low < g0.low() ? 1 : 0), low };
+	}
+
+	// Upper 128 bits of x * y, up to an error of 2
+	inline uint128 umul256_upper128(uint128 x, uint128 y) noexcept {
+		using jkj::grisu_exact_detail::umul128;
+		auto const hh = umul128(x.high(), y.high());
+		auto const hl = umul128(x.high(), y.low());
+		auto const lh = umul128(x.low(), y.high());
+		auto const middle = hl.low() + lh.low();
+		auto low = hh.low();
+		auto high = hh.high();
+		for (auto const summand : { hl.high(), lh.high(), std::uint64_t(middle < hl.low() ? 1 : 0) }) {
+			low += summand;
+			high += low < summand ? 1 : 0;
+		}
+		return{ high, low };
+	}
+
+	// Sign of significand * 10^exp10 - binary_significand * 2^exp2, computed exactly
+	inline int compare_decimal_with_binary(std::uint64_t significand, int exp10,
+		std::uint64_t binary_significand, int exp2)
+	{
+		using bigint_type = jkj::grisu_exact_detail::bigint<2048>;
+		auto multiply_power = [](bigint_type& n, std::uint64_t base, int max_exp, int exp) {
+			std::uint64_t power = 1;
+			for (int i = 0; i < max_exp; ++i)
+				power *= base;
+			for (; exp >= max_exp; exp -= max_exp)
+				n *= power;
+			for (power = 1; exp > 0; --exp)
+				power *= base;
+			n *= power;
+		};
+
+		bigint_type lhs = significand;
+		bigint_type rhs = binary_significand;
+		// 5^27 and 2^63 are the largest powers fitting in an element
+		multiply_power(exp10 >= 0 ? lhs : rhs, 5, 27, exp10 >= 0 ? exp10 : -exp10);
+		multiply_power(exp10 >= exp2 ? lhs : rhs, 2, 63,
+			exp10 >= exp2 ? exp10 - exp2 : exp2 - exp10);
+
+		return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+	}
+
+	// Computes the float nearest to significand * 10^exp10 (ties to even)
+	// Returns false on overflow and underflow to zero.
+	// The product with the cache of Grisu-Exact for binary64 is accurate enough to decide
+	// the rounding except in the very rare cases where the value is (nearly) a midpoint;
+	// those are settled by big integer arithmetic.
+	template <class Float>
+	bool decimal_to_nearest_float(std::uint64_t significand, int exp10, Float& result)
+	{
+		using common_info = jkj::grisu_exact_detail::common_info<double>;
+		using jkj::grisu_exact_detail::floor_log2_pow10;
+		using jkj::grisu_exact_detail::get_cache;
+		constexpr int precision = std::numeric_limits<Float>::digits;
+		constexpr int min_binary_exponent = std::numeric_limits<Float>::min_exponent - 1;
+		constexpr int max_binary_exponent = std::numeric_limits<Float>::max_exponent - 1;
+		// Bound of the error of the 128-bit approximation below, in its last place
+		constexpr std::uint64_t error_bound = 32;
+
+		assert(significand != 0);
+
+		// cache * 2^-cache_exponent approximates 10^exp10, with the leading bit of cache set
+		uint128 cache;
+		int cache_exponent;
+		if (exp10 >= common_info::min_k) {
+			assert(exp10 <= common_info::max_k);
+			cache = get_cache<double>(exp10);
+			cache_exponent = 127 - floor_log2_pow10(exp10);
+		}
+		else {
+			// Only reached for tiny values; split into two entries
+			auto const remaining_k = exp10 - common_info::min_k;
+			cache = umul256_upper128(get_cache<double>(common_info::min_k),
+				get_cache<double>(remaining_k));
+			cache_exponent = 126 - floor_log2_pow10(common_info::min_k)
+				- floor_log2_pow10(remaining_k);
+			if ((cache.high() >> 63) == 0) {
+				cache = { (cache.high() << 1) | (cache.low() >> 63), cache.low() << 1 };
+				++cache_exponent;
+			}
+		}
+
+		// The value is approximately upper * 2^binary_exponent, with the leading bit of upper set
+		auto const leading_zeros = int(64 - jkj::grisu_exact_detail::log2p1(significand));
+		auto upper = umul192_upper128(significand << leading_zeros, cache);
+		int binary_exponent = 64 - leading_zeros - cache_exponent;
+		if ((upper.high() >> 63) == 0) {
+			upper = { (upper.high() << 1) | (upper.low() >> 63), upper.low() << 1 };
+			--binary_exponent;
+		}
+
+		// Number of bits to keep, taking subnormals into account
+		auto const leading_exponent = binary_exponent + 127;
+		if (leading_exponent > max_binary_exponent) {
+			return false;
+		}
+		int kept_bits = precision;
+		if (leading_exponent < min_binary_exponent) {
+			kept_bits -= min_binary_exponent - leading_exponent;
+			// Rounds to zero or to the smallest subnormal, both of which are
+			// shorter than any sample we want
+			if (kept_bits < 1) {
+				return false;
+			}
+		}
+
+		// Round to nearest
+		auto const shift = 128 - kept_bits;		// 75 ~ 127
+		auto const mask = (std::uint64_t(1) << (shift - 64)) - 1;
+		auto rounded = upper.high() >> (shift - 64);
+		auto const remainder_high = upper.high() & mask;
+		auto const half_high = std::uint64_t(1) << (shift - 65);
+		auto const output_exponent = binary_exponent + shift;
+
+		bool round_up;
+		if ((remainder_high == half_high && upper.low() <= error_bound) ||
+			(remainder_high == half_high - 1 && upper.low() >= std::uint64_t(0) - error_bound))
+		{
+			auto const c = compare_decimal_with_binary(significand, exp10,
+				2 * rounded + 1, output_exponent - 1);
+			round_up = c > 0 || (c == 0 && rounded % 2 != 0);
+		}
+		else {
+			round_up = remainder_high >= half_high;
+		}
+		if (round_up) {
+			++rounded;
+		}
+
+		// Exact, including subnormals; overflows into infinity when rounded up at the top
+		result = std::ldexp(Float(rounded), output_exponent);
+		return !std::isinf(result);
+	}
+}
+
+// Uniformly randomly chooses a sign, a decimal significand of the given number of digits,
+// and a decimal exponent, and generates the float nearest to the value (ties to even).
+// Values overflowing, underflowing, or admitting a shorter representation are discarded
+// and drawn again. The rounding and the check of the shortest representation are both exact.
+// Values whose ulp is too large compared to the last decimal place can never be accepted,
+// as their rounding intervals always contain a shorter representation; those are excluded
+// before drawing, which keeps the distribution of accepted samples the same.
+template <class Float>
+class random_float_with_given_digits {
+public:
+	explicit random_float_with_given_digits(unsigned int digits) :
+		from_{ 1 }, min_exponent_{ std::numeric_limits<Float>::min_exponent10 - (int(digits) - 1) }
+	{
+		assert(digits >= 1);
+		if constexpr (std::is_same_v<Float, float>) {
+			assert(digits <= 9);
+		}
+		else {
+			static_assert(std::is_same_v<Float, double>);
+			assert(digits <= 17);
+		}
+
+		for (unsigned int e = 1; e < digits; ++e) {
+			from_ *= 10;
+		}
+
+		// If ulp(v) > 4/3 * 10^(exp10 + 1), then the rounding interval, whose length is at least
+		// 3/4 * ulp(v), contains a multiple of 10^(exp10 + 1); so only v < 2^(x + precision)
+		// for the largest x with 2^x <= 4/3 * 10^(exp10 + 1) need to be drawn
+		constexpr int precision = std::numeric_limits<Float>::digits;
+		constexpr double log2_10 = 3.32192809488736234787;
+		constexpr double log2_4_over_3 = 0.41503749927884381855;
+		constexpr double log10_2 = 0.30102999566398119521;
+		auto const max_exponent = std::numeric_limits<Float>::max_exponent10 - (int(digits) - 1);
+		std::uint64_t number_of_significands = 0;
+		for (auto exp10 = min_exponent_; exp10 <= max_exponent; ++exp10) {
+			// Errors are on the safe side
+			auto const x = std::floor(log2_4_over_3 + (exp10 + 1) * log2_10 + 1e-9);
+			auto const log10_max_significand = (x + precision) * log10_2 - exp10 + 1e-9;
+			auto const max_leading_digits = log10_max_significand >= std::log10(10.0 * from_)
+				? from_ - 1
+				: std::uint64_t(std::pow(10.0, log10_max_significand - 1));
+
+			if (max_leading_digits >= from_ / 10) {
+				number_of_significands += max_leading_digits - from_ / 10 + 1;
+			}
+			cumulative_counts_.push_back(number_of_significands);
+		}
+	}
+
+	template <class RandGen>
+	Float operator()(RandGen& rg) {
+		while (true) {
+			// Leading digits and exponent are drawn together by a single number
+			auto const index = std::uniform_int_distribution<std::uint64_t>{
+				0, cumulative_counts_.back() - 1 }(rg);
+			auto const exponent_position = std::upper_bound(cumulative_counts_.begin(),
+				cumulative_counts_.end(), index);
+			auto const exp10 = min_exponent_ + int(exponent_position - cumulative_counts_.begin());
+			auto const leading_digits = from_ / 10 + index -
+				(exponent_position == cumulative_counts_.begin() ? 0 : *(exponent_position - 1));
+
+			// The last digit is nonzero, so significands are exactly digits long
+			auto const significand = leading_digits * 10 +
+				std::uniform_int_distribution<std::uint64_t>{ 1, 9 }(rg);
+
+			Float result;
+			if (!random_float_detail::decimal_to_nearest_float(significand, exp10, result)) {
+				continue;
+			}
+
+			// Discard if a shorter representation exists
+			// We don't need to care about sign and correct rounding here
+			auto const shortest = jkj::grisu_exact<false>(result,
+				jkj::grisu_exact_rounding_modes::nearest_to_even{},
+				jkj::grisu_exact_correct_rounding::do_not_care{});
+			auto shortest_significand = shortest.significand;
+			while (shortest_significand % 10 == 0) {
+				shortest_significand /= 10;
+			}
+			if (shortest_significand < from_) {
+				continue;
+			}
+
+			return std::uniform_int_distribution<int>{ 0, 1 }(rg) == 0 ? result : -result;
+		}
+	}
+
+private:
+	std::uint64_t				from_;		// 10^(digits - 1)
+	int							min_exponent_;
+	// Number of leading digits to be drawn for exponents up to min_exponent_ + i
+	std::vector<std::uint64_t>	cumulative_counts_;
+};
+
+// Generates a single sample; use random_float_with_given_digits directly for many samples
+template <class Float, class RandGen>
+Float randomly_generate_float_with_given_digits(unsigned int digits, RandGen& rg)
+{
+	return random_float_with_given_digits<Float>{ digits }(rg);
+}
+
+// Uniformly random samples in [0], and samples of d digits in [d] for d = 1, ... , 9 (float)
+// or 17 (double), generated in this order; the same rg gives the same samples
+template <class Float, class RandGen>
+std::vector<std::vector<Float>> generate_benchmark_samples(std::size_t number_of_general_samples,
+	std::size_t number_of_digits_samples_per_digits, RandGen& rg)
+{
+	constexpr unsigned int max_digits = std::is_same_v<Float, float> ? 9 : 17;
+	std::vector<std::vector<Float>> ret(max_digits + 1);
+
+	ret[0].resize(number_of_general_samples);
+	for (auto& sample : ret[0])
+		sample = uniformly_randomly_generate_general_float<Float>(rg);
+
+	for (unsigned int digits = 1; digits <= max_digits; ++digits) {
+		random_float_with_given_digits<Float> generator{ digits };
+		ret[digits].resize(number_of_digits_samples_per_digits);
+		for (auto& sample : ret[digits])
+			sample = generator(rg);
+	}
+	return ret;
+}
+
+#endif
\ No newline at end of file
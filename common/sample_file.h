@@ -0,0 +1,206 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_GRISU_EXACT_SAMPLE_FILE
+#define JKJ_GRISU_EXACT_SAMPLE_FILE
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Flat binary files of samples, written by benchmark/make_sample_file.cpp
+// A fixed-size header is followed by the samples of each bucket in order:
+// uniformly random samples (bucket 0), then samples of 1, 2, ... digits.
+// Samples are stored in the native byte order; the header records sizeof(Float)
+// and the byte order, so a file from a different platform is rejected.
+// Files are memory-mapped where possible, so opening them costs almost nothing.
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define JKJ_SAMPLE_FILE_HAS_MMAP 1
+#else
+#define JKJ_SAMPLE_FILE_HAS_MMAP 0
+#endif
+
+struct sample_file_header {
+	static constexpr char expected_magic[8] = { 'G', 'E', 'S', 'A', 'M', 'P', 'L', 'E' };
+	static constexpr std::uint32_t current_version = 1;
+	static constexpr std::uint32_t byte_order_mark = 0x01020304;
+	static constexpr std::size_t max_number_of_buckets = 24;
+
+	char			magic[8];
+	std::uint32_t	version;
+	std::uint32_t	byte_order;
+	std::uint32_t	float_size;
+	std::uint32_t	number_of_buckets;
+	// Seed of std::mt19937_64 used to generate the samples
+	std::uint64_t	seed;
+	std::uint64_t	bucket_sizes[max_number_of_buckets];
+};
+static_assert(sizeof(sample_file_header) % 8 == 0);
+
+// buckets[0] for uniformly random samples, buckets[d] for samples of d digits
+template <class Float>
+bool write_sample_file(std::string const& filename, std::uint64_t seed,
+	std::vector<std::vector<Float>> const& buckets)
+{
+	if (buckets.size() > sample_file_header::max_number_of_buckets) {
+		return false;
+	}
+
+	sample_file_header header{};
+	std::memcpy(header.magic, sample_file_header::expected_magic, sizeof(header.magic));
+	header.version = sample_file_header::current_version;
+	header.byte_order = sample_file_header::byte_order_mark;
+	header.float_size = std::uint32_t(sizeof(Float));
+	header.number_of_buckets = std::uint32_t(buckets.size());
+	header.seed = seed;
+	for (std::size_t idx = 0; idx < buckets.size(); ++idx) {
+		header.bucket_sizes[idx] = buckets[idx].size();
+	}
+
+	std::ofstream out{ filename, std::ios::binary };
+	out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+	for (auto const& bucket : buckets) {
+		out.write(reinterpret_cast<char const*>(bucket.data()),
+			std::streamsize(bucket.size() * sizeof(Float)));
+	}
+	return bool(out);
+}
+
+class sample_file {
+public:
+	sample_file() = default;
+	sample_file(sample_file const&) = delete;
+	sample_file& operator=(sample_file const&) = delete;
+	~sample_file() { close(); }
+
+	// Returns an empty string on success, or an error message
+	std::string open(std::string const& filename) {
+		close();
+#if JKJ_SAMPLE_FILE_HAS_MMAP
+		int const fd = ::open(filename.c_str(), O_RDONLY);
+		if (fd < 0) {
+			return "cannot open " + filename;
+		}
+		struct stat st;
+		if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+			auto const ptr = ::mmap(nullptr, std::size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			if (ptr != MAP_FAILED) {
+				data_ = static_cast<unsigned char const*>(ptr);
+				size_ = std::size_t(st.st_size);
+			}
+		}
+		::close(fd);
+		if (!data_) {
+			return "cannot map " + filename;
+		}
+#else
+		std::ifstream in{ filename, std::ios::binary };
+		if (!in) {
+			return "cannot open " + filename;
+		}
+		buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		data_ = reinterpret_cast<unsigned char const*>(buffer_.data());
+		size_ = buffer_.size();
+#endif
+
+		if (size_ < sizeof(sample_file_header)) {
+			close();
+			return filename + " is too short";
+		}
+		std::memcpy(&header_, data_, sizeof(header_));
+		if (std::memcmp(header_.magic, sample_file_header::expected_magic,
+			sizeof(header_.magic)) != 0 || header_.version != sample_file_header::current_version)
+		{
+			close();
+			return filename + " is not a sample file";
+		}
+		if (header_.byte_order != sample_file_header::byte_order_mark ||
+			header_.number_of_buckets > sample_file_header::max_number_of_buckets ||
+			(header_.float_size != 4 && header_.float_size != 8))
+		{
+			close();
+			return filename + " was written on an incompatible platform";
+		}
+
+		// Compared by division, so that huge bucket sizes cannot overflow the offset
+		std::size_t offset = sizeof(sample_file_header);
+		for (std::size_t idx = 0; idx < header_.number_of_buckets; ++idx) {
+			if (header_.bucket_sizes[idx] > (size_ - offset) / header_.float_size) {
+				close();
+				return filename + " is truncated";
+			}
+			offsets_[idx] = offset;
+			offset += std::size_t(header_.bucket_sizes[idx]) * header_.float_size;
+		}
+		return {};
+	}
+
+	void close() {
+#if JKJ_SAMPLE_FILE_HAS_MMAP
+		if (data_) {
+			::munmap(const_cast<unsigned char*>(data_), size_);
+		}
+#else
+		buffer_.clear();
+#endif
+		data_ = nullptr;
+		size_ = 0;
+	}
+
+	sample_file_header const& header() const noexcept {
+		return header_;
+	}
+
+	std::size_t number_of_buckets() const noexcept {
+		return data_ ? header_.number_of_buckets : 0;
+	}
+
+	// Float must match header().float_size
+	template <class Float>
+	Float const* bucket_begin(std::size_t idx) const noexcept {
+		static_assert(sizeof(Float) == 4 || sizeof(Float) == 8);
+		assert(sizeof(Float) == header_.float_size);
+		return reinterpret_cast<Float const*>(data_ + offsets_[idx]);
+	}
+	template <class Float>
+	Float const* bucket_end(std::size_t idx) const noexcept {
+		return bucket_begin<Float>(idx) + header_.bucket_sizes[idx];
+	}
+
+private:
+	unsigned char const*	data_ = nullptr;
+	std::size_t				size_ = 0;
+	sample_file_header		header_{};
+	std::size_t				offsets_[sample_file_header::max_number_of_buckets] = {};
+#if !JKJ_SAMPLE_FILE_HAS_MMAP
+	std::vector<char>		buffer_;
+#endif
+};
+
+#endif
\ No newline at end of file
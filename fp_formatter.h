@@ -0,0 +1,140 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_FP_FORMATTER
+#define JKJ_FP_FORMATTER
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Adapters for C++20 std::format and {fmt}.
+// The std::formatter specialization is available if <format> is supported.
+// The fmt::formatter specialization is available if <fmt/format.h> (or <fmt/core.h>)
+// is included before this file.
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include "fp_to_chars.h"
+#include <algorithm>
+#include <type_traits>
+
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
+
+namespace jkj {
+	// Wraps a floating-point number together with the policies to be used for formatting
+	template <class Float,
+		class RoundingMode = grisu_exact_rounding_modes::nearest_to_even,
+		class CorrectRoundingSearch = grisu_exact_correct_rounding::tie_to_even
+	>
+	struct fp_format_t {
+		using float_type = Float;
+		using rounding_mode = RoundingMode;
+		using correct_rounding_search = CorrectRoundingSearch;
+
+		Float value;
+	};
+
+	// Usage: std::format("{}", jkj::fp_format(x, jkj::grisu_exact_rounding_modes::toward_zero{}))
+	template <class Float,
+		class RoundingMode = grisu_exact_rounding_modes::nearest_to_even,
+		class CorrectRoundingSearch = grisu_exact_correct_rounding::tie_to_even
+	>
+	constexpr auto fp_format(Float x,
+		RoundingMode&& = {},
+		CorrectRoundingSearch&& = {}) noexcept
+	{
+		return fp_format_t<Float,
+			std::remove_cv_t<std::remove_reference_t<RoundingMode>>,
+			std::remove_cv_t<std::remove_reference_t<CorrectRoundingSearch>>>{ x };
+	}
+
+	namespace fp_formatter_detail {
+		// The only accepted format specs are "" and "E";
+		// both of them mean the output of fp_to_chars_n, e.g., -3.34E3
+		template <class Iterator, class ErrorHandler>
+		constexpr Iterator parse_format_spec(Iterator first, Iterator last,
+			ErrorHandler&& on_error)
+		{
+			if (first != last && *first == 'E') {
+				++first;
+			}
+			if (first != last && *first != '}') {
+				on_error("jkj::fp_format: invalid format spec");
+			}
+			return first;
+		}
+
+		template <class Float, class RoundingMode, class CorrectRoundingSearch, class OutputIterator>
+		OutputIterator format_to(fp_format_t<Float, RoundingMode, CorrectRoundingSearch> const& x,
+			OutputIterator out)
+		{
+			// Write directly if the output is a contiguous character buffer
+			if constexpr (std::is_same_v<OutputIterator, char*>) {
+				return fp_to_chars_n(x.value, out, RoundingMode{}, CorrectRoundingSearch{});
+			}
+			else {
+				char buffer[fp_to_chars_max_length<Float>];
+				auto const end = fp_to_chars_n(x.value, buffer,
+					RoundingMode{}, CorrectRoundingSearch{});
+				return std::copy(buffer, end, out);
+			}
+		}
+	}
+}
+
+#if defined(__cpp_lib_format)
+template <class Float, class RoundingMode, class CorrectRoundingSearch>
+struct std::formatter<jkj::fp_format_t<Float, RoundingMode, CorrectRoundingSearch>, char>
+{
+	constexpr auto parse(std::format_parse_context& ctx) {
+		return jkj::fp_formatter_detail::parse_format_spec(ctx.begin(), ctx.end(),
+			[](char const* msg) { throw std::format_error(msg); });
+	}
+
+	template <class FormatContext>
+	auto format(jkj::fp_format_t<Float, RoundingMode, CorrectRoundingSearch> const& x,
+		FormatContext& ctx) const
+	{
+		return jkj::fp_formatter_detail::format_to(x, ctx.out());
+	}
+};
+#endif
+
+#if defined(FMT_VERSION)
+template <class Float, class RoundingMode, class CorrectRoundingSearch>
+struct fmt::formatter<jkj::fp_format_t<Float, RoundingMode, CorrectRoundingSearch>, char>
+{
+	constexpr auto parse(fmt::format_parse_context& ctx) {
+		return jkj::fp_formatter_detail::parse_format_spec(ctx.begin(), ctx.end(),
+			[&ctx](char const* msg) { ctx.on_error(msg); });
+	}
+
+	template <class FormatContext>
+	auto format(jkj::fp_format_t<Float, RoundingMode, CorrectRoundingSearch> const& x,
+		FormatContext& ctx) const
+	{
+		return jkj::fp_formatter_detail::format_to(x, ctx.out());
+	}
+};
+#endif
+
+#endif
\ No newline at end of file
@@ -19,17 +19,60 @@
 #define JKJ_FP_TO_CHARS
 
 #include "grisu_exact.h"
+#include <cmath>
+#include <limits>
 
 namespace jkj {
+	// Decimal separator and digit grouping used for the fixed-point notation
+	// Grouping is disabled if grouping_separator is '\0' or grouping_size is 0
+	struct fp_fixed_locale {
+		char			decimal_point = '.';
+		char			grouping_separator = '\0';
+		unsigned char	grouping_size = 3;
+	};
+
 	namespace fp_to_chars_detail {
 		char* float_to_chars(unsigned_fp_t<float> v, char* buffer);
 		char* double_to_chars(unsigned_fp_t<double> v, char* buffer);
+
+		char* float_to_chars_overwrite_tolerant(unsigned_fp_t<float> v, char* buffer);
+		char* double_to_chars_overwrite_tolerant(unsigned_fp_t<double> v, char* buffer);
+
+		char* float_to_chars_fixed(unsigned_fp_t<float> v, char* buffer,
+			fp_fixed_locale const& locale);
+		char* double_to_chars_fixed(unsigned_fp_t<double> v, char* buffer,
+			fp_fixed_locale const& locale);
+
+		template <class Float>
+		char* nonfinite_to_chars(bit_representation_t<Float> br, char* buffer) noexcept
+		{
+			if ((br.f << (grisu_exact_detail::common_info<Float>::exponent_bits + 1)) != 0)
+			{
+				std::memcpy(buffer, "NaN", 3);
+				return buffer + 3;
+			}
+			else {
+				if (br.is_negative()) {
+					*buffer = '-';
+					++buffer;
+				}
+				std::memcpy(buffer, "Infinity", 8);
+				return buffer + 8;
+			}
+		}
 	}
 
+	// Maximum number of characters written by fp_to_chars_n
+	// (e.g., -1.23456789E-38 for float, -1.2345678901234567E-308 for double)
+	template <class Float>
+	constexpr std::size_t fp_to_chars_max_length = sizeof(Float) == 4 ? 15 : 24;
+
 	// Returns the next-to-end position
+	// Parameters other than grisu_exact_default_parameters<Float> can be given after the policies
 	template <class Float,
 		class RoundingMode = grisu_exact_rounding_modes::nearest_to_even,
-		class CorrectRoundingSearch = grisu_exact_correct_rounding::tie_to_even
+		class CorrectRoundingSearch = grisu_exact_correct_rounding::tie_to_even,
+		class Parameters = grisu_exact_default_parameters<Float>
 	>
 	char* fp_to_chars_n(Float x, char* buffer,
 		RoundingMode&& rounding_mode = {},
@@ -43,14 +86,16 @@ namespace jkj {
 			}
 			if (br.is_nonzero()) {
 				if constexpr (sizeof(Float) == 4) {
-					return fp_to_chars_detail::float_to_chars(grisu_exact<false>(x,
-						std::forward<RoundingMode>(rounding_mode),
-						std::forward<CorrectRoundingSearch>(crs)), buffer);
+					return fp_to_chars_detail::float_to_chars(
+						grisu_exact_with_parameters<Parameters, false>(x,
+							std::forward<RoundingMode>(rounding_mode),
+							std::forward<CorrectRoundingSearch>(crs)), buffer);
 				}
 				else {
-					return fp_to_chars_detail::double_to_chars(grisu_exact<false>(x,
-						std::forward<RoundingMode>(rounding_mode),
-						std::forward<CorrectRoundingSearch>(crs)), buffer);
+					return fp_to_chars_detail::double_to_chars(
+						grisu_exact_with_parameters<Parameters, false>(x,
+							std::forward<RoundingMode>(rounding_mode),
+							std::forward<CorrectRoundingSearch>(crs)), buffer);
 				}
 			}
 			else {
@@ -59,32 +104,210 @@ namespace jkj {
 			}
 		}
 		else {
-			if ((br.f << (grisu_exact_detail::common_info<Float>::exponent_bits + 1)) != 0)
-			{
-				std::memcpy(buffer, "NaN", 3);
-				return buffer + 3;
+			return fp_to_chars_detail::nonfinite_to_chars(br, buffer);
+		}
+	}
+
+	// Null-terminate and bypass the return value of fp_to_chars_n
+	template <class Float,
+		class RoundingMode = grisu_exact_rounding_modes::nearest_to_even,
+		class CorrectRoundingSearch = grisu_exact_correct_rounding::tie_to_even,
+		class Parameters = grisu_exact_default_parameters<Float>
+	>
+	char* fp_to_chars(Float x, char* buffer,
+		RoundingMode&& rounding_mode = {},
+		CorrectRoundingSearch&& crs = {})
+	{
+		auto ptr = fp_to_chars_n<Float, RoundingMode, CorrectRoundingSearch, Parameters>(x, buffer,
+			std::forward<RoundingMode>(rounding_mode),
+			std::forward<CorrectRoundingSearch>(crs));
+		*ptr = '\0';
+		return ptr;
+	}
+
+	// If x is exactly representable as a float, print the shortest representation of
+	// that float, which is often much shorter (e.g., 1E-1 instead of 1.0000000149011612E-1
+	// for 0.1f widened to double); otherwise, print the same as fp_to_chars_n
+	// The output still round-trips through float, but not necessarily through double
+	template <class RoundingMode = grisu_exact_rounding_modes::nearest_to_even,
+		class CorrectRoundingSearch = grisu_exact_correct_rounding::tie_to_even
+	>
+	char* fp_to_chars_n_narrowest(double x, char* buffer,
+		RoundingMode&& rounding_mode = {},
+		CorrectRoundingSearch&& crs = {})
+	{
+		// Converting a finite double outside the range of float is undefined, so x is narrowed
+		// only if it is in the range or is infinite; NaN's fail both tests, and they are
+		// printed by the double path
+		if (std::fabs(x) <= double(std::numeric_limits<float>::max()) || std::isinf(x)) {
+			auto const narrowed = float(x);
+			if (double(narrowed) == x) {
+				return fp_to_chars_n(narrowed, buffer,
+					std::forward<RoundingMode>(rounding_mode),
+					std::forward<CorrectRoundingSearch>(crs));
+			}
+		}
+		return fp_to_chars_n(x, buffer,
+			std::forward<RoundingMode>(rounding_mode),
+			std::forward<CorrectRoundingSearch>(crs));
+	}
+
+	// Null-terminate and bypass the return value of fp_to_chars_n_narrowest
+	template <class RoundingMode = grisu_exact_rounding_modes::nearest_to_even,
+		class CorrectRoundingSearch = grisu_exact_correct_rounding::tie_to_even
+	>
+	char* fp_to_chars_narrowest(double x, char* buffer,
+		RoundingMode&& rounding_mode = {},
+		CorrectRoundingSearch&& crs = {})
+	{
+		auto ptr = fp_to_chars_n_narrowest(x, buffer,
+			std::forward<RoundingMode>(rounding_mode),
+			std::forward<CorrectRoundingSearch>(crs));
+		*ptr = '\0';
+		return ptr;
+	}
+
+	// Same as fp_to_chars_n, but assumes that at least slack characters starting from buffer
+	// are writable, and may write garbage past the returned position (but within the slack)
+	// This allows the exponent and the decimal point to be printed with fewer branches
+	template <std::size_t slack, class Float,
+		class RoundingMode = grisu_exact_rounding_modes::nearest_to_even,
+		class CorrectRoundingSearch = grisu_exact_correct_rounding::tie_to_even
+	>
+	char* fp_to_chars_n_unsafe_slack(Float x, char* buffer,
+		RoundingMode&& rounding_mode = {},
+		CorrectRoundingSearch&& crs = {})
+	{
+		static_assert(slack >= fp_to_chars_max_length<Float> + 1,
+			"jkj::fp_to_chars_n_unsafe_slack: slack is too small");
+
+		auto br = get_bit_representation(x);
+		if (br.is_finite()) {
+			*buffer = '-';
+			buffer += br.is_negative() ? 1 : 0;
+			if (br.is_nonzero()) {
+				if constexpr (sizeof(Float) == 4) {
+					return fp_to_chars_detail::float_to_chars_overwrite_tolerant(
+						grisu_exact<false>(x,
+							std::forward<RoundingMode>(rounding_mode),
+							std::forward<CorrectRoundingSearch>(crs)), buffer);
+				}
+				else {
+					return fp_to_chars_detail::double_to_chars_overwrite_tolerant(
+						grisu_exact<false>(x,
+							std::forward<RoundingMode>(rounding_mode),
+							std::forward<CorrectRoundingSearch>(crs)), buffer);
+				}
 			}
 			else {
-				if (br.is_negative()) {
-					*buffer = '-';
-					++buffer;
+				std::memcpy(buffer, "0E0", 3);
+				return buffer + 3;
+			}
+		}
+		else {
+			return fp_to_chars_detail::nonfinite_to_chars(br, buffer);
+		}
+	}
+
+	// Size of each slot used by fp_to_chars_slot by default
+	template <class Float>
+	constexpr std::size_t fp_to_chars_default_slot_size = sizeof(Float) == 4 ? 16 : 24;
+
+	// Fill exactly slot_size characters starting from slot, so that the i-th value of a
+	// table is always found at the offset i * slot_size
+	// The output of fp_to_chars_n is left-aligned and the rest is filled with padding
+	// Returns the position of the next slot
+	template <std::size_t slot_size, class Float,
+		class RoundingMode = grisu_exact_rounding_modes::nearest_to_even,
+		class CorrectRoundingSearch = grisu_exact_correct_rounding::tie_to_even
+	>
+	char* fp_to_chars_slot(Float x, char* slot, char padding = ' ',
+		RoundingMode&& rounding_mode = {},
+		CorrectRoundingSearch&& crs = {})
+	{
+		static_assert(slot_size >= fp_to_chars_max_length<Float>,
+			"jkj::fp_to_chars_slot: slot_size is too small");
+
+		// The size is a compile-time constant, so this is done with a few wide stores
+		std::memset(slot, padding, slot_size);
+		fp_to_chars_n(x, slot,
+			std::forward<RoundingMode>(rounding_mode),
+			std::forward<CorrectRoundingSearch>(crs));
+		return slot + slot_size;
+	}
+
+	// Apply fp_to_chars_slot to each of [first, last)
+	// Returns the position next to the last slot
+	template <std::size_t slot_size, class Float,
+		class RoundingMode = grisu_exact_rounding_modes::nearest_to_even,
+		class CorrectRoundingSearch = grisu_exact_correct_rounding::tie_to_even
+	>
+	char* fp_to_chars_slots(Float const* first, Float const* last, char* slots, char padding = ' ',
+		RoundingMode&& rounding_mode = {},
+		CorrectRoundingSearch&& crs = {})
+	{
+		for (; first != last; ++first) {
+			slots = fp_to_chars_slot<slot_size>(*first, slots, padding, rounding_mode, crs);
+		}
+		return slots;
+	}
+
+	// Maximum number of characters written by fp_to_chars_fixed_n
+	// (attained by the largest finite number when grouping_size is 1)
+	template <class Float>
+	constexpr std::size_t fp_to_chars_fixed_max_length =
+		2 * std::size_t(std::numeric_limits<Float>::max_exponent10 + 1);
+
+	// Print in the fixed-point notation, e.g., -3340 or 0.00334 or 1,234.5
+	// Returns the next-to-end position
+	template <class Float,
+		class RoundingMode = grisu_exact_rounding_modes::nearest_to_even,
+		class CorrectRoundingSearch = grisu_exact_correct_rounding::tie_to_even
+	>
+	char* fp_to_chars_fixed_n(Float x, char* buffer,
+		fp_fixed_locale const& locale = {},
+		RoundingMode&& rounding_mode = {},
+		CorrectRoundingSearch&& crs = {})
+	{
+		auto br = get_bit_representation(x);
+		if (br.is_finite()) {
+			if (br.is_negative()) {
+				*buffer = '-';
+				++buffer;
+			}
+			if (br.is_nonzero()) {
+				if constexpr (sizeof(Float) == 4) {
+					return fp_to_chars_detail::float_to_chars_fixed(grisu_exact<false>(x,
+						std::forward<RoundingMode>(rounding_mode),
+						std::forward<CorrectRoundingSearch>(crs)), buffer, locale);
 				}
-				std::memcpy(buffer, "Infinity", 8);
-				return buffer + 8;
+				else {
+					return fp_to_chars_detail::double_to_chars_fixed(grisu_exact<false>(x,
+						std::forward<RoundingMode>(rounding_mode),
+						std::forward<CorrectRoundingSearch>(crs)), buffer, locale);
+				}
+			}
+			else {
+				*buffer = '0';
+				return buffer + 1;
 			}
 		}
+		else {
+			return fp_to_chars_detail::nonfinite_to_chars(br, buffer);
+		}
 	}
 
-	// Null-terminate and bypass the return value of fp_to_chars_n
+	// Null-terminate and bypass the return value of fp_to_chars_fixed_n
 	template <class Float,
 		class RoundingMode = grisu_exact_rounding_modes::nearest_to_even,
 		class CorrectRoundingSearch = grisu_exact_correct_rounding::tie_to_even
 	>
-	char* fp_to_chars(Float x, char* buffer,
+	char* fp_to_chars_fixed(Float x, char* buffer,
+		fp_fixed_locale const& locale = {},
 		RoundingMode&& rounding_mode = {},
 		CorrectRoundingSearch&& crs = {})
 	{
-		auto ptr = fp_to_chars_n(x, buffer,
+		auto ptr = fp_to_chars_fixed_n(x, buffer, locale,
 			std::forward<RoundingMode>(rounding_mode),
 			std::forward<CorrectRoundingSearch>(crs));
 		*ptr = '\0';
@@ -33,6 +33,8 @@
 //    single template function fp_to_chars_impl
 //  - Removed index counting statements; replaced them with pointer increments
 //  - Removed usages of DIGIT_TABLE; replaced them with radix_100_table
+//  - Moved the digit generation loop of fp_to_chars_impl into print_digits,
+//    which is shared with fp_to_chars_fixed_impl for the fixed-point notation
 //
 //  These modifications, together with other contents of this file may be used
 //  under the same terms as the original contents.
@@ -109,13 +111,16 @@ namespace jkj {
 			}
 		}
 
-		template <class Float>
-		static char* fp_to_chars_impl(unsigned_fp_t<Float> v, char* buffer)
+		// Print olength decimal digits of output into buffer.
+		// If leave_gap_after_first_digit is true, buffer[1] is skipped so that
+		// the decimal point can be put there, and the digits end at buffer[olength];
+		// otherwise, the digits are buffer[0] ~ buffer[olength - 1].
+		template <bool leave_gap_after_first_digit, class UInt>
+		static void print_digits(UInt output, std::uint32_t const olength, char* buffer)
 		{
-			auto output = v.significand;
-			auto const olength = decimal_length(output);
+			// Position right past the last digit
+			char* const last = buffer + olength + (leave_gap_after_first_digit ? 1 : 0);
 
-			// Print the decimal digits.
 			// The following code is equivalent to:
 			// for (uint32_t i = 0; i < olength - 1; ++i) {
 			//   const uint32_t c = output % 10; output /= 10;
@@ -124,11 +129,11 @@ namespace jkj {
 			// result[index] = '0' + output % 10;
 
 			uint32_t i = 0;
-			if constexpr (sizeof(Float) == 8) {
+			if constexpr (sizeof(UInt) == 8) {
 				// We prefer 32-bit operations, even on 64-bit platforms.
-			// We have at most 17 digits, and uint32_t can store 9 digits.
-			// If output doesn't fit into uint32_t, we cut off 8 digits,
-			// so the rest will fit into uint32_t.
+				// We have at most 17 digits, and uint32_t can store 9 digits.
+				// If output doesn't fit into uint32_t, we cut off 8 digits,
+				// so the rest will fit into uint32_t.
 				if ((output >> 32) != 0) {
 					// Expensive 64-bit division.
 					const uint64_t q = output / 100000000;
@@ -142,10 +147,10 @@ namespace jkj {
 					const uint32_t c1 = (c / 100) << 1;
 					const uint32_t d0 = (d % 100) << 1;
 					const uint32_t d1 = (d / 100) << 1;
-					memcpy(buffer + olength - i - 1, radix_100_table + c0, 2);
-					memcpy(buffer + olength - i - 3, radix_100_table + c1, 2);
-					memcpy(buffer + olength - i - 5, radix_100_table + d0, 2);
-					memcpy(buffer + olength - i - 7, radix_100_table + d1, 2);
+					memcpy(last - i - 2, radix_100_table + c0, 2);
+					memcpy(last - i - 4, radix_100_table + c1, 2);
+					memcpy(last - i - 6, radix_100_table + d0, 2);
+					memcpy(last - i - 8, radix_100_table + d1, 2);
 					i += 8;
 				}
 			}
@@ -160,39 +165,82 @@ namespace jkj {
 				output2 /= 10000;
 				const uint32_t c0 = (c % 100) << 1;
 				const uint32_t c1 = (c / 100) << 1;
-				memcpy(buffer + olength - i - 1, radix_100_table + c0, 2);
-				memcpy(buffer + olength - i - 3, radix_100_table + c1, 2);
+				memcpy(last - i - 2, radix_100_table + c0, 2);
+				memcpy(last - i - 4, radix_100_table + c1, 2);
 				i += 4;
 			}
 			if (output2 >= 100) {
 				const uint32_t c = (output2 % 100) << 1;
 				output2 /= 100;
-				memcpy(buffer + olength - i - 1, radix_100_table + c, 2);
+				memcpy(last - i - 2, radix_100_table + c, 2);
 				i += 2;
 			}
 			if (output2 >= 10) {
 				const uint32_t c = output2 << 1;
-				// We can't use memcpy here: the decimal dot goes between these two digits.
-				buffer[olength - i] = radix_100_table[c + 1];
-				buffer[0] = radix_100_table[c];
+				if constexpr (leave_gap_after_first_digit) {
+					// We can't use memcpy here: the decimal dot goes between these two digits.
+					buffer[2] = radix_100_table[c + 1];
+					buffer[0] = radix_100_table[c];
+				}
+				else {
+					memcpy(buffer, radix_100_table + c, 2);
+				}
 			}
 			else {
 				buffer[0] = (char)('0' + output2);
 			}
+		}
+
+		// If overwrite_tolerant is true, this function may write garbage
+		// up to 1 character past the returned position, in exchange for fewer branches
+		template <class Float, bool overwrite_tolerant = false>
+		static char* fp_to_chars_impl(unsigned_fp_t<Float> v, char* buffer)
+		{
+			auto const olength = decimal_length(v.significand);
+
+			// Print the decimal digits.
+			print_digits<true>(v.significand, olength, buffer);
 
 			// Print decimal point if needed.
-			if (olength > 1) {
+			if constexpr (overwrite_tolerant) {
+				// If olength == 1, the decimal point is overwritten by the exponent
 				buffer[1] = '.';
-				buffer += olength + 1;
+				buffer += olength > 1 ? olength + 1 : 1;
 			}
 			else {
-				++buffer;
+				if (olength > 1) {
+					buffer[1] = '.';
+					buffer += olength + 1;
+				}
+				else {
+					++buffer;
+				}
 			}
 
 			// Print the exponent.
+			int32_t exp = v.exponent + (int32_t)olength - 1;
+			if constexpr (overwrite_tolerant) {
+				memcpy(buffer, "E-", 2);
+				buffer += exp < 0 ? 2 : 1;
+				exp = exp < 0 ? -exp : exp;
+
+				if (sizeof(Float) == 4 || exp < 100) {
+					// If exp < 10, the second character is garbage, and it is overwritten
+					// or it is past the returned position
+					memcpy(buffer, radix_100_table + 2 * exp + (exp < 10 ? 1 : 0), 2);
+					buffer += exp < 10 ? 1 : 2;
+				}
+				else {
+					const int32_t c = exp % 10;
+					memcpy(buffer, radix_100_table + 2 * (exp / 10), 2);
+					buffer[2] = (char)('0' + c);
+					buffer += 3;
+				}
+				return buffer;
+			}
+
 			*buffer = 'E';
 			++buffer;
-			int32_t exp = v.exponent + (int32_t)olength - 1;
 			if (exp < 0) {
 				*buffer = '-';
 				++buffer;
@@ -227,12 +275,89 @@ namespace jkj {
 
 			return buffer;
 		}
-		
+
+		template <class Float>
+		static char* fp_to_chars_fixed_impl(unsigned_fp_t<Float> v, char* buffer,
+			fp_fixed_locale const& locale)
+		{
+			auto const olength = decimal_length(v.significand);
+
+			char digits[20];
+			print_digits<false>(v.significand, olength, digits);
+
+			// Number of digits before the decimal point
+			int32_t const integer_length = (int32_t)olength + v.exponent;
+
+			// 0.00ddd
+			if (integer_length <= 0) {
+				buffer[0] = '0';
+				buffer[1] = locale.decimal_point;
+				memset(buffer + 2, '0', (size_t)-integer_length);
+				buffer += 2 - integer_length;
+				memcpy(buffer, digits, olength);
+				return buffer + olength;
+			}
+
+			// Print the integer part.
+			auto const integer_length_in_digits =
+				integer_length < (int32_t)olength ? (uint32_t)integer_length : olength;
+
+			if (locale.grouping_separator == '\0' || locale.grouping_size == 0 ||
+				integer_length <= (int32_t)locale.grouping_size)
+			{
+				memcpy(buffer, digits, integer_length_in_digits);
+				memset(buffer + integer_length_in_digits, '0',
+					(size_t)integer_length - integer_length_in_digits);
+				buffer += integer_length;
+			}
+			else {
+				// Length of the leftmost group
+				auto group_remaining = uint32_t((integer_length - 1) % locale.grouping_size + 1);
+				for (uint32_t i = 0; i < (uint32_t)integer_length; ++i) {
+					if (group_remaining == 0) {
+						*buffer = locale.grouping_separator;
+						++buffer;
+						group_remaining = locale.grouping_size;
+					}
+					*buffer = i < integer_length_in_digits ? digits[i] : '0';
+					++buffer;
+					--group_remaining;
+				}
+			}
+
+			// Print the fractional part.
+			if (v.exponent < 0) {
+				*buffer = locale.decimal_point;
+				memcpy(buffer + 1, digits + integer_length, (size_t)-v.exponent);
+				buffer += 1 - v.exponent;
+			}
+
+			return buffer;
+		}
+
 		char* float_to_chars(unsigned_fp_t<float> v, char* buffer) {
 			return fp_to_chars_impl(v, buffer);
 		}
 		char* double_to_chars(unsigned_fp_t<double> v, char* buffer) {
 			return fp_to_chars_impl(v, buffer);
 		}
+
+		char* float_to_chars_overwrite_tolerant(unsigned_fp_t<float> v, char* buffer) {
+			return fp_to_chars_impl<float, true>(v, buffer);
+		}
+		char* double_to_chars_overwrite_tolerant(unsigned_fp_t<double> v, char* buffer) {
+			return fp_to_chars_impl<double, true>(v, buffer);
+		}
+
+		char* float_to_chars_fixed(unsigned_fp_t<float> v, char* buffer,
+			fp_fixed_locale const& locale)
+		{
+			return fp_to_chars_fixed_impl(v, buffer, locale);
+		}
+		char* double_to_chars_fixed(unsigned_fp_t<double> v, char* buffer,
+			fp_fixed_locale const& locale)
+		{
+			return fp_to_chars_fixed_impl(v, buffer, locale);
+		}
 	}
 }
\ No newline at end of file
@@ -345,11 +345,18 @@ namespace jkj {
 		}
 
 
+	}
+
+	// The parameters of Grisu-Exact; see the definition below
+	template <class Float>
+	struct grisu_exact_default_parameters;
+
+	namespace grisu_exact_detail {
 		////////////////////////////////////////////////////////////////////////////////////////
 		// Collection of relevent information about IEEE-754 and precision settings
 		////////////////////////////////////////////////////////////////////////////////////////
 
-		template <class Float>
+		template <class Float, class Parameters = grisu_exact_default_parameters<Float>>
 		struct common_info {
 			using float_type = Float;
 
@@ -390,9 +397,11 @@ namespace jkj {
 			static_assert(min_exponent < 0 && max_exponent > 0 && -min_exponent >= max_exponent);
 			static_assert(min_exponent == 1 + exponent_bias - int(extended_precision) + 1);
 
-			static constexpr int alpha = sizeof(Float) == 4 ? -5 : -5;
-			static constexpr int gamma = alpha + 3;
+			static constexpr int alpha = Parameters::alpha;
+			static constexpr int gamma = Parameters::gamma;
 			static_assert(alpha >= -(int(extended_precision - precision) - 4) && gamma <= 0);
+			// Ensure beta can be chosen in [alpha, gamma] for every exponent
+			static_assert(gamma >= alpha + 3);
 
 			static constexpr int min_kappa =
 				-floor_log10_pow2(-(int(extended_precision - precision) - 3 + alpha)) - 1;
@@ -400,8 +409,10 @@ namespace jkj {
 				-floor_log10_pow2(-(int(extended_precision) + gamma)) - 1;
 			static_assert(0 <= min_kappa && min_kappa <= max_kappa);
 
-			static constexpr int initial_kappa = sizeof(Float) == 4 ? 2 : 3;
+			static constexpr int initial_kappa = Parameters::initial_kappa;
 			static_assert(min_kappa <= initial_kappa && initial_kappa <= max_kappa);
+			// The decreasing search is performed only once, and goes down to min_kappa
+			static_assert(initial_kappa == min_kappa + 2);
 
 			// Ensure delta cannot overflow
 			// delta is upper bounded by 2^(q-p-1+gamma), and
@@ -459,8 +470,9 @@ namespace jkj {
 
 
 		////////////////////////////////////////////////////////////////////////////////////////
-		// Computed cache entries
+		// Computed cache entries for the default parameters
 		// !! You SHOULD regenerate the cache if you modify alpha and gamma !!
+		// (tests/verify_main.cpp with --generate-cache)
 		////////////////////////////////////////////////////////////////////////////////////////
 
 		template <class Float>
@@ -1171,17 +1183,53 @@ namespace jkj {
 			};
 		};
 
-		template <class Float>
-		constexpr typename common_info<Float>::cache_entry_type const& get_cache(int k) noexcept {
-			assert(k >= common_info<Float>::min_k && k <= common_info<Float>::max_k);
-			return cache_holder<Float>::cache[std::size_t(k - common_info<Float>::min_k)];
+		template <class Float, class Parameters = grisu_exact_default_parameters<Float>>
+		constexpr typename common_info<Float, Parameters>::cache_entry_type const& get_cache(int k) noexcept {
+			using info = common_info<Float, Parameters>;
+
+			// The cache should have an entry for each k in [min_k, max_k]
+			static_assert(sizeof(Parameters::cache) / sizeof(Parameters::cache[0]) ==
+				std::size_t(info::max_k - info::min_k + 1));
+
+			assert(k >= info::min_k && k <= info::max_k);
+			return Parameters::cache[std::size_t(k - info::min_k)];
 		}
 
 		// Forward declaration of the main class
-		template <class Float>
+		template <class Float, class Parameters = grisu_exact_default_parameters<Float>>
 		struct grisu_exact_impl;
 	}
 
+	////////////////////////////////////////////////////////////////////////////////////////
+	// Parameters of Grisu-Exact
+	////////////////////////////////////////////////////////////////////////////////////////
+
+	// Grisu-Exact multiplies the significand by a cached power of 10 so that the binary exponent
+	// beta of the product lies in [alpha, gamma]; this determines the range of k (hence the cache)
+	// and the range [min_kappa, max_kappa] of the decimal exponent kappa of the first estimate.
+	// The search for kappa starts from initial_kappa.
+	// Other parameters can be given as a struct with the same members, e.g.,
+	// grisu_exact_with_parameters<my_parameters, false>(x). Its cache should be generated and
+	// every verification should pass for it (see tests/verify_main.cpp and
+	// parameters/alternative_parameters.h).
+	template <class Float>
+	struct grisu_exact_default_parameters {
+		static constexpr int alpha = -5;
+		static constexpr int gamma = alpha + 3;
+		static constexpr int initial_kappa = sizeof(Float) == 4 ? 2 : 3;
+		// For k in [min_k, max_k]
+		static constexpr auto const& cache = grisu_exact_detail::cache_holder<Float>::cache;
+
+		// Facts that depend on the above, found by the verifications
+		// The maximum of n' in the correct rounding search (--correct-rounding-bound); 4 or 5
+		static constexpr int max_n_prime = sizeof(Float) == 4 ? 4 : 5;
+		// Whether the correct rounding search should stop for the power of 2 with the exponent,
+		// when 10^kappa coincides with delta (--incorrect-rounding-removal)
+		static constexpr bool skip_incorrect_rounding_removal(int exponent) noexcept {
+			return exponent == (sizeof(Float) == 4 ? 59 : -203);
+		}
+	};
+
 	////////////////////////////////////////////////////////////////////////////////////////
 	// DIY floating-point data type
 	////////////////////////////////////////////////////////////////////////////////////////
@@ -1356,11 +1404,11 @@ namespace jkj {
 		// Do not perform correct rounding search
 		struct do_not_care {
 			static constexpr tag_t tag = do_not_care_tag;
-			template <bool return_sign, class Float, class IntervalTypeProvider>
+			template <bool return_sign, class Parameters, class Float, class IntervalTypeProvider>
 			fp_t<Float, return_sign> delegate(bit_representation_t<Float> br,
 				IntervalTypeProvider&&) const
 			{
-				return grisu_exact_detail::grisu_exact_impl<Float>::template compute<return_sign,
+				return grisu_exact_detail::grisu_exact_impl<Float, Parameters>::template compute<return_sign,
 					std::remove_cv_t<std::remove_reference_t<IntervalTypeProvider>>, do_not_care>(br);
 			}
 		};
@@ -1368,11 +1416,11 @@ namespace jkj {
 		// Perform correct rounding search; tie-to-even
 		struct tie_to_even {
 			static constexpr tag_t tag = tie_to_even_tag;
-			template <bool return_sign, class Float, class IntervalTypeProvider>
+			template <bool return_sign, class Parameters, class Float, class IntervalTypeProvider>
 			fp_t<Float, return_sign> delegate(bit_representation_t<Float> br,
 				IntervalTypeProvider&&) const
 			{
-				return grisu_exact_detail::grisu_exact_impl<Float>::template compute<return_sign,
+				return grisu_exact_detail::grisu_exact_impl<Float, Parameters>::template compute<return_sign,
 					std::remove_cv_t<std::remove_reference_t<IntervalTypeProvider>>, tie_to_even>(br);
 			}
 		};
@@ -1380,11 +1428,11 @@ namespace jkj {
 		// Perform correct rounding search; tie-to-odd
 		struct tie_to_odd {
 			static constexpr tag_t tag = tie_to_odd_tag;
-			template <bool return_sign, class Float, class IntervalTypeProvider>
+			template <bool return_sign, class Parameters, class Float, class IntervalTypeProvider>
 			fp_t<Float, return_sign> delegate(bit_representation_t<Float> br,
 				IntervalTypeProvider&&) const
 			{
-				return grisu_exact_detail::grisu_exact_impl<Float>::template compute<return_sign,
+				return grisu_exact_detail::grisu_exact_impl<Float, Parameters>::template compute<return_sign,
 					std::remove_cv_t<std::remove_reference_t<IntervalTypeProvider>>, tie_to_odd>(br);
 			}
 		};
@@ -1392,11 +1440,11 @@ namespace jkj {
 		// Perform correct rounding search; tie-to-up
 		struct tie_to_up {
 			static constexpr tag_t tag = tie_to_up_tag;
-			template <bool return_sign, class Float, class IntervalTypeProvider>
+			template <bool return_sign, class Parameters, class Float, class IntervalTypeProvider>
 			fp_t<Float, return_sign> delegate(bit_representation_t<Float> br,
 				IntervalTypeProvider&&) const
 			{
-				return grisu_exact_detail::grisu_exact_impl<Float>::template compute<return_sign,
+				return grisu_exact_detail::grisu_exact_impl<Float, Parameters>::template compute<return_sign,
 					std::remove_cv_t<std::remove_reference_t<IntervalTypeProvider>>, tie_to_up>(br);
 			}
 		};
@@ -1404,11 +1452,11 @@ namespace jkj {
 		// Perform correct rounding search; tie-to-down
 		struct tie_to_down {
 			static constexpr tag_t tag = tie_to_down_tag;
-			template <bool return_sign, class Float, class IntervalTypeProvider>
+			template <bool return_sign, class Parameters, class Float, class IntervalTypeProvider>
 			fp_t<Float, return_sign> delegate(bit_representation_t<Float> br,
 				IntervalTypeProvider&&) const
 			{
-				return grisu_exact_detail::grisu_exact_impl<Float>::template compute<return_sign,
+				return grisu_exact_detail::grisu_exact_impl<Float, Parameters>::template compute<return_sign,
 					std::remove_cv_t<std::remove_reference_t<IntervalTypeProvider>>, tie_to_down>(br);
 			}
 		};
@@ -1484,11 +1532,11 @@ namespace jkj {
 		struct nearest_to_even {
 			static constexpr tag_t tag = to_nearest_tag;
 
-			template <bool return_sign, class Float, class CorrectRoundingSearch>
+			template <bool return_sign, class Parameters, class Float, class CorrectRoundingSearch>
 			fp_t<Float, return_sign> delegate(bit_representation_t<Float> br,
 				CorrectRoundingSearch&& crs) const
 			{
-				return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign>(
+				return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign, Parameters>(
 					br, *this);
 			}
 			template <class Float>
@@ -1499,11 +1547,11 @@ namespace jkj {
 		struct nearest_to_odd {
 			static constexpr tag_t tag = to_nearest_tag;
 
-			template <bool return_sign, class Float, class CorrectRoundingSearch>
+			template <bool return_sign, class Parameters, class Float, class CorrectRoundingSearch>
 			fp_t<Float, return_sign> delegate(bit_representation_t<Float> br,
 				CorrectRoundingSearch&& crs) const
 			{
-				return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign>(
+				return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign, Parameters>(
 					br, *this);
 			}
 			template <class Float>
@@ -1514,11 +1562,11 @@ namespace jkj {
 		struct nearest_toward_plus_infinity {
 			static constexpr tag_t tag = to_nearest_tag;
 
-			template <bool return_sign, class Float, class CorrectRoundingSearch>
+			template <bool return_sign, class Parameters, class Float, class CorrectRoundingSearch>
 			fp_t<Float, return_sign> delegate(bit_representation_t<Float> br,
 				CorrectRoundingSearch&& crs) const
 			{
-				return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign>(
+				return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign, Parameters>(
 					br, *this);
 			}
 			template <class Float>
@@ -1529,11 +1577,11 @@ namespace jkj {
 		struct nearest_toward_minus_infinity {
 			static constexpr tag_t tag = to_nearest_tag;
 
-			template <bool return_sign, class Float, class CorrectRoundingSearch>
+			template <bool return_sign, class Parameters, class Float, class CorrectRoundingSearch>
 			fp_t<Float, return_sign> delegate(bit_representation_t<Float> br,
 				CorrectRoundingSearch&& crs) const
 			{
-				return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign>(
+				return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign, Parameters>(
 					br, *this);
 			}
 			template <class Float>
@@ -1545,11 +1593,11 @@ namespace jkj {
 		struct nearest_toward_zero {
 			static constexpr tag_t tag = to_nearest_tag;
 
-			template <bool return_sign, class Float, class CorrectRoundingSearch>
+			template <bool return_sign, class Parameters, class Float, class CorrectRoundingSearch>
 			fp_t<Float, return_sign> delegate(bit_representation_t<Float> br,
 				CorrectRoundingSearch&& crs) const
 			{
-				return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign>(
+				return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign, Parameters>(
 					br, *this);
 			}
 			template <class Float>
@@ -1560,11 +1608,11 @@ namespace jkj {
 		struct nearest_away_from_zero {
 			static constexpr tag_t tag = to_nearest_tag;
 
-			template <bool return_sign, class Float, class CorrectRoundingSearch>
+			template <bool return_sign, class Parameters, class Float, class CorrectRoundingSearch>
 			fp_t<Float, return_sign> delegate(bit_representation_t<Float> br,
 				CorrectRoundingSearch&& crs) const
 			{
-				return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign>(
+				return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign, Parameters>(
 					br, *this);
 			}
 			template <class Float>
@@ -1595,16 +1643,16 @@ namespace jkj {
 		// Same as nearest_to_even, but generate separate codes for
 		// different boundary conditions; may produce faster (or slower) code, but bigger binary
 		struct nearest_to_even_static_boundary {
-			template <bool return_sign, class Float, class CorrectRoundingSearch>
+			template <bool return_sign, class Parameters, class Float, class CorrectRoundingSearch>
 			fp_t<Float, return_sign> delegate(bit_representation_t<Float> br,
 				CorrectRoundingSearch&& crs) const
 			{
 				if (br.f % 2 == 0) {
-					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign>(
+					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign, Parameters>(
 						br, detail::nearest_always_closed{});
 				}
 				else {
-					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign>(
+					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign, Parameters>(
 						br, detail::nearest_always_open{});
 				}
 			}
@@ -1612,16 +1660,16 @@ namespace jkj {
 		// Same as nearest_to_odd, but generate separate codes for
 		// different boundary conditions; may produce faster (or slower) code, but bigger binary
 		struct nearest_to_odd_static_boundary {
-			template <bool return_sign, class Float, class CorrectRoundingSearch>
+			template <bool return_sign, class Parameters, class Float, class CorrectRoundingSearch>
 			fp_t<Float, return_sign> delegate(bit_representation_t<Float> br,
 				CorrectRoundingSearch&& crs) const
 			{
 				if (br.f % 2 == 0) {
-					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign>(
+					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign, Parameters>(
 						br, detail::nearest_always_open{});
 				}
 				else {
-					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign>(
+					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign, Parameters>(
 						br, detail::nearest_always_closed{});
 				}
 			}
@@ -1629,16 +1677,16 @@ namespace jkj {
 		// Same as nearest_toward_plus_infinity, but generate separate codes for
 		// different boundary conditions; may produce faster (or slower) code, but bigger binary
 		struct nearest_toward_plus_infinity_static_boundary {
-			template <bool return_sign, class Float, class CorrectRoundingSearch>
+			template <bool return_sign, class Parameters, class Float, class CorrectRoundingSearch>
 			fp_t<Float, return_sign> delegate(bit_representation_t<Float> br,
 				CorrectRoundingSearch&& crs) const
 			{
 				if (br.is_negative()) {
-					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign>(
+					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign, Parameters>(
 						br, nearest_toward_zero{});
 				}
 				else {
-					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign>(
+					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign, Parameters>(
 						br, nearest_away_from_zero{});
 				}
 			}
@@ -1646,16 +1694,16 @@ namespace jkj {
 		// Same as nearest_toward_minus_infinity, but generate separate codes for
 		// different boundary conditions; may produce faster (or slower) code, but bigger binary
 		struct nearest_toward_minus_infinity_static_boundary {
-			template <bool return_sign, class Float, class CorrectRoundingSearch>
+			template <bool return_sign, class Parameters, class Float, class CorrectRoundingSearch>
 			fp_t<Float, return_sign> delegate(bit_representation_t<Float> br,
 				CorrectRoundingSearch&& crs) const
 			{
 				if (br.is_negative()) {
-					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign>(
+					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign, Parameters>(
 						br, nearest_away_from_zero{});
 				}
 				else {
-					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign>(
+					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign, Parameters>(
 						br, nearest_toward_zero{});
 				}
 			}
@@ -1681,51 +1729,51 @@ namespace jkj {
 		}
 
 		struct toward_plus_infinity {
-			template <bool return_sign, class Float, class CorrectRoundingSearch>
+			template <bool return_sign, class Parameters, class Float, class CorrectRoundingSearch>
 			fp_t<Float, return_sign> delegate(bit_representation_t<Float> br,
 				CorrectRoundingSearch&& crs) const
 			{
 				if (br.is_negative()) {
-					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign>(
+					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign, Parameters>(
 						br, detail::left_closed_directed{});
 					
 				}
 				else {
-					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign>(
+					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign, Parameters>(
 						br, detail::right_closed_directed{});
 				}
 			}
 		};
 		struct toward_minus_infinity {
-			template <bool return_sign, class Float, class CorrectRoundingSearch>
+			template <bool return_sign, class Parameters, class Float, class CorrectRoundingSearch>
 			fp_t<Float, return_sign> delegate(bit_representation_t<Float> br,
 				CorrectRoundingSearch&& crs) const
 			{
 				if (br.is_negative()) {
-					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign>(
+					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign, Parameters>(
 						br, detail::right_closed_directed{});
 				}
 				else {
-					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign>(
+					return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign, Parameters>(
 						br, detail::left_closed_directed{});
 				}
 			}
 		};
 		struct toward_zero {
-			template <bool return_sign, class Float, class CorrectRoundingSearch>
+			template <bool return_sign, class Parameters, class Float, class CorrectRoundingSearch>
 			fp_t<Float, return_sign> delegate(bit_representation_t<Float> br,
 				CorrectRoundingSearch&& crs) const
 			{
-				return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign>(
+				return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign, Parameters>(
 					br, detail::left_closed_directed{});
 			}
 		};
 		struct away_from_zero {
-			template <bool return_sign, class Float, class CorrectRoundingSearch>
+			template <bool return_sign, class Parameters, class Float, class CorrectRoundingSearch>
 			fp_t<Float, return_sign> delegate(bit_representation_t<Float> br,
 				CorrectRoundingSearch&& crs) const
 			{
-				return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign>(
+				return std::forward<CorrectRoundingSearch>(crs).template delegate<return_sign, Parameters>(
 					br, detail::right_closed_directed{});
 			}
 		};
@@ -1738,38 +1786,38 @@ namespace jkj {
 
 		// Get sign/decimal significand/decimal exponent from
 		// the bit representation of a floating-point number
-		template <class Float>
-		struct grisu_exact_impl : private common_info<Float>
+		template <class Float, class Parameters>
+		struct grisu_exact_impl : private common_info<Float, Parameters>
 		{
 			using extended_significand_type =
-				typename common_info<Float>::extended_significand_type;
+				typename common_info<Float, Parameters>::extended_significand_type;
 			using cache_entry_type =
-				typename common_info<Float>::cache_entry_type;
-
-			using common_info<Float>::precision;
-			using common_info<Float>::extended_precision;
-			using common_info<Float>::cache_precision;
-			using common_info<Float>::sign_bit_mask;
-			using common_info<Float>::exponent_bits;
-			using common_info<Float>::exponent_bias;
-			using common_info<Float>::exponent_bits_mask;
-			using common_info<Float>::min_exponent;
-			using common_info<Float>::boundary_bit;
-			using common_info<Float>::normal_interval_length;
-			using common_info<Float>::edge_case_boundary_bit;
-			using common_info<Float>::alpha;
-			using common_info<Float>::gamma;
-			using common_info<Float>::min_kappa;
-			using common_info<Float>::max_kappa;
-			using common_info<Float>::initial_kappa;
-			using common_info<Float>::integer_check_exponent_lower_bound_for_q_mp_m3;
-			using common_info<Float>::integer_check_exponent_lower_bound_for_q_mp_m2;
-			using common_info<Float>::integer_check_exponent_lower_bound_for_q_mp_m1;
-			using common_info<Float>::integer_check_exponent_lower_bound_for_q_mp;
-			using common_info<Float>::max_exponent_for_k_geq_0;
-			using common_info<Float>::max_exponent_for_k_geq_m1;
-			using common_info<Float>::integer_check_exponent_upper_bound_for_p_p2;
-			using common_info<Float>::integer_check_exponent_upper_bound_for_p_p1;
+				typename common_info<Float, Parameters>::cache_entry_type;
+
+			using common_info<Float, Parameters>::precision;
+			using common_info<Float, Parameters>::extended_precision;
+			using common_info<Float, Parameters>::cache_precision;
+			using common_info<Float, Parameters>::sign_bit_mask;
+			using common_info<Float, Parameters>::exponent_bits;
+			using common_info<Float, Parameters>::exponent_bias;
+			using common_info<Float, Parameters>::exponent_bits_mask;
+			using common_info<Float, Parameters>::min_exponent;
+			using common_info<Float, Parameters>::boundary_bit;
+			using common_info<Float, Parameters>::normal_interval_length;
+			using common_info<Float, Parameters>::edge_case_boundary_bit;
+			using common_info<Float, Parameters>::alpha;
+			using common_info<Float, Parameters>::gamma;
+			using common_info<Float, Parameters>::min_kappa;
+			using common_info<Float, Parameters>::max_kappa;
+			using common_info<Float, Parameters>::initial_kappa;
+			using common_info<Float, Parameters>::integer_check_exponent_lower_bound_for_q_mp_m3;
+			using common_info<Float, Parameters>::integer_check_exponent_lower_bound_for_q_mp_m2;
+			using common_info<Float, Parameters>::integer_check_exponent_lower_bound_for_q_mp_m1;
+			using common_info<Float, Parameters>::integer_check_exponent_lower_bound_for_q_mp;
+			using common_info<Float, Parameters>::max_exponent_for_k_geq_0;
+			using common_info<Float, Parameters>::max_exponent_for_k_geq_m1;
+			using common_info<Float, Parameters>::integer_check_exponent_upper_bound_for_p_p2;
+			using common_info<Float, Parameters>::integer_check_exponent_upper_bound_for_p_p1;
 
 			template <unsigned int e>
 			static constexpr extended_significand_type power_of_10 = compute_power(extended_significand_type(10), e);
@@ -1829,7 +1877,7 @@ namespace jkj {
 				assert(-minus_beta >= alpha && -minus_beta <= gamma);
 
 				// Compute zi and deltai
-				auto const cache = jkj::grisu_exact_detail::get_cache<Float>(-minus_k);
+				auto const cache = jkj::grisu_exact_detail::get_cache<Float, Parameters>(-minus_k);
 
 				extended_significand_type zi;
 				if constexpr (IntervalTypeProvider::tag ==
@@ -1926,11 +1974,11 @@ namespace jkj {
 						r = 0;
 					}
 					else {
-						static_assert(initial_kappa == 3);
-						// kappa = 1
+						// kappa = initial_kappa - 2
+						constexpr auto divisor32 = std::uint32_t(power_of_10<initial_kappa - 2>);
 						ret_value.significand *= 100;
-						ret_value.significand += 10 * quotient + (std::uint32_t(new_r) / 10);
-						r = std::uint32_t(new_r) % 10;
+						ret_value.significand += 10 * quotient + (std::uint32_t(new_r) / divisor32);
+						r = std::uint32_t(new_r) % divisor32;
 					}
 					ret_value.exponent -= 2;
 					divisor = power_of_10<initial_kappa - 2>;
@@ -1973,10 +2021,8 @@ namespace jkj {
 				// Perform binary search
 				divisor = power_of_10<initial_kappa>;
 
-				if constexpr (sizeof(Float) == 4) {
-					// This procedure strictly depends on our specific choice of these parameters:
-					static_assert(max_kappa - initial_kappa < 8);
-
+				// The number of steps depends on the range of kappa
+				if constexpr (max_kappa - initial_kappa < 8) {
 					increasing_search<4, IntervalTypeProvider::tag, true>(ret_value, interval_type,
 						zf_vs_deltaf, exponent, minus_k, minus_beta, significand, r, divisor, deltai, cache);
 					increasing_search<2, IntervalTypeProvider::tag, false>(ret_value, interval_type,
@@ -1985,7 +2031,6 @@ namespace jkj {
 						zf_vs_deltaf, exponent, minus_k, minus_beta, significand, r, divisor, deltai, cache);
 				}
 				else {
-					// This procedure strictly depends on our specific choice of these parameters:
 					static_assert(max_kappa - initial_kappa < 16);
 
 					increasing_search<8, IntervalTypeProvider::tag, true>(ret_value, interval_type,
@@ -2011,7 +2056,15 @@ namespace jkj {
 						integer_check_case_id::fc_pm_2_to_the_q_mp_m2_generic :
 						integer_check_case_id::other;
 
-					if (is_product_integer<case_id>(fr, exponent, minus_k)) {
+					// fr is 0 only if it has overflowed in left-closed directed rounding;
+					// then z = 2^(q + e) * 10^k, which is an integer if and only if
+					// both of the exponents are nonnegative
+					bool const is_z_integer = (IntervalTypeProvider::tag ==
+						grisu_exact_rounding_modes::left_closed_directed_tag && fr == 0) ?
+						(minus_k <= 0 && int(extended_precision) + exponent - minus_k >= 0) :
+						is_product_integer<case_id>(fr, exponent, minus_k);
+
+					if (is_z_integer) {
 						// Decrease kappa until 10^kappa becomes smaller than delta
 						// If left boundary is included, 10^kappa can also be equal to delta
 						while (true) {
@@ -2090,9 +2143,10 @@ namespace jkj {
 					IntervalTypeProvider::tag ==
 					grisu_exact_rounding_modes::left_closed_directed_tag)
 				{
+					// Integer part of x, possibly plus one; should be taken before deltai is reduced
+					auto const approx_x = zi - deltai;
 					// We already know r is at most deltai
 					deltai -= std::uint32_t(r);
-					auto const approx_x = zi - deltai;
 
 					auto const current_digit = ret_value.significand % 10;
 
@@ -2133,6 +2187,7 @@ namespace jkj {
 							case zf_vs_deltaf_t::zf_smaller:
 								break;
 							}
+							ret_value.significand -= steps;
 							goto return_label;
 						}
 						else {
@@ -2186,13 +2241,15 @@ namespace jkj {
 								if (divisor32 <= epsiloni) {
 									epsiloni -= divisor32;
 
-									// For binary32, this implies that n' should be 4
-									if constexpr (sizeof(Float) == 4) {
+									// For binary32 with the default parameters, n' is at most 4,
+									// so this implies that n' should be 4
+									if constexpr (Parameters::max_n_prime == 4) {
 										steps = 5;
 									}
 									// For binary64, there are inputs such that
 									// n' = 5, though extremely rare
 									else {
+										static_assert(Parameters::max_n_prime == 5);
 										// n' + 1 = 6?
 										if (divisor32 <= epsiloni) {
 											epsiloni -= divisor32;
@@ -2283,15 +2340,8 @@ namespace jkj {
 							}
 							else if (divisor == deltai) {
 								// See the test result of verify_incorrect_rounding_removal.cpp
-								if constexpr (sizeof(Float) == 4) {
-									if (exponent == 59) {
-										goto return_label;
-									}
-								}
-								else {
-									if (exponent == -203) {
-										goto return_label;
-									}
+								if (Parameters::skip_incorrect_rounding_removal(exponent)) {
+									goto return_label;
 								}
 							}
 						}
@@ -2677,7 +2727,24 @@ namespace jkj {
 	{
 		auto br = get_bit_representation(x);
 		case_handler(br);
-		return std::forward<RoundingMode>(rounding_mode).template delegate<return_sign>(
+		return std::forward<RoundingMode>(rounding_mode).template delegate<return_sign,
+			grisu_exact_default_parameters<Float>>(br, std::forward<CorrectRoundingSearch>(crs));
+	}
+
+	// Same as grisu_exact, but with the given parameters instead of the default ones
+	template <class Parameters, bool return_sign = true, class Float,
+		class RoundingMode = grisu_exact_rounding_modes::nearest_to_even,
+		class CorrectRoundingSearch = grisu_exact_correct_rounding::tie_to_even,
+		class CaseHandler = grisu_exact_case_handlers::assert_finite
+	>
+	fp_t<Float, return_sign> grisu_exact_with_parameters(Float x,
+		RoundingMode&& rounding_mode = {},
+		CorrectRoundingSearch&& crs = {},
+		CaseHandler&& case_handler = {})
+	{
+		auto br = get_bit_representation(x);
+		case_handler(br);
+		return std::forward<RoundingMode>(rounding_mode).template delegate<return_sign, Parameters>(
 			br, std::forward<CorrectRoundingSearch>(crs));
 	}
 }
@@ -0,0 +1,830 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// Compare the arithmetic of bigint.h with the implementation it replaced, which is kept here
+// as the reference (schoolbook multiplication and bit-by-bit long division), over random
+// operands of various lengths and of bit patterns prone to carries and borrows, and check both
+// against a few products, quotients, and shifts of powers of 5 and 10 with known answers.
+// Optionally, measure both for the sizes used by the cache generation and verification.
+
+#include "bigint_test.h"
+#include "../common/bigint.h"
+#include "../common/random_float.h"
+#include <algorithm>
+#include <chrono>
+#include <initializer_list>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+	using jkj::grisu_exact_detail::bigint_base;
+	using jkj::grisu_exact_detail::bigint_impl;
+	using jkj::grisu_exact_detail::log2p1;
+	using jkj::grisu_exact_detail::umul128;
+
+	// operator* of bigint_impl before the word-wise and Karatsuba multiplication
+	// The carry out of a row shorter than the previous one used to be dropped; that is fixed here.
+	template <std::size_t array_size>
+	bigint_impl<array_size> reference_multiply(bigint_impl<array_size> const& x,
+		bigint_impl<array_size> const& y)
+	{
+		using bigint_type = bigint_impl<array_size>;
+		// Leaky overflow check
+		assert(x.leading_one_pos.element_pos + y.leading_one_pos.element_pos < array_size);
+
+		std::size_t single_result_leading_one_pos;
+		auto calculate_single = [&](bigint_base::element_type n, auto& result) {
+			bigint_base::element_type mul_carry = 0;
+			for (std::size_t idx = 0; idx <= x.leading_one_pos.element_pos; ++idx) {
+				auto mul = umul128(x.elements[idx], n);
+				result[idx] = mul.low() + mul_carry;
+				mul_carry = mul.high() + (result[idx] < mul.low() ? 1 : 0);
+			}
+			if (mul_carry != 0) {
+				single_result_leading_one_pos = x.leading_one_pos.element_pos + 1;
+				result[single_result_leading_one_pos] = mul_carry;
+			}
+			else {
+				single_result_leading_one_pos = x.leading_one_pos.element_pos;
+			}
+		};
+
+		decltype(x.elements) temp{};
+		bigint_type result = 0;
+
+		// First iteration
+		calculate_single(y.elements[0], result.elements);
+		std::fill(std::begin(result.elements) + single_result_leading_one_pos + 1,
+			std::end(result.elements), 0);
+
+		// Remaining iterations
+		for (std::size_t i = 1; i <= y.leading_one_pos.element_pos; ++i) {
+			calculate_single(y.elements[i], temp);
+
+			// Accumulate
+			result.elements[i] += temp[0];
+			unsigned int add_carry = result.elements[i] < temp[0] ? 1 : 0;
+			for (std::size_t j = 1; j <= single_result_leading_one_pos && i + j < array_size; ++j) {
+				auto with_carry = temp[j] + add_carry;
+				auto first_carry = with_carry < temp[j] ? 1 : 0;
+
+				result.elements[i + j] += with_carry;
+				add_carry = first_carry | ((result.elements[i + j] < with_carry) ? 1 : 0);
+			}
+
+			// The previous row may be one element longer
+			if (add_carry != 0) {
+				assert(i + single_result_leading_one_pos + 1 < array_size);
+				if (i + single_result_leading_one_pos + 1 < array_size) {
+					++result.elements[i + single_result_leading_one_pos + 1];
+				}
+			}
+		}
+
+		result.leading_one_pos.element_pos = y.leading_one_pos.element_pos +
+			single_result_leading_one_pos;
+		if (result.leading_one_pos.element_pos + 1 < array_size &&
+			result.elements[result.leading_one_pos.element_pos + 1] != 0)
+		{
+			++result.leading_one_pos.element_pos;
+		}
+		result.leading_one_pos.bit_pos =
+			log2p1(result.elements[result.leading_one_pos.element_pos]);
+
+		return result;
+	}
+
+	// bigint_impl::long_division before the word-level division, which shifts and subtracts
+	// bit by bit; dividend becomes the remainder, and the quotient is returned
+	// Two bugs are fixed here: when n_shifted was right-shifted by one bit across an element
+	// boundary, the bit shifted out was set twice, and when re-aligning n_shifted with the
+	// remainder by more than an element, the elements below its leading one were not all moved,
+	// which could give wrong results or never terminate.
+	template <std::size_t array_size>
+	bigint_impl<array_size> reference_long_division(bigint_impl<array_size>& dividend,
+		bigint_impl<array_size> const& n)
+	{
+		using bigint_type = bigint_impl<array_size>;
+		using element_type = typename bigint_type::element_type;
+		constexpr auto element_number_of_bits = bigint_type::element_number_of_bits;
+
+		bigint_type n_shifted{};
+		bigint_type quotient = 0;
+
+		std::size_t comparison_idx;
+		std::size_t operation_idx;
+
+		std::size_t base_idx;
+		std::size_t base_trailing_zeros;
+		std::size_t total_shft_amount;
+
+		auto perform_subtraction = [&](bigint_type const& x) {
+			unsigned int carry = dividend.elements[base_idx] < x.elements[base_idx] ? 1 : 0;
+			dividend.elements[base_idx] -= x.elements[base_idx];
+
+			for (operation_idx = base_idx + 1;
+				operation_idx <= comparison_idx && operation_idx < array_size; ++operation_idx)
+			{
+				auto with_carry = x.elements[operation_idx] + carry;
+				unsigned int first_carry = (with_carry < carry) ? 1 : 0;
+
+				carry = first_carry | ((dividend.elements[operation_idx] < with_carry) ? 1 : 0);
+				dividend.elements[operation_idx] -= with_carry;
+			}
+			assert(carry == 0);
+			for (; operation_idx <= dividend.leading_one_pos.element_pos; ++operation_idx)
+				dividend.elements[operation_idx] = 0;
+
+			while (dividend.elements[comparison_idx] == 0) {
+				if (comparison_idx == 0)
+					break;
+				else
+					--comparison_idx;
+			}
+			dividend.leading_one_pos.element_pos = comparison_idx;
+			dividend.leading_one_pos.bit_pos = log2p1(dividend.elements[comparison_idx]);
+		};
+
+		if (dividend.leading_one_pos.element_pos < n.leading_one_pos.element_pos) {
+			return quotient;
+		}
+		else if (dividend.leading_one_pos.element_pos == n.leading_one_pos.element_pos) {
+			if (dividend.leading_one_pos.bit_pos < n.leading_one_pos.bit_pos) {
+				return quotient;
+			}
+			else if (dividend.leading_one_pos.bit_pos == n.leading_one_pos.bit_pos) {
+				// Compare *this with n
+				for (comparison_idx = dividend.leading_one_pos.element_pos;
+					comparison_idx > 0; --comparison_idx)
+				{
+					// If n is larger, return
+					if (n.elements[comparison_idx] > dividend.elements[comparison_idx])
+						return quotient;
+
+					// If *this is larger, then we can subtract n from *this exactly once
+					if (n.elements[comparison_idx] < dividend.elements[comparison_idx]) {
+						base_idx = 0;
+						perform_subtraction(n);
+
+						quotient.leading_one_pos.bit_pos = 1;
+						quotient.elements[0] = 1;
+						return quotient;
+					}
+				}
+				// If n is larger, return
+				if (n.elements[0] > dividend.elements[0])
+					return quotient;
+				// Otherwise, we can subtract n from *this exactly once
+				else {
+					dividend.elements[0] -= n.elements[0];
+					std::fill_n(std::begin(dividend.elements) + 1, dividend.leading_one_pos.element_pos, 0);
+
+					dividend.leading_one_pos.element_pos = 0;
+					dividend.leading_one_pos.bit_pos = log2p1(dividend.elements[0]);
+
+					quotient.leading_one_pos.bit_pos = 1;
+					quotient.elements[0] = 1;
+					return quotient;
+				}
+			}
+			else {
+				// Perform bit-wise left-shift
+				base_idx = 0;
+				base_trailing_zeros = dividend.leading_one_pos.bit_pos - n.leading_one_pos.bit_pos;
+				total_shft_amount = base_trailing_zeros;
+
+				for (std::size_t idx = dividend.leading_one_pos.element_pos; idx > 0; --idx) {
+					n_shifted.elements[idx] = (n.elements[idx] << base_trailing_zeros);
+					n_shifted.elements[idx] |=
+						(n.elements[idx - 1] >> (element_number_of_bits - base_trailing_zeros));
+				}
+				n_shifted.elements[0] = (n.elements[0] << base_trailing_zeros);
+			}
+		}
+		// dividend.leading_one_pos.element_pos > n.leading_one_pos.element_pos
+		else {
+			// Perform element-wise left-shift and then bit-wise left-shift
+			base_idx = dividend.leading_one_pos.element_pos - n.leading_one_pos.element_pos;
+			if (dividend.leading_one_pos.bit_pos > n.leading_one_pos.bit_pos) {
+				base_trailing_zeros = dividend.leading_one_pos.bit_pos - n.leading_one_pos.bit_pos;
+			}
+			else if (dividend.leading_one_pos.bit_pos < n.leading_one_pos.bit_pos) {
+				--base_idx;
+				n_shifted.elements[dividend.leading_one_pos.element_pos] = 0;
+				base_trailing_zeros = element_number_of_bits +
+					dividend.leading_one_pos.bit_pos - n.leading_one_pos.bit_pos;
+			}
+			else
+				base_trailing_zeros = 0;
+
+			total_shft_amount = base_idx * element_number_of_bits + base_trailing_zeros;
+
+			// Element-wise shift
+			std::fill_n(std::begin(n_shifted.elements), base_idx, 0);
+			std::copy(std::begin(n.elements),
+				std::begin(n.elements) + n.leading_one_pos.element_pos + 1,
+				std::begin(n_shifted.elements) + base_idx);
+
+			// Bit-wise shift
+			if (base_trailing_zeros != 0) {
+				for (std::size_t idx = dividend.leading_one_pos.element_pos; idx > base_idx; --idx) {
+					n_shifted.elements[idx] <<= base_trailing_zeros;
+					n_shifted.elements[idx] |=
+						(n_shifted.elements[idx - 1] >> (element_number_of_bits - base_trailing_zeros));
+				}
+				n_shifted.elements[base_idx] <<= base_trailing_zeros;
+			}
+		}
+
+		// Leading bits of n_shifted and *this are now aligned
+		n_shifted.leading_one_pos = dividend.leading_one_pos;
+
+		auto compare_and_subtract = [&](auto is_before_iteration) {
+			// Compare *this with n_shifted
+			for (comparison_idx = dividend.leading_one_pos.element_pos;
+				comparison_idx != std::size_t(-1); --comparison_idx)
+			{
+				// If n is larger, right-shift by one bit
+				if (n_shifted.elements[comparison_idx] > dividend.elements[comparison_idx]) {
+					if (base_trailing_zeros == 0) {
+						if constexpr (!decltype(is_before_iteration)::value) {
+							// If we cannot shift further, stop
+							if (base_idx == 0) {
+								return false;
+							}
+						}
+
+						// The bit shifted into this element is set by the loop below
+						n_shifted.elements[base_idx - 1] = 0;
+						base_trailing_zeros = element_number_of_bits - 1;
+						--base_idx;
+					}
+					else
+						--base_trailing_zeros;
+
+					--total_shft_amount;
+
+					if (dividend.leading_one_pos.bit_pos == 1) {
+						--n_shifted.leading_one_pos.element_pos;
+						n_shifted.leading_one_pos.bit_pos = element_number_of_bits;
+					}
+					else
+						--n_shifted.leading_one_pos.bit_pos;
+
+					for (operation_idx = base_idx; operation_idx < dividend.leading_one_pos.element_pos &&
+						operation_idx + 1 < array_size; ++operation_idx)
+					{
+						n_shifted.elements[operation_idx] >>= 1;
+						n_shifted.elements[operation_idx] |=
+							(n_shifted.elements[operation_idx + 1] << (element_number_of_bits - 1));
+					}
+					n_shifted.elements[dividend.leading_one_pos.element_pos] >>= 1;
+
+					comparison_idx = dividend.leading_one_pos.element_pos;
+					break;
+				}
+
+				else if (n_shifted.elements[comparison_idx] < dividend.elements[comparison_idx])
+					break;
+			}
+
+			if constexpr (decltype(is_before_iteration)::value) {
+				// Set leading bit position of quotient
+				quotient.leading_one_pos.element_pos = base_idx;
+				quotient.leading_one_pos.bit_pos = base_trailing_zeros + 1;
+			}
+			// Update quotient
+			quotient.elements[base_idx] |= (element_type(1) << base_trailing_zeros);
+
+			// Exact match
+			if (comparison_idx == std::size_t(-1)) {
+				// Set *this to zero
+				std::fill_n(std::begin(dividend.elements), dividend.leading_one_pos.element_pos + 1, 0);
+				dividend.leading_one_pos = { 0, 0 };
+
+				return false;
+			}
+
+			// Subtract n_shifted from *this
+			perform_subtraction(n_shifted);
+
+			return true;
+		};
+
+		if (!compare_and_subtract(std::bool_constant<true>{}))
+			return quotient;
+
+		do {
+			// Right-shift n_shifted to re-align leading ones
+			auto element_shft_amount = n_shifted.leading_one_pos.element_pos - dividend.leading_one_pos.element_pos;
+			std::size_t bit_shft_amount;
+			if (dividend.leading_one_pos.bit_pos < n_shifted.leading_one_pos.bit_pos) {
+				bit_shft_amount = n_shifted.leading_one_pos.bit_pos - dividend.leading_one_pos.bit_pos;
+			}
+			else if (dividend.leading_one_pos.bit_pos > n_shifted.leading_one_pos.bit_pos) {
+				--element_shft_amount;
+				bit_shft_amount = element_number_of_bits +
+					n_shifted.leading_one_pos.bit_pos - dividend.leading_one_pos.bit_pos;
+			}
+			else
+				bit_shft_amount = 0;
+
+			auto necessary_shft_amount = element_shft_amount * element_number_of_bits + bit_shft_amount;
+
+			if (total_shft_amount < necessary_shft_amount) {
+				break;
+			}
+			total_shft_amount -= necessary_shft_amount;
+
+			base_idx = total_shft_amount / element_number_of_bits;
+			base_trailing_zeros = total_shft_amount % element_number_of_bits;
+
+			// Element-wise shift
+			auto const shifted_element_pos = n_shifted.leading_one_pos.element_pos - element_shft_amount;
+			if (element_shft_amount != 0) {
+				for (std::size_t idx = base_idx; idx <= shifted_element_pos; ++idx)
+					n_shifted.elements[idx] = n_shifted.elements[idx + element_shft_amount];
+			}
+
+			// Bit-wise shift
+			if (bit_shft_amount != 0) {
+				for (std::size_t idx = base_idx; idx < shifted_element_pos && idx + 1 < array_size; ++idx) {
+					n_shifted.elements[idx] >>= bit_shft_amount;
+					n_shifted.elements[idx] |=
+						(n_shifted.elements[idx + 1] << (element_number_of_bits - bit_shft_amount));
+				}
+				n_shifted.elements[shifted_element_pos] >>= bit_shft_amount;
+			}
+
+			// Leading bits of n_shifted and *this are now aligned
+			n_shifted.leading_one_pos = dividend.leading_one_pos;
+		} while(compare_and_subtract(std::bool_constant<false>{}));
+
+		return quotient;
+	}
+	// A number of at most max_size elements; each element is zero, all ones, a power of 2,
+	// a small number, or uniformly random
+	template <std::size_t array_size, class RandGen>
+	bigint_impl<array_size> random_bigint(RandGen& rg, std::size_t max_size)
+	{
+		bigint_impl<array_size> ret = 0;
+		auto const size = std::uniform_int_distribution<std::size_t>{ 1, max_size }(rg);
+		for (std::size_t idx = 0; idx < size; ++idx) {
+			switch (rg() % 6) {
+			case 0:
+				ret.elements[idx] = 0;
+				break;
+
+			case 1:
+				ret.elements[idx] = bigint_base::element_type(-1);
+				break;
+
+			case 2:
+				ret.elements[idx] = bigint_base::element_type(1) << (rg() % 64);
+				break;
+
+			case 3:
+				ret.elements[idx] = rg() >> (rg() % 64);
+				break;
+
+			default:
+				ret.elements[idx] = rg();
+			}
+		}
+
+		auto top = size - 1;
+		while (top > 0 && ret.elements[top] == 0) {
+			--top;
+		}
+		ret.leading_one_pos = { top, log2p1(ret.elements[top]) };
+		return ret;
+	}
+
+	// A number of exactly the given number of elements, uniformly random otherwise
+	template <std::size_t array_size, class RandGen>
+	bigint_impl<array_size> full_bigint(RandGen& rg, std::size_t size)
+	{
+		bigint_impl<array_size> ret = 0;
+		for (std::size_t idx = 0; idx < size; ++idx) {
+			ret.elements[idx] = rg();
+		}
+		ret.elements[size - 1] |= bigint_base::element_type(1) << 63;
+		ret.leading_one_pos = { size - 1, bigint_base::element_number_of_bits };
+		return ret;
+	}
+
+	// The leading-1 position is correct, and every element above it is zero
+	template <std::size_t array_size>
+	bool is_well_formed(bigint_impl<array_size> const& x)
+	{
+		auto const element_pos = x.leading_one_pos.element_pos;
+		if (element_pos >= array_size || x.leading_one_pos.bit_pos != log2p1(x.elements[element_pos]) ||
+			(element_pos != 0 && x.elements[element_pos] == 0))
+		{
+			return false;
+		}
+		for (auto idx = element_pos + 1; idx < array_size; ++idx) {
+			if (x.elements[idx] != 0) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template <std::size_t array_size>
+	bool is_identical(bigint_impl<array_size> const& x, bigint_impl<array_size> const& y)
+	{
+		return is_well_formed(x) && is_well_formed(y) && x == y &&
+			x.leading_one_pos.bit_pos == y.leading_one_pos.bit_pos;
+	}
+
+	template <std::size_t array_size>
+	std::string to_hex(bigint_impl<array_size> const& x)
+	{
+		static constexpr char digits[] = "0123456789abcdef";
+		std::string ret = "0x";
+		for (auto idx = x.leading_one_pos.element_pos + 1; idx > 0; --idx) {
+			for (int shft = 60; shft >= 0; shft -= 4) {
+				ret += digits[(x.elements[idx - 1] >> shft) & 0xf];
+			}
+			if (idx != 1) {
+				ret += '\'';
+			}
+		}
+		return ret;
+	}
+
+	// Elements from the lowest
+	template <std::size_t array_size>
+	bigint_impl<array_size> from_elements(std::initializer_list<bigint_base::element_type> elements)
+	{
+		bigint_impl<array_size> ret = 0;
+		std::copy(elements.begin(), elements.end(), std::begin(ret.elements));
+		ret.leading_one_pos = { elements.size() - 1, log2p1(*(elements.end() - 1)) };
+		return ret;
+	}
+
+	// Products, quotients, and shifts of powers of 5 and 10 computed independently,
+	// since the reference may share a bug with the current implementation
+	template <std::size_t array_size>
+	std::size_t test_known_answers(bigint_test_parameters const& params,
+		std::size_t& number_of_reported_failures)
+	{
+		using bigint_type = bigint_impl<array_size>;
+		constexpr auto max_bits = array_size * bigint_type::element_number_of_bits;
+
+		auto const pow5_27 = from_elements<array_size>({ 0x6765c793fa10079d });
+		auto const pow5_54 = from_elements<array_size>({ 0x6664242d97d9f649, 0x29c30f1029939b14 });
+		auto const pow5_73 = from_elements<array_size>({
+			0xf6f9050d02cf0865, 0x922375aeaead8e62, 0x000002d4744eba92 });
+		auto const pow5_100 = from_elements<array_size>({
+			0xcaab24308a82e8f1, 0xbf38ace408e211a7, 0x37ceb0b2784c4ce0, 0x000001249ad2594c });
+		auto const pow5_127 = from_elements<array_size>({
+			0xcd931e9b6fb772cd, 0xa0b0fa6fcfd10b65, 0x5a675f34f7299795, 0x213d7fd1f28f89c5,
+			0x000000762e9fd467 });
+		auto const pow5_200 = from_elements<array_size>({
+			0x938288753cb9b2e1, 0xde89b43a6bcd3f16, 0x0c684d4546089e87, 0x13df249391fddba6,
+			0xee99b444273068ec, 0xf15802cac3b68141, 0x8d7d7625a2d96851, 0x0000000000014e71 });
+		auto const pow10_19 = from_elements<array_size>({ 0x8ac7230489e80000 });
+		auto const pow10_38 = from_elements<array_size>({ 0x098a224000000000, 0x4b3b4ca85a86c47a });
+		// 10^38 + 12345
+		auto const pow10_38_p = from_elements<array_size>({ 0x098a224000003039, 0x4b3b4ca85a86c47a });
+		// 2^300 = 5^73 * q + r
+		auto const pow2_300 = bigint_type::power_of_2(300);
+		auto const q = from_elements<array_size>({
+			0xf1c575b1b058d79a, 0xa766af80d2554140, 0x0000000000000005 });
+		auto const r = from_elements<array_size>({
+			0x81d9c50b1cb0203e, 0x724e67e390a2e339, 0x000000734ae84926 });
+		// 5^100 * 2^100 and floor(5^200 / 2^130)
+		auto const pow5_100_shifted = from_elements<array_size>({
+			0x0000000000000000, 0xa82e8f1000000000, 0x8e211a7caab24308, 0x84c4ce0bf38ace40,
+			0xad2594c37ceb0b27, 0x0000000000001249 });
+		auto const pow5_200_shifted = from_elements<array_size>({
+			0x831a1351518227a1, 0x04f7c924e47f76e9, 0x7ba66d1109cc1a3b, 0x7c5600b2b0eda050,
+			0x635f5d8968b65a14, 0x000000000000539c });
+
+		std::size_t number_of_failures = 0;
+		auto check = [&](char const* operation, bool current, bool reference) {
+			for (auto [implementation, correct] : { std::pair{ "", current },
+				std::pair{ " (reference)", reference } })
+			{
+				if (!correct) {
+					++number_of_failures;
+					if (number_of_reported_failures++ < params.max_number_of_reported_failures) {
+						std::cout << "Wrong answer for " << operation << implementation <<
+							" with bigint<" << max_bits << ">\n";
+					}
+				}
+			}
+		};
+		auto check_multiplication = [&](char const* operation, bigint_type const& x,
+			bigint_type const& y, bigint_type const& expected)
+		{
+			check(operation, is_identical(x * y, expected),
+				is_identical(reference_multiply(x, y), expected));
+		};
+		auto check_division = [&](char const* operation, bigint_type const& dividend,
+			bigint_type const& divisor, bigint_type const& expected_quotient,
+			bigint_type const& expected_remainder)
+		{
+			auto remainder = dividend;
+			auto const quotient = remainder.long_division(divisor);
+			auto reference_remainder = dividend;
+			auto const reference_quotient = reference_long_division(reference_remainder, divisor);
+			check(operation,
+				is_identical(quotient, expected_quotient) && is_identical(remainder, expected_remainder),
+				is_identical(reference_quotient, expected_quotient) &&
+				is_identical(reference_remainder, expected_remainder));
+		};
+
+		check_multiplication("5^27 * 5^27", pow5_27, pow5_27, pow5_54);
+		check_multiplication("10^19 * 10^19", pow10_19, pow10_19, pow10_38);
+		check_multiplication("5^100 * 5^100", pow5_100, pow5_100, pow5_200);
+		check_multiplication("5^127 * 5^73", pow5_127, pow5_73, pow5_200);
+		check_division("10^38 / 10^19", pow10_38, pow10_19, pow10_19, bigint_type(0));
+		check_division("(10^38 + 12345) / 10^19", pow10_38_p, pow10_19, pow10_19, bigint_type(12345));
+		check_division("5^200 / 5^73", pow5_200, pow5_73, pow5_127, bigint_type(0));
+		check_division("2^300 / 5^73", pow2_300, pow5_73, q, r);
+
+		auto shifted = pow5_100;
+		shifted <<= 100;
+		check("5^100 << 100", is_identical(shifted, pow5_100_shifted),
+			is_identical(reference_multiply(pow5_100, bigint_type::power_of_2(100)), pow5_100_shifted));
+		shifted = pow5_200;
+		shifted >>= 130;
+		auto remainder = pow5_200;
+		check("5^200 >> 130", is_identical(shifted, pow5_200_shifted),
+			is_identical(reference_long_division(remainder, bigint_type::power_of_2(130)),
+				pow5_200_shifted));
+
+		std::cout << "bigint<" << max_bits << "> known answers: " << number_of_failures << " failures.\n";
+		return number_of_failures;
+	}
+
+	template <std::size_t array_size, class RandGen>
+	std::size_t test_random_inputs(RandGen& rg, bigint_test_parameters const& params,
+		std::size_t& number_of_reported_failures)
+	{
+		using bigint_type = bigint_impl<array_size>;
+		constexpr auto max_bits = array_size * bigint_type::element_number_of_bits;
+
+		std::size_t number_of_failures = 0;
+		auto report = [&](char const* operation, std::initializer_list<bigint_type const*> operands) {
+			++number_of_failures;
+			if (number_of_reported_failures++ < params.max_number_of_reported_failures) {
+				std::cout << "Mismatch in " << operation << " of bigint<" << max_bits << ">:";
+				for (auto const operand : operands) {
+					std::cout << " " << to_hex(*operand);
+				}
+				std::cout << "\n";
+			}
+		};
+
+		auto check_division = [&](bigint_type const& dividend, bigint_type const& divisor) {
+			auto remainder = dividend;
+			auto const quotient = remainder.long_division(divisor);
+			auto reference_remainder = dividend;
+			auto const reference_quotient = reference_long_division(reference_remainder, divisor);
+			auto reconstructed = quotient * divisor;
+			reconstructed += remainder;
+			if (!is_identical(quotient, reference_quotient) ||
+				!is_identical(remainder, reference_remainder) ||
+				remainder >= divisor || reconstructed != dividend)
+			{
+				report("division", { &dividend, &divisor });
+			}
+		};
+
+		// 2^192 / (2^191 + 2^64 - 1); the first estimate of the quotient is 2, which is not
+		// corrected by the leading two elements of the divisor, so the divisor is added back
+		if constexpr (array_size >= 4) {
+			bigint_type dividend = bigint_type::power_of_2(192);
+			bigint_type divisor = bigint_type::power_of_2(191);
+			divisor += bigint_base::element_type(-1);
+			check_division(dividend, divisor);
+		}
+
+		for (std::size_t i = 0; i < params.number_of_random_inputs; ++i) {
+			// Multiplication; the reference does not handle products longer than array_size,
+			// and does not normalize zero
+			{
+				auto const x = random_bigint<array_size>(rg, array_size - 1);
+				auto const y = random_bigint<array_size>(rg, array_size - 1 - x.leading_one_pos.element_pos);
+				auto const product = x * y;
+				if (x == 0 || y == 0 ? !is_identical(product, bigint_type(0)) :
+					!is_identical(product, reference_multiply(x, y)))
+				{
+					report("multiplication", { &x, &y });
+				}
+			}
+
+			// Division; the divisor is sometimes a power of 2 or a single element
+			{
+				auto const dividend = random_bigint<array_size>(rg, array_size);
+				bigint_type divisor;
+				switch (rg() % 4) {
+				case 0:
+					divisor = bigint_type::power_of_2(std::size_t(rg() %
+						((dividend.leading_one_pos.element_pos + 1) * bigint_type::element_number_of_bits)));
+					break;
+
+				case 1:
+					divisor = random_bigint<array_size>(rg, 1);
+					break;
+
+				default:
+					divisor = random_bigint<array_size>(rg, dividend.leading_one_pos.element_pos + 1);
+				}
+				if (divisor == 0) {
+					divisor = 1;
+				}
+
+				check_division(dividend, divisor);
+			}
+
+			// Shifts, against multiplication and division by a power of 2
+			{
+				auto const x = random_bigint<array_size>(rg, array_size);
+				auto const number_of_bits = x.leading_one_pos.element_pos *
+					bigint_type::element_number_of_bits + x.leading_one_pos.bit_pos;
+
+				auto shifted = x;
+				if (x != 0) {
+					auto const left_shft = std::size_t(rg() % (max_bits - number_of_bits + 1));
+					shifted <<= left_shft;
+					if (!is_identical(shifted, reference_multiply(x, bigint_type::power_of_2(left_shft)))) {
+						report("left-shift", { &x, &shifted });
+					}
+				}
+
+				auto const right_shft = std::size_t(rg() % max_bits);
+				shifted = x;
+				shifted >>= right_shft;
+				auto remainder = x;
+				if (!is_identical(shifted,
+					reference_long_division(remainder, bigint_type::power_of_2(right_shft))))
+				{
+					report("right-shift", { &x, &shifted });
+				}
+			}
+		}
+
+		std::cout << "bigint<" << max_bits << ">: " << number_of_failures << " failures.\n";
+		return number_of_failures;
+	}
+
+	// Average time of a call of f(i) over i in [0, number_of_operands),
+	// repeated until the given time has passed
+	template <class Function>
+	double measure_nanoseconds(Function&& f, std::size_t number_of_operands, double seconds)
+	{
+		using clock = std::chrono::steady_clock;
+		std::size_t number_of_runs = 0;
+		auto const from = clock::now();
+		std::chrono::duration<double> elapsed;
+		do {
+			for (std::size_t i = 0; i < number_of_operands; ++i) {
+				f(i);
+			}
+			++number_of_runs;
+			elapsed = clock::now() - from;
+		} while (elapsed.count() < seconds);
+		return elapsed.count() * 1e9 / double(number_of_runs * number_of_operands);
+	}
+
+	// Prevents the results from being optimized away
+	volatile bigint_base::element_type sink;
+
+	// Compare the reference and the current implementation for operands of size elements
+	template <std::size_t size, class RandGen>
+	void measure(RandGen& rg, bigint_test_parameters const& params)
+	{
+		using bigint_type = bigint_impl<2 * size>;
+		constexpr std::size_t number_of_operands = 16;
+
+		auto print = [&](std::string const& operation, auto&& reference, auto&& current) {
+			auto const reference_time = measure_nanoseconds(reference,
+				number_of_operands, params.measurement_seconds);
+			auto const current_time = measure_nanoseconds(current,
+				number_of_operands, params.measurement_seconds);
+			std::cout << std::left << std::setw(28) << operation << std::right << std::fixed <<
+				std::setprecision(1) << std::setw(14) << reference_time << std::setw(14) <<
+				current_time << std::setw(9) << reference_time / current_time << "x\n";
+		};
+
+		std::vector<bigint_type> long_operands, short_operands, single_operands, euclid_operands;
+		for (std::size_t i = 0; i < number_of_operands; ++i) {
+			long_operands.push_back(full_bigint<2 * size>(rg, 2 * size));
+			short_operands.push_back(full_bigint<2 * size>(rg, size));
+			single_operands.push_back(rg() | 1);
+		}
+		// A few bits shorter than the corresponding short operand, so that the quotients are
+		// small as in the steps of the Euclid algorithm
+		for (std::size_t i = 0; i < number_of_operands; ++i) {
+			euclid_operands.push_back(short_operands[(i + 1) % number_of_operands]);
+			euclid_operands.back() >>= std::size_t(rg() % 8 + 1);
+		}
+
+		auto multiply = [&](auto&& mul, std::vector<bigint_type> const& y) {
+			return [&, &y = y](std::size_t i) {
+				sink = mul(short_operands[i], y[(i + 1) % number_of_operands]).elements[0];
+			};
+		};
+		auto divide = [&](auto&& div, std::vector<bigint_type> const& x,
+			std::vector<bigint_type> const& y)
+		{
+			return [&, &x = x, &y = y](std::size_t i) {
+				auto remainder = x[i];
+				sink = div(remainder, y[i]).elements[0] ^ remainder.elements[0];
+			};
+		};
+		auto reference_mul = [](bigint_type const& x, bigint_type const& y) {
+			return reference_multiply(x, y);
+		};
+		auto current_mul = [](bigint_type const& x, bigint_type const& y) { return x * y; };
+		auto reference_div = [](bigint_type& x, bigint_type const& y) {
+			return reference_long_division(x, y);
+		};
+		auto current_div = [](bigint_type& x, bigint_type const& y) { return x.long_division(y); };
+
+		std::vector<bigint_type> powers_of_2;
+		for (std::size_t i = 0; i < number_of_operands; ++i) {
+			powers_of_2.push_back(bigint_type::power_of_2(std::size_t(rg() % (size * 64))));
+		}
+
+		auto const n = std::to_string(size);
+		print(n + " x " + n + " multiplication",
+			multiply(reference_mul, short_operands), multiply(current_mul, short_operands));
+		print(n + " x 1 multiplication",
+			multiply(reference_mul, single_operands), multiply(current_mul, single_operands));
+		print(std::to_string(2 * size) + " / " + n + " division",
+			divide(reference_div, long_operands, short_operands),
+			divide(current_div, long_operands, short_operands));
+		print(n + " / " + n + " division",
+			divide(reference_div, short_operands, euclid_operands),
+			divide(current_div, short_operands, euclid_operands));
+		print(std::to_string(2 * size) + " / 1 division",
+			divide(reference_div, long_operands, single_operands),
+			divide(current_div, long_operands, single_operands));
+		print(std::to_string(2 * size) + " / 2^k division",
+			divide(reference_div, long_operands, powers_of_2),
+			divide(current_div, long_operands, powers_of_2));
+	}
+}
+
+bool bigint_test(bigint_test_parameters const& params)
+{
+	auto const seed = params.use_seed ? params.seed : generate_correctly_seeded_mt19937_64()();
+	std::mt19937_64 rg{ seed };
+
+	std::cout << "Comparing bigint arithmetic with the reference implementation over " <<
+		params.number_of_random_inputs << " random inputs per operation (seed " << seed << ")...\n";
+
+	std::size_t number_of_reported_failures = 0;
+	std::size_t number_of_failures = 0;
+	number_of_failures += test_known_answers<18>(params, number_of_reported_failures);
+	number_of_failures += test_random_inputs<2>(rg, params, number_of_reported_failures);
+	number_of_failures += test_random_inputs<4>(rg, params, number_of_reported_failures);
+	number_of_failures += test_random_inputs<18>(rg, params, number_of_reported_failures);
+	number_of_failures += test_random_inputs<160>(rg, params, number_of_reported_failures);
+
+	if (params.measure) {
+		std::cout << "\nAverage time in nanoseconds; the sizes are in 64-bit elements.\n" <<
+			std::left << std::setw(28) << "operation" << std::right << std::setw(14) <<
+			"reference" << std::setw(14) << "current" << std::setw(10) << "speedup" << "\n";
+		measure<4>(rg, params);
+		measure<18>(rg, params);
+		measure<64>(rg, params);
+		measure<256>(rg, params);
+	}
+
+	return number_of_failures == 0;
+}
+
+void bigint_test(std::size_t number_of_random_inputs)
+{
+	std::cout << "[Testing bigint arithmetic against the reference implementation...]\n";
+	bigint_test_parameters params;
+	params.number_of_random_inputs = number_of_random_inputs;
+	params.measure = true;
+	bigint_test(params);
+	std::cout << "Done.\n\n\n";
+}
\ No newline at end of file
@@ -0,0 +1,290 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_GRISU_EXACT_EXACT_REFERENCE
+#define JKJ_GRISU_EXACT_EXACT_REFERENCE
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Slow but exact reference implementation of the shortest correctly rounded output,
+// computed directly from the definition with big integers
+// The rounding interval and the rule for breaking ties are given explicitly,
+// so that every policy of Grisu-Exact can be checked against it.
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../common/bigint.h"
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace exact_reference {
+	// Endpoint of the rounding interval of a nonzero finite float x, in magnitude
+	enum class endpoint {
+		value,		// |x| itself
+		midpoint,	// the midpoint between |x| and its adjacent float
+		neighbor	// the adjacent float
+	};
+
+	struct interval {
+		endpoint	left;
+		bool		include_left;
+		endpoint	right;
+		bool		include_right;
+	};
+
+	// How to choose among the shortest representations in the interval
+	enum class tie_rule {
+		any,		// any of them; no correct rounding
+		to_even,	// the nearest to |x|; ties to even significand
+		to_odd,		// the nearest to |x|; ties to odd significand
+		to_up,		// the nearest to |x|; ties to larger magnitude
+		to_down		// the nearest to |x|; ties to smaller magnitude
+	};
+
+	// significand * 10^exponent
+	struct decimal {
+		std::uint64_t	significand;
+		int				exponent;
+
+		// Remove trailing zeros of the significand
+		decimal normalized() const noexcept {
+			auto ret = *this;
+			if (ret.significand != 0) {
+				while (ret.significand % 10 == 0) {
+					ret.significand /= 10;
+					++ret.exponent;
+				}
+			}
+			return ret;
+		}
+
+		friend bool operator==(decimal const& x, decimal const& y) noexcept {
+			auto const nx = x.normalized();
+			auto const ny = y.normalized();
+			return nx.significand == ny.significand && nx.exponent == ny.exponent;
+		}
+		friend bool operator!=(decimal const& x, decimal const& y) noexcept {
+			return !(x == y);
+		}
+	};
+
+	// The shortest representations in the interval are m * 10^exponent for
+	// every m in [first, last]; nearest_below is floor(|x| / 10^exponent)
+	struct shortest_candidates {
+		int				exponent;
+		std::uint64_t	first;
+		std::uint64_t	last;
+		std::uint64_t	nearest_below;
+		// Position of |x| relative to nearest_below * 10^exponent and the next multiple
+		enum position_t {
+			exact, below_midpoint, midpoint, above_midpoint
+		} position;
+	};
+
+	namespace detail {
+		template <class Float>
+		struct float_info {
+			static constexpr int precision = std::numeric_limits<Float>::digits - 1;
+			static constexpr int min_exponent = std::numeric_limits<Float>::min_exponent - 1 - precision;
+			// Enough for every quotient computed below
+			using bigint_type = jkj::grisu_exact_detail::bigint<sizeof(Float) == 4 ? 512 : 2048>;
+			using carrier_uint = std::conditional_t<sizeof(Float) == 4, std::uint32_t, std::uint64_t>;
+		};
+
+		template <class Bigint>
+		void multiply_power_of_10(Bigint& n, int exp) {
+			constexpr std::uint64_t power_of_10_19 = 10000000000000000000ull;
+			for (; exp >= 19; exp -= 19) {
+				n *= power_of_10_19;
+			}
+			std::uint64_t power = 1;
+			for (; exp > 0; --exp) {
+				power *= 10;
+			}
+			n *= power;
+		}
+
+		template <class Bigint>
+		void multiply_power_of_2(Bigint& n, int exp) {
+			for (; exp >= 63; exp -= 63) {
+				n *= (std::uint64_t(1) << 63);
+			}
+			n *= (std::uint64_t(1) << exp);
+		}
+
+		// floor(n * 2^exp2 / 10^exp10); is_exact is set if the division has no remainder
+		// Precondition: the quotient fits in 64 bits
+		template <class Float>
+		std::uint64_t divide(std::uint64_t n, int exp2, int exp10, bool& is_exact) {
+			using bigint_type = typename float_info<Float>::bigint_type;
+			bigint_type numerator = n;
+			bigint_type denominator = 1;
+			multiply_power_of_2(exp2 >= 0 ? numerator : denominator, exp2 >= 0 ? exp2 : -exp2);
+			multiply_power_of_10(exp10 >= 0 ? denominator : numerator, exp10 >= 0 ? exp10 : -exp10);
+
+			auto const quotient = numerator.long_division(denominator);
+			assert(quotient.leading_one_pos.element_pos == 0);
+			is_exact = (numerator == 0);
+			return quotient.elements[0];
+		}
+	}
+
+	// Computes every shortest representation in the rounding interval of x
+	// Precondition: x is finite and nonzero
+	template <class Float>
+	shortest_candidates compute_shortest_candidates(Float x, interval const& itv) {
+		using info = detail::float_info<Float>;
+		using carrier_uint = typename info::carrier_uint;
+		assert(std::isfinite(x) && x != 0);
+
+		carrier_uint bits;
+		std::memcpy(&bits, &x, sizeof(Float));
+		auto const significand_bits = bits & ((carrier_uint(1) << info::precision) - 1);
+		auto const exponent_bits = int((bits << 1) >> (info::precision + 1));
+
+		// |x| = f * 2^e
+		std::uint64_t f = significand_bits;
+		int e = info::min_exponent;
+		if (exponent_bits != 0) {
+			f |= (std::uint64_t(1) << info::precision);
+			e += exponent_bits - 1;
+		}
+
+		// Everything is measured in units of 2^(e - 2): |x| = 4f, the distance to the next
+		// float is 4, and the distance to the previous float is 2 if it is in a lower binade
+		std::uint64_t const center = 4 * f;
+		std::uint64_t const distance_below =
+			(significand_bits == 0 && exponent_bits > 1) ? 2 : 4;
+		auto const unit_exponent = e - 2;
+
+		auto const left = center - (itv.left == endpoint::value ? 0 :
+			itv.left == endpoint::midpoint ? distance_below / 2 : distance_below);
+		auto const right = center + (itv.right == endpoint::value ? 0 :
+			itv.right == endpoint::midpoint ? 2 : 4);
+
+		// Multiples of 10^k in the interval are m * 10^k for m in [first, last]
+		auto const compute_range = [&](int k, std::uint64_t& first, std::uint64_t& last) {
+			bool is_exact;
+			first = detail::divide<Float>(left, unit_exponent, k, is_exact);
+			if (!is_exact || !itv.include_left || left == 0) {
+				++first;
+			}
+			last = detail::divide<Float>(right, unit_exponent, k, is_exact);
+			if (is_exact && !itv.include_right) {
+				if (last == 0) {
+					return false;
+				}
+				--last;
+			}
+			return first <= last;
+		};
+
+		// The interval is contained in (0, 2|x|], so there is no multiple of 10^k
+		// if 10^k > 2|x|; search downward from there
+		shortest_candidates ret;
+		int k = int(std::floor(std::log10(double(std::abs(x))))) + 2;
+		assert(!compute_range(k, ret.first, ret.last));
+		while (!compute_range(--k, ret.first, ret.last)) {}
+		ret.exponent = k;
+
+		// Find where |x| is, by computing floor(2|x| / 10^k)
+		bool is_exact;
+		auto const twice = detail::divide<Float>(2 * center, unit_exponent, k, is_exact);
+		ret.nearest_below = twice / 2;
+		if (twice % 2 == 0) {
+			ret.position = is_exact ? shortest_candidates::exact : shortest_candidates::below_midpoint;
+		}
+		else {
+			ret.position = is_exact ? shortest_candidates::midpoint : shortest_candidates::above_midpoint;
+		}
+		return ret;
+	}
+
+	// The representation chosen by the rule
+	// Precondition: rule != tie_rule::any
+	inline decimal choose(shortest_candidates const& c, tie_rule rule) {
+		assert(rule != tie_rule::any);
+
+		auto const below = c.nearest_below;
+		auto const above = below + 1;
+		std::uint64_t m;
+		if (c.last < below) {
+			m = c.last;
+		}
+		else if (c.first > below) {
+			m = c.first;
+		}
+		else if (above > c.last) {
+			m = below;
+		}
+		else {
+			switch (c.position) {
+			case shortest_candidates::exact:
+			case shortest_candidates::below_midpoint:
+				m = below;
+				break;
+
+			case shortest_candidates::above_midpoint:
+				m = above;
+				break;
+
+			default:
+				switch (rule) {
+				case tie_rule::to_even:
+					m = below % 2 == 0 ? below : above;
+					break;
+
+				case tie_rule::to_odd:
+					m = below % 2 != 0 ? below : above;
+					break;
+
+				case tie_rule::to_up:
+					m = above;
+					break;
+
+				default:
+					m = below;
+				}
+			}
+		}
+		return{ m, c.exponent };
+	}
+
+	// Checks if the given output is what the rule allows
+	inline bool is_allowed(shortest_candidates const& c, tie_rule rule, decimal output) {
+		if (rule != tie_rule::any) {
+			return output == choose(c, rule);
+		}
+
+		// Should be a multiple of 10^exponent in the interval
+		auto const n = output.normalized();
+		if (n.exponent < c.exponent || n.exponent - c.exponent > 19) {
+			return false;
+		}
+		auto m = n.significand;
+		for (int i = c.exponent; i < n.exponent; ++i) {
+			if (m > std::numeric_limits<std::uint64_t>::max() / 10) {
+				return false;
+			}
+			m *= 10;
+		}
+		return m >= c.first && m <= c.last;
+	}
+}
+
+#endif
\ No newline at end of file
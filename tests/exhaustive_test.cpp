@@ -0,0 +1,273 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// Check the output of Grisu-Exact for every binary32 bit pattern against Ryu,
+// and check that it reads back to the same float.
+// The bit patterns are divided into shards, which threads take in turn. Progress is
+// saved to a checkpoint file from time to time, so that an interrupted run can resume.
+
+#include "exhaustive_test.h"
+#include "../fp_to_chars.h"
+#include "../benchmark/ryu/ryu.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+	constexpr std::uint64_t shard_size = std::uint64_t(1) << 20;
+	constexpr char checkpoint_magic[] = "grisu-exact-exhaustive-binary32";
+	constexpr int checkpoint_version = 1;
+
+	float parse_float(char const* first, char const* last)
+	{
+#if defined(__cpp_lib_to_chars)
+		float value = 0;
+		std::from_chars(first, last, value);
+		return value;
+#else
+		static_cast<void>(last);
+		return std::strtof(first, nullptr);
+#endif
+	}
+
+	struct failure {
+		std::uint32_t	bit_pattern;
+		std::string		grisu_exact_output;
+		std::string		ryu_output;
+		char const*		reason;
+	};
+
+	// Returns nullptr if every check passes, or the description of the failed check
+	char const* check(std::uint32_t bit_pattern, char* grisu_exact_buffer, char* ryu_buffer)
+	{
+		float x;
+		std::memcpy(&x, &bit_pattern, sizeof(x));
+
+		auto const last = jkj::fp_to_chars_n(x, grisu_exact_buffer);
+		*last = '\0';
+		f2s_buffered(x, ryu_buffer);
+		if (std::string_view(grisu_exact_buffer) != std::string_view(ryu_buffer)) {
+			return "differs from Ryu";
+		}
+
+		if (std::isfinite(x)) {
+			auto const parsed = parse_float(grisu_exact_buffer, last);
+			if (std::memcmp(&parsed, &x, sizeof(x)) != 0) {
+				return "does not read back";
+			}
+		}
+		return nullptr;
+	}
+
+	// Returns an empty string on success, or an error message
+	// A missing file is not an error; progress then starts from the beginning
+	std::string read_checkpoint(std::string const& filename, std::uint64_t begin, std::uint64_t end,
+		std::uint64_t& next, std::uint64_t& number_of_failures)
+	{
+		std::ifstream in{ filename };
+		if (!in) {
+			return {};
+		}
+
+		std::string magic, key;
+		int version = 0;
+		std::uint64_t file_begin = 0, file_end = 0, file_next = 0, file_failures = 0;
+		in >> magic >> version >> key >> file_begin >> key >> file_end >>
+			key >> file_next >> key >> file_failures;
+		if (!in || magic != checkpoint_magic || version != checkpoint_version) {
+			return filename + " is not a valid checkpoint file";
+		}
+		if (file_begin != begin || file_end != end) {
+			return filename + " is a checkpoint of a different range";
+		}
+		if (file_next < begin || file_next > end) {
+			return filename + " is corrupted";
+		}
+		next = file_next;
+		number_of_failures = file_failures;
+		return {};
+	}
+
+	// Written into a temporary file first, so that an interruption cannot corrupt the checkpoint
+	bool write_checkpoint(std::string const& filename, std::uint64_t begin, std::uint64_t end,
+		std::uint64_t next, std::uint64_t number_of_failures)
+	{
+		auto const temporary_filename = filename + ".tmp";
+		{
+			std::ofstream out{ temporary_filename };
+			out << checkpoint_magic << " " << checkpoint_version << "\n" <<
+				"begin " << begin << "\n" << "end " << end << "\n" <<
+				"next " << next << "\n" << "failures " << number_of_failures << "\n";
+			if (!out) {
+				return false;
+			}
+		}
+		std::error_code ec;
+		std::filesystem::rename(temporary_filename, filename, ec);
+		return !ec;
+	}
+}
+
+bool exhaustive_test_float(exhaustive_test_parameters const& params)
+{
+	assert(params.begin <= params.end && params.end <= (std::uint64_t(1) << 32));
+
+	auto next = params.begin;
+	std::uint64_t number_of_previous_failures = 0;
+	if (!params.checkpoint_filename.empty()) {
+		auto const error = read_checkpoint(params.checkpoint_filename, params.begin, params.end,
+			next, number_of_previous_failures);
+		if (!error.empty()) {
+			std::cout << error << "\n";
+			return false;
+		}
+		if (next != params.begin) {
+			std::cout << "Resuming from 0x" << std::hex << std::setw(8) << std::setfill('0') <<
+				next << std::dec << std::setfill(' ') << " (" << number_of_previous_failures <<
+				" failures so far).\n";
+		}
+	}
+
+	auto const number_of_shards = (params.end - next + shard_size - 1) / shard_size;
+	auto const number_of_threads = std::max(std::size_t(1), params.number_of_threads);
+	std::cout << "Testing " << (params.end - next) << " bit patterns with " <<
+		number_of_threads << " threads...\n";
+
+	std::atomic<std::uint64_t> next_shard{ 0 };
+	std::atomic<std::uint64_t> number_of_failures{ 0 };
+	std::atomic<std::uint64_t> number_of_tested{ 0 };
+	std::vector<std::atomic<bool>> is_shard_done(number_of_shards);
+	std::mutex failures_mutex;
+	std::vector<failure> failures;
+
+	std::vector<std::thread> threads;
+	for (std::size_t thread_idx = 0; thread_idx < number_of_threads; ++thread_idx) {
+		threads.emplace_back([&] {
+			char grisu_exact_buffer[64];
+			char ryu_buffer[64];
+			for (auto shard = next_shard++; shard < number_of_shards; shard = next_shard++) {
+				auto const first = next + shard * shard_size;
+				auto const last = std::min(first + shard_size, params.end);
+				for (auto bit_pattern = first; bit_pattern != last; ++bit_pattern) {
+					auto const reason = check(std::uint32_t(bit_pattern),
+						grisu_exact_buffer, ryu_buffer);
+					if (reason) {
+						++number_of_failures;
+						std::lock_guard<std::mutex> lock{ failures_mutex };
+						if (failures.size() < params.max_number_of_reported_failures) {
+							failures.push_back({ std::uint32_t(bit_pattern),
+								grisu_exact_buffer, ryu_buffer, reason });
+						}
+					}
+				}
+				number_of_tested += last - first;
+				is_shard_done[shard] = true;
+			}
+		});
+	}
+
+	// Report progress and save the checkpoint until every shard is done
+	auto const start_time = std::chrono::steady_clock::now();
+	auto last_checkpoint_time = start_time;
+	std::uint64_t number_of_contiguous_done_shards = 0;
+	auto save_checkpoint = [&] {
+		while (number_of_contiguous_done_shards < number_of_shards &&
+			is_shard_done[number_of_contiguous_done_shards])
+		{
+			++number_of_contiguous_done_shards;
+		}
+		if (!params.checkpoint_filename.empty()) {
+			auto const checkpoint = std::min(next + number_of_contiguous_done_shards * shard_size,
+				params.end);
+			if (!write_checkpoint(params.checkpoint_filename, params.begin, params.end,
+				checkpoint, number_of_previous_failures + number_of_failures))
+			{
+				std::cout << "Warning: failed to write " << params.checkpoint_filename << ".\n";
+			}
+		}
+	};
+
+	auto const total = params.end - next;
+	while (number_of_tested != total) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		auto const now = std::chrono::steady_clock::now();
+		if (now - last_checkpoint_time < params.report_interval) {
+			continue;
+		}
+		last_checkpoint_time = now;
+
+		auto const tested = number_of_tested.load();
+		auto const seconds = std::chrono::duration<double>(now - start_time).count();
+		auto const values_per_second = double(tested) / seconds;
+		std::cout << std::fixed << std::setprecision(1) << std::setw(5) <<
+			100.0 * double(tested) / double(total) << "%, " << std::setprecision(2) <<
+			values_per_second / 1e6 << "M values/s, " << std::setprecision(0) <<
+			double(total - tested) / values_per_second << " s remaining, " <<
+			number_of_failures << " failures" << std::endl << std::defaultfloat << std::setprecision(6);
+		save_checkpoint();
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	save_checkpoint();
+
+	auto const seconds = std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - start_time).count();
+	std::cout << "Tested " << total << " bit patterns in " << std::fixed << std::setprecision(1) <<
+		seconds << " s (" << std::setprecision(2) << double(total) / seconds / 1e6 <<
+		"M values/s).\n" << std::defaultfloat << std::setprecision(6);
+
+	std::sort(failures.begin(), failures.end(), [](failure const& x, failure const& y) {
+		return x.bit_pattern < y.bit_pattern;
+	});
+	for (auto const& f : failures) {
+		std::cout << "Error detected! [0x" << std::hex << std::setw(8) << std::setfill('0') <<
+			f.bit_pattern << std::dec << std::setfill(' ') << ": Grisu-Exact = " <<
+			f.grisu_exact_output << ", Ryu = " << f.ryu_output << ", " << f.reason << "]\n";
+	}
+
+	auto const all_failures = number_of_previous_failures + number_of_failures;
+	if (all_failures == 0) {
+		std::cout << "Exhaustive test for float succeeded.\n";
+	}
+	else {
+		std::cout << "Exhaustive test for float failed with " << all_failures << " failures.\n";
+	}
+	return all_failures == 0;
+}
+
+void exhaustive_test_float(char const* checkpoint_filename)
+{
+	std::cout << "[Testing every float input...]\n";
+	exhaustive_test_parameters params;
+	params.checkpoint_filename = checkpoint_filename;
+	exhaustive_test_float(params);
+	std::cout << "Done.\n\n\n";
+}
\ No newline at end of file
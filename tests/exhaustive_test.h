@@ -0,0 +1,42 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_GRISU_EXACT_EXHAUSTIVE_TEST
+#define JKJ_GRISU_EXACT_EXHAUSTIVE_TEST
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+struct exhaustive_test_parameters {
+	// Bit patterns in [begin, end) are tested
+	std::uint64_t begin = 0;
+	std::uint64_t end = std::uint64_t(1) << 32;
+	std::size_t number_of_threads = std::thread::hardware_concurrency();
+	// Resume from this file if it exists, and save progress into it; no checkpoint if empty
+	std::string checkpoint_filename;
+	// Progress is printed and saved this often
+	std::chrono::steady_clock::duration report_interval = std::chrono::seconds(10);
+	std::size_t max_number_of_reported_failures = 100;
+};
+
+// Returns true if there is no failure, including those recorded in the checkpoint
+bool exhaustive_test_float(exhaustive_test_parameters const& params);
+
+#endif
\ No newline at end of file
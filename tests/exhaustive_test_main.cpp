@@ -0,0 +1,98 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// Stand-alone driver of the exhaustive test for binary32
+// tests/main.cpp remains the entry point for the Visual Studio project;
+// this one is used for the CMake target grisu_exact_exhaustive_test.
+//
+// Exit code: 0 if every tested float passes, 1 if any fails or the checkpoint is invalid,
+// 2 on invalid options.
+
+#include "exhaustive_test.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+namespace {
+	void print_usage(char const* program_name)
+	{
+		std::cout << "Usage: " << program_name << " [options]\n"
+			"  --begin B             first bit pattern to test (default: 0)\n"
+			"  --end E               one past the last bit pattern to test (default: 0x100000000)\n"
+			"  --threads N           number of threads (default: the number of hardware threads)\n"
+			"  --checkpoint F        resume from F if it exists, and save progress into F\n"
+			"  --report-interval S   print and save progress every S seconds (default: 10)\n"
+			"  --max-failures N      number of failures printed (default: 100)\n"
+			"  --help                print this message\n"
+			"Numbers can be written in hexadecimal with the prefix 0x.\n";
+	}
+}
+
+int main(int argc, char** argv)
+{
+	exhaustive_test_parameters params;
+
+	for (int i = 1; i < argc; ++i) {
+		std::string_view arg = argv[i];
+		auto next_number = [&]() -> std::uint64_t {
+			if (i + 1 >= argc) {
+				std::cerr << "Missing value for " << arg << "\n";
+				std::exit(2);
+			}
+			return std::uint64_t(std::stoull(argv[++i], nullptr, 0));
+		};
+
+		if (arg == "--begin") {
+			params.begin = next_number();
+		}
+		else if (arg == "--end") {
+			params.end = next_number();
+		}
+		else if (arg == "--threads") {
+			params.number_of_threads = std::size_t(next_number());
+		}
+		else if (arg == "--checkpoint") {
+			if (i + 1 >= argc) {
+				std::cerr << "Missing value for " << arg << "\n";
+				return 2;
+			}
+			params.checkpoint_filename = argv[++i];
+		}
+		else if (arg == "--report-interval") {
+			params.report_interval = std::chrono::seconds(next_number());
+		}
+		else if (arg == "--max-failures") {
+			params.max_number_of_reported_failures = std::size_t(next_number());
+		}
+		else if (arg == "--help") {
+			print_usage(argv[0]);
+			return EXIT_SUCCESS;
+		}
+		else {
+			std::cerr << "Unknown option: " << arg << "\n";
+			print_usage(argv[0]);
+			return 2;
+		}
+	}
+	if (params.begin > params.end || params.end > (std::uint64_t(1) << 32)) {
+		std::cerr << "The range must satisfy begin <= end <= 0x100000000\n";
+		return 2;
+	}
+
+	return exhaustive_test_float(params) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
@@ -0,0 +1,220 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// Test fp_to_chars_fixed: the output without grouping should read back to the input, and
+// the output with a locale should be the same as the output without grouping, with the
+// decimal point replaced and the grouping separators inserted into the integer part.
+// The inputs are the special values, the powers of 10 and numbers with several digits
+// over the whole range of the exponent, the smallest and largest subnormal and normal
+// numbers, and uniformly random finite numbers.
+
+#include "fixed_notation_test.h"
+#include "../common/random_float.h"
+#include "../fp_to_chars.h"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+	template <class Float>
+	Float parse_float(char const* str)
+	{
+		if constexpr (std::is_same_v<Float, float>) {
+			return std::strtof(str, nullptr);
+		}
+		else {
+			return std::strtod(str, nullptr);
+		}
+	}
+
+	// Several group sizes and separators, and locales without grouping
+	jkj::fp_fixed_locale const locales[] = {
+		{ ',', '.', 3 },
+		{ '.', ',', 3 },
+		{ '.', '\'', 4 },
+		{ '.', ' ', 2 },
+		{ ',', '_', 1 },
+		{ ',', '\0', 3 },
+		{ '.', ',', 0 }
+	};
+
+	// Reference: the output without grouping with the given locale applied
+	std::string apply_locale(std::string str, jkj::fp_fixed_locale const& locale)
+	{
+		auto const integer_first = std::size_t(str[0] == '-' ? 1 : 0);
+		auto integer_last = str.find('.');
+		if (integer_last == std::string::npos) {
+			integer_last = str.size();
+		}
+		else {
+			str[integer_last] = locale.decimal_point;
+		}
+		if (locale.grouping_separator != '\0' && locale.grouping_size != 0) {
+			for (auto pos = integer_last; pos > integer_first + locale.grouping_size;) {
+				pos -= locale.grouping_size;
+				str.insert(pos, 1, locale.grouping_separator);
+			}
+		}
+		return str;
+	}
+
+	template <class Float>
+	class fixed_notation_checker {
+	public:
+		fixed_notation_checker(fixed_notation_test_parameters const& params,
+			char const* type_name_string) :
+			params_{ params }, type_name_string_{ type_name_string } {}
+
+		std::size_t number_of_failures() const noexcept {
+			return number_of_failures_;
+		}
+
+		void check(Float x)
+		{
+			char scientific[jkj::fp_to_chars_max_length<Float> + 1];
+			char fixed[jkj::fp_to_chars_fixed_max_length<Float> + 1];
+			jkj::fp_to_chars(x, scientific);
+			jkj::fp_to_chars_fixed(x, fixed);
+
+			// No exponent, and the same number as the scientific output
+			auto const parsed = parse_float<Float>(fixed);
+			if (std::string_view(fixed).find('E') != std::string_view::npos ||
+				parsed != parse_float<Float>(scientific) || parsed != x ||
+				std::signbit(parsed) != std::signbit(x))
+			{
+				report(scientific, "", fixed, "the same number in the fixed-point notation");
+				return;
+			}
+
+			for (auto const& locale : locales) {
+				char localized[jkj::fp_to_chars_fixed_max_length<Float> + 1];
+				jkj::fp_to_chars_fixed(x, localized, locale);
+
+				auto const expected = apply_locale(fixed, locale);
+				if (expected != localized) {
+					report(scientific, locale_string(locale).c_str(), localized, expected.c_str());
+				}
+			}
+		}
+
+	private:
+		static std::string locale_string(jkj::fp_fixed_locale const& locale)
+		{
+			std::string ret = " with the locale { '";
+			ret += locale.decimal_point;
+			ret += "', ";
+			if (locale.grouping_separator == '\0') {
+				ret += "'\\0'";
+			}
+			else {
+				ret += '\'';
+				ret += locale.grouping_separator;
+				ret += '\'';
+			}
+			ret += ", " + std::to_string(locale.grouping_size) + " }";
+			return ret;
+		}
+
+		void report(char const* input, char const* locale, char const* output,
+			char const* expected)
+		{
+			if (number_of_failures_++ < params_.max_number_of_reported_failures) {
+				std::cout << "Error detected! [" << type_name_string_ << " " << input <<
+					locale << ": " << output << ", expected " << expected << "]\n";
+			}
+		}
+
+		fixed_notation_test_parameters const&	params_;
+		char const*								type_name_string_;
+		std::size_t								number_of_failures_ = 0;
+	};
+
+	template <class Float>
+	std::vector<Float> special_inputs()
+	{
+		using limits = std::numeric_limits<Float>;
+		std::vector<Float> ret = {
+			Float(0), Float(1), Float(10), Float(1234567), Float(0.1), Float(0.001),
+			limits::denorm_min(), Float(3) * limits::denorm_min(),
+			Float(1000) * limits::denorm_min(),
+			// Largest subnormal number
+			limits::min() - limits::denorm_min(),
+			limits::min(), limits::max()
+		};
+
+		// Small and large numbers over the whole range of the exponent
+		for (int e = limits::min_exponent10 - limits::digits10 - 1;
+			e <= limits::max_exponent10; ++e)
+		{
+			for (char const* significand : { "1", "1.5", "9.87654321", "1.23456789012345" }) {
+				auto const x = parse_float<Float>(
+					(std::string(significand) + "e" + std::to_string(e)).c_str());
+				if (x != 0 && std::isfinite(x)) {
+					ret.push_back(x);
+				}
+			}
+		}
+		return ret;
+	}
+
+	template <class Float>
+	std::size_t test_fixed_notation(fixed_notation_test_parameters const& params,
+		std::mt19937_64& rg, char const* type_name_string)
+	{
+		fixed_notation_checker<Float> checker{ params, type_name_string };
+		for (auto const x : special_inputs<Float>()) {
+			checker.check(x);
+			checker.check(-x);
+		}
+		for (std::size_t i = 0; i < params.number_of_random_inputs; ++i) {
+			auto const x = uniformly_randomly_generate_finite_float<Float>(rg);
+			checker.check(x);
+			checker.check(-x);
+		}
+
+		std::cout << "Fixed-point notation for " << type_name_string << ": " <<
+			checker.number_of_failures() << " failures.\n";
+		return checker.number_of_failures();
+	}
+}
+
+bool fixed_notation_test(fixed_notation_test_parameters const& params)
+{
+	auto const seed = params.use_seed ? params.seed : generate_correctly_seeded_mt19937_64()();
+	std::mt19937_64 rg{ seed };
+
+	std::cout << "Testing the fixed-point notation with " << params.number_of_random_inputs <<
+		" random inputs of both signs (seed " << seed << ")...\n";
+
+	std::size_t number_of_failures = test_fixed_notation<float>(params, rg, "float");
+	number_of_failures += test_fixed_notation<double>(params, rg, "double");
+	return number_of_failures == 0;
+}
+
+void fixed_notation_test(std::size_t number_of_random_inputs)
+{
+	std::cout << "[Testing the fixed-point notation...]\n";
+	fixed_notation_test_parameters params;
+	params.number_of_random_inputs = number_of_random_inputs;
+	fixed_notation_test(params);
+	std::cout << "Done.\n\n\n";
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_GRISU_EXACT_FIXED_NOTATION_TEST
+#define JKJ_GRISU_EXACT_FIXED_NOTATION_TEST
+
+#include <cstddef>
+#include <cstdint>
+
+struct fixed_notation_test_parameters {
+	// In addition to the special values; every input is tested with both signs
+	std::size_t number_of_random_inputs = 100000;
+	// Drawn from std::random_device if not given
+	bool use_seed = false;
+	std::uint64_t seed = 0;
+	std::size_t max_number_of_reported_failures = 100;
+};
+
+// Returns true if every output is as expected
+bool fixed_notation_test(fixed_notation_test_parameters const& params);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,77 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// Stand-alone driver of the test of the fixed-point notation
+// tests/main.cpp remains the entry point for the Visual Studio project;
+// this one is used for the CMake target grisu_exact_fixed_notation_test.
+//
+// Exit code: 0 if every output is as expected, 1 if any is not, 2 on invalid options.
+
+#include "fixed_notation_test.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+namespace {
+	void print_usage(char const* program_name)
+	{
+		std::cout << "Usage: " << program_name << " [options]\n"
+			"  --random-inputs N     number of random inputs per type (default: 100000)\n"
+			"  --seed S              generate the inputs from the seed S instead of random_device\n"
+			"  --max-failures N      number of failures printed (default: 100)\n"
+			"  --help                print this message\n";
+	}
+}
+
+int main(int argc, char** argv)
+{
+	fixed_notation_test_parameters params;
+
+	for (int i = 1; i < argc; ++i) {
+		std::string_view arg = argv[i];
+		auto next_number = [&]() -> std::uint64_t {
+			if (i + 1 >= argc) {
+				std::cerr << "Missing value for " << arg << "\n";
+				std::exit(2);
+			}
+			return std::uint64_t(std::stoull(argv[++i]));
+		};
+
+		if (arg == "--random-inputs") {
+			params.number_of_random_inputs = std::size_t(next_number());
+		}
+		else if (arg == "--seed") {
+			params.use_seed = true;
+			params.seed = next_number();
+		}
+		else if (arg == "--max-failures") {
+			params.max_number_of_reported_failures = std::size_t(next_number());
+		}
+		else if (arg == "--help") {
+			print_usage(argv[0]);
+			return EXIT_SUCCESS;
+		}
+		else {
+			std::cerr << "Unknown option: " << arg << "\n";
+			print_usage(argv[0]);
+			return 2;
+		}
+	}
+
+	return fixed_notation_test(params) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
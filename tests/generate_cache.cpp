@@ -15,97 +15,42 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
 // KIND, either express or implied.
 
-#include "bigint.h"
-#include <array>
+#include "verify.h"
+#include "../common/bigint.h"
 #include <bitset>
-#include <type_traits>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <vector>
 
 namespace jkj {
 	namespace grisu_exact_detail {
-		template <class Float>
-		struct bitset_to_uint;
-
-		template <>
-		struct bitset_to_uint<float> {
-			static_assert(sizeof(float) * std::numeric_limits<unsigned char>::digits == 32);
-
-			static std::uint64_t convert(std::bitset<64> const& bs) noexcept
-			{
-				static_assert(std::is_same_v<unsigned long long, std::uint64_t>);
-				return bs.to_ullong();
-			}
-		};
-
-		template <>
-		struct bitset_to_uint<double> {
-			static_assert(sizeof(double) * std::numeric_limits<unsigned char>::digits == 64);
-
-			static uint128 convert(std::bitset<128> const& bs) noexcept
-			{
-				static_assert(std::is_same_v<unsigned long long, std::uint64_t>);
-				std::bitset<64> temp;
-
-				for (std::size_t i = 0; i < 64; ++i)
-					temp[i] = bs[i];
-				auto low = temp.to_ullong();
-
-				for (std::size_t i = 0; i < 64; ++i)
-					temp[i] = bs[i + 64];
-				auto high = temp.to_ullong();
+		// The leading precision bits of n
+		template <std::size_t precision, std::size_t array_size>
+		std::bitset<precision> get_upper_bits(bigint_impl<array_size> const& n)
+		{
+			std::bitset<precision> upper_bits;
 
-				return{ high, low };
+			std::size_t remaining = precision;
+			if (n.leading_one_pos.bit_pos >= precision) {
+				upper_bits = n.elements[n.leading_one_pos.element_pos] >>
+					(n.leading_one_pos.bit_pos - precision);
 			}
-		};
-		
-		template <std::size_t precision, int min_k, int max_k>
-		std::array<std::bitset<precision>, std::size_t(max_k - min_k + 1)> generate_cache_bitset()
-		{
-			static_assert(max_k + min_k >= 0 && min_k <= 0 && max_k >= 0);
-			constexpr auto power_of_5_max_bits = std::size_t(floor_log2_pow10(max_k) - max_k + 1);
-			using bigint_type = bigint<power_of_5_max_bits>;
-			
-			auto get_upper_bits = [](bigint_type const& n) {
-				std::bitset<precision> upper_bits;
-
-				std::size_t remaining = precision;
-				if (n.leading_one_pos.bit_pos >= precision) {
-					upper_bits = n.elements[n.leading_one_pos.element_pos] >>
-						(n.leading_one_pos.bit_pos - precision);
+			else {
+				auto mask = bigint_base::element_type(1) << (n.leading_one_pos.bit_pos - 1);
+
+				for (std::size_t idx = precision - 1;
+					idx >= precision - n.leading_one_pos.bit_pos; --idx)
+				{
+					upper_bits[idx] =
+						(n.elements[n.leading_one_pos.element_pos] & mask) == 0 ? false : true;
+					mask >>= 1;
 				}
-				else {
-					auto mask = bigint_base::element_type(1) << (n.leading_one_pos.bit_pos - 1);
-
-					for (std::size_t idx = precision - 1;
-						idx >= precision - n.leading_one_pos.bit_pos; --idx)
-					{
-						upper_bits[idx] =
-							(n.elements[n.leading_one_pos.element_pos] & mask) == 0 ? false : true;
-						mask >>= 1;
-					}
-					remaining -= n.leading_one_pos.bit_pos;
-
-					std::size_t element_idx = n.leading_one_pos.element_pos;
-					while (remaining >= bigint_base::element_number_of_bits) {
-						if (element_idx == 0) {
-							for (std::size_t i = 0; i < remaining; ++i)
-								upper_bits.reset(i);
-							return upper_bits;
-						}
-						--element_idx;
-
-						mask = bigint_base::element_type(1) << (bigint_base::element_number_of_bits - 1);
-						for (std::size_t idx = remaining - 1;
-							idx > remaining - bigint_base::element_number_of_bits; --idx)
-						{
-							upper_bits[idx] =
-								(n.elements[element_idx] & mask) == 0 ? false : true;
-							mask >>= 1;
-						}
-						remaining -= bigint_base::element_number_of_bits;
-						upper_bits[remaining] =
-							(n.elements[element_idx] & mask) == 0 ? false : true;
-					}
+				remaining -= n.leading_one_pos.bit_pos;
 
+				std::size_t element_idx = n.leading_one_pos.element_pos;
+				while (remaining >= bigint_base::element_number_of_bits) {
 					if (element_idx == 0) {
 						for (std::size_t i = 0; i < remaining; ++i)
 							upper_bits.reset(i);
@@ -113,159 +58,234 @@ namespace jkj {
 					}
 					--element_idx;
 
-					mask = bigint_base::element_type(1) <<
-						(bigint_base::element_number_of_bits - remaining);
-					for (std::size_t idx = 0; idx < remaining; ++idx) {
+					mask = bigint_base::element_type(1) << (bigint_base::element_number_of_bits - 1);
+					for (std::size_t idx = remaining - 1;
+						idx > remaining - bigint_base::element_number_of_bits; --idx)
+					{
 						upper_bits[idx] =
 							(n.elements[element_idx] & mask) == 0 ? false : true;
-						mask <<= 1;
+						mask >>= 1;
 					}
+					remaining -= bigint_base::element_number_of_bits;
+					upper_bits[remaining] =
+						(n.elements[element_idx] & mask) == 0 ? false : true;
 				}
 
-				return upper_bits;
-			};
-
-			using return_type = std::array<std::bitset<precision>, std::size_t(max_k - min_k + 1)>;
-			return_type ret;
-			auto cache = [&ret](int k) -> std::bitset<precision>& {
-				return ret[std::size_t(k - min_k)];
-			};
-
-			bigint_type power_of_5 = 1;
-
-			cache(0) = get_upper_bits(power_of_5);
-
-			int k = 1;
-			for (; k <= -min_k; ++k) {
-				power_of_5.multiply_5();
-
-				// Compute positive power
-				// - Compute 5^k
-				cache(k) = get_upper_bits(power_of_5);
-
-				// Compute negative power
-				// - Again, we can factor out 2^-k part by decrementing the exponent by k
-				// - To compute 1/5^k, set d = 1 and repeat the following procedure:
-				//   - Find the minimum n >= 0 such that d * 2^n >= 5^k; this means that d/5^k >= 1/2^n,
-				//     thus the nth digit of the binary expansion of d/5^k is 1
-				//   - Set d = d * 2^n - 5^k; this effectively calculates d/5^k - 1/2^n
-				//   - Now we conclude that the next (n-1) digits of the binary expansion of 1/5^k are zero,
-				//     while the next digit is one
-				//   - Repeat until reaching the maximum precision
-				bigint_type dividend = 1;
-				dividend.multiply_2_until(power_of_5);
-				std::bitset<precision> negative_power_digits = 1;
-
-				std::size_t accumulated_exp = 0;
-				while (true) {
-					dividend -= power_of_5;
-					auto new_exp = dividend.multiply_2_until(power_of_5);
-
-					accumulated_exp += new_exp;
-					if (accumulated_exp >= precision) {
-						negative_power_digits <<= (precision - 1 - (accumulated_exp - new_exp));
-						break;
-					}
+				if (element_idx == 0) {
+					for (std::size_t i = 0; i < remaining; ++i)
+						upper_bits.reset(i);
+					return upper_bits;
+				}
+				--element_idx;
+
+				mask = bigint_base::element_type(1) <<
+					(bigint_base::element_number_of_bits - remaining);
+				for (std::size_t idx = 0; idx < remaining; ++idx) {
+					upper_bits[idx] =
+						(n.elements[element_idx] & mask) == 0 ? false : true;
+					mask <<= 1;
+				}
+			}
 
-					negative_power_digits <<= new_exp;
-					negative_power_digits.set(0);
+			return upper_bits;
+		}
+
+		// The leading precision bits of 1/5^k, factoring out 2^-k
+		template <std::size_t precision, std::size_t array_size>
+		std::bitset<precision> get_upper_bits_of_reciprocal(bigint_impl<array_size> const& power_of_5)
+		{
+			using bigint_type = bigint_impl<array_size>;
+
+			// Compute negative power
+			// - Again, we can factor out 2^-k part by decrementing the exponent by k
+			// - To compute 1/5^k, set d = 1 and repeat the following procedure:
+			//   - Find the minimum n >= 0 such that d * 2^n >= 5^k; this means that d/5^k >= 1/2^n,
+			//     thus the nth digit of the binary expansion of d/5^k is 1
+			//   - Set d = d * 2^n - 5^k; this effectively calculates d/5^k - 1/2^n
+			//   - Now we conclude that the next (n-1) digits of the binary expansion of 1/5^k are zero,
+			//     while the next digit is one
+			//   - Repeat until reaching the maximum precision
+			bigint_type dividend = 1;
+			dividend.multiply_2_until(power_of_5);
+			std::bitset<precision> negative_power_digits = 1;
+
+			std::size_t accumulated_exp = 0;
+			while (true) {
+				dividend -= power_of_5;
+				auto new_exp = dividend.multiply_2_until(power_of_5);
+
+				accumulated_exp += new_exp;
+				if (accumulated_exp >= precision) {
+					negative_power_digits <<= (precision - 1 - (accumulated_exp - new_exp));
+					break;
 				}
 
-				cache(-k) = negative_power_digits;
+				negative_power_digits <<= new_exp;
+				negative_power_digits.set(0);
 			}
 
-			// Compute remaining positive powers
-			for (; k <= max_k; ++k) {
-				power_of_5.multiply_5();
-				cache(k) = get_upper_bits(power_of_5);
+			return negative_power_digits;
+		}
+
+		// The cache entries for k in [min_k, max_k], truncated
+		// The powers of 5 are computed first, and then the entries are computed in parallel.
+		template <std::size_t precision, std::size_t array_size>
+		std::vector<std::bitset<precision>> generate_cache_bitset(verify_parameters const& params,
+			int min_k, int max_k)
+		{
+			assert(min_k <= 0 && max_k >= 0);
+			using bigint_type = bigint_impl<array_size>;
+
+			std::vector<bigint_type> powers_of_5(std::size_t(std::max(-min_k, max_k) + 1));
+			powers_of_5[0] = 1;
+			for (std::size_t i = 1; i < powers_of_5.size(); ++i) {
+				powers_of_5[i] = powers_of_5[i - 1];
+				powers_of_5[i].multiply_5();
 			}
 
+			std::vector<std::bitset<precision>> ret(std::size_t(max_k - min_k + 1));
+			parallel_for(ret.size(), params.number_of_threads, [&](std::size_t idx) {
+				auto const k = min_k + int(idx);
+				if (k >= 0) {
+					ret[idx] = get_upper_bits<precision>(powers_of_5[std::size_t(k)]);
+				}
+				else {
+					ret[idx] = get_upper_bits_of_reciprocal<precision>(powers_of_5[std::size_t(-k)]);
+				}
+			});
 			return ret;
 		}
+
+		// 64-bit words of a cache entry, from the most significant one
+		template <std::size_t precision>
+		std::vector<std::uint64_t> to_words(std::bitset<precision> const& bits)
+		{
+			std::vector<std::uint64_t> words((precision + 63) / 64, 0);
+			for (std::size_t idx = 0; idx < precision; ++idx) {
+				if (bits[idx]) {
+					words[words.size() - 1 - idx / 64] |= std::uint64_t(1) << (idx % 64);
+				}
+			}
+			return words;
+		}
+		inline std::vector<std::uint64_t> to_words(std::uint64_t value)
+		{
+			return{ value };
+		}
+		inline std::vector<std::uint64_t> to_words(uint128 const& value)
+		{
+			return{ value.high(), value.low() };
+		}
+
+		// Compare with the cache of the parameters Grisu-Exact is instantiated with
+		template <class Float, class Parameters>
+		bool compare_with_instantiated_cache(std::vector<std::vector<std::uint64_t>> const& cache)
+		{
+			using info = common_info<Float, Parameters>;
+
+			for (int k = info::min_k; k <= info::max_k; ++k) {
+				if (cache[std::size_t(k - info::min_k)] != to_words(get_cache<Float, Parameters>(k))) {
+					std::cout << "The generated cache differs from the one in use at k = " << k << "!\n";
+					return false;
+				}
+			}
+			std::cout << "The generated cache agrees with the one in use.\n";
+			return true;
+		}
 	}
 }
 
-#include <fstream>
-#include <iomanip>
-#include <iostream>
-
-void generate_cache()
+bool generate_cache(verify_parameters const& params, verify_format const& format)
 {
-	std::cout << "[Generating cache...]\n";
-
 	using namespace jkj::grisu_exact_detail;
 
-	auto write_file = [](std::ofstream& out,
-		auto type_tag,
-		auto const& cache_bitset,
-		auto&& cache_type_name_string,
-		auto&& ieee_754_type_name_string,
-		auto&& detect_overflow_and_increment,		
-		auto&& element_printer)
-	{
-		using float_type = typename decltype(type_tag)::float_type;
-
-		out << "static constexpr " << cache_type_name_string << " cache[] = {";
-		for (int k = common_info<float_type>::min_k; k < 0; ++k) {
-			auto idx = std::size_t(k - common_info<float_type>::min_k);
-			auto value = bitset_to_uint<float_type>::convert(cache_bitset[idx]);
-
-			if (detect_overflow_and_increment(value)) {
-				std::cout << "Overflow detected while generating caches for " <<
-					ieee_754_type_name_string << "!\n";
+	// The leading bits of 5^k and 2 * 5^-k, where k has the maximum magnitude
+	auto const max_bits = std::size_t(
+		floor_log2_pow10(std::max(-format.min_k, format.max_k)) - std::max(-format.min_k, format.max_k) + 2);
+
+	// Every entry as 64-bit words, from the most significant one
+	auto generate = [&](auto precision) {
+		return with_number_of_elements(max_bits, [&](auto array_size) {
+			auto const cache_bitset = generate_cache_bitset<decltype(precision)::value,
+				decltype(array_size)::value>(params, format.min_k, format.max_k);
+
+			std::vector<std::vector<std::uint64_t>> cache;
+			for (auto const& bits : cache_bitset) {
+				cache.push_back(to_words(bits));
 			}
-			out << "\n\t";
-			element_printer(out, value);
-			out << ",";
+			return cache;
+		});
+	};
+	std::vector<std::vector<std::uint64_t>> cache;
+	if (format.cache_precision == 32) {
+		cache = generate(std::integral_constant<std::size_t, 32>{});
+	}
+	else if (format.cache_precision == 64) {
+		cache = generate(std::integral_constant<std::size_t, 64>{});
+	}
+	else {
+		assert(format.cache_precision == 128);
+		cache = generate(std::integral_constant<std::size_t, 128>{});
+	}
 
-		}
-		for (int k = 0; k < common_info<float_type>::max_k; ++k) {
-			auto idx = std::size_t(k - common_info<float_type>::min_k);
+	bool succeeded = true;
+
+	// Round up the entries for negative k
+	for (int k = format.min_k; k < 0; ++k) {
+		auto& words = cache[std::size_t(k - format.min_k)];
+		auto const mask = format.cache_precision < 64 ?
+			(std::uint64_t(1) << format.cache_precision) - 1 : ~std::uint64_t(0);
 
-			out << "\n\t";
-			element_printer(out, bitset_to_uint<float_type>::convert(cache_bitset[idx]));
-			out << ",";
+		auto idx = words.size();
+		do {
+			--idx;
+			words[idx] = (words[idx] + 1) & mask;
+		} while (words[idx] == 0 && idx != 0);
+
+		if (words[0] == 0) {
+			std::cout << "Overflow detected while generating caches for " << format.name << "!\n";
+			succeeded = false;
 		}
+	}
+
+	auto const filename = params.output_directory + "/" + format.name + "_generated_cache.txt";
+	std::ofstream out{ filename };
+	if (!out) {
+		std::cout << "Cannot open " << filename << ".\n";
+		return false;
+	}
+	auto const cache_type_name_string = format.cache_precision == 32 ? "std::uint32_t" :
+		format.cache_precision == 64 ? "std::uint64_t" : "uint128";
+	out << "static constexpr " << cache_type_name_string << " cache[] = {" <<
+		std::hex << std::setfill('0');
+	for (std::size_t idx = 0; idx < cache.size(); ++idx) {
 		out << "\n\t";
-		element_printer(out, bitset_to_uint<float_type>::convert(cache_bitset.back()));
-		out << "\n};";
-	};
+		if (format.cache_precision == 128) {
+			out << "{ 0x" << std::setw(16) << cache[idx][0] << ", 0x" << std::setw(16) << cache[idx][1] << " }";
+		}
+		else {
+			out << "0x" << std::setw(format.cache_precision / 4) << cache[idx][0];
+		}
+		out << (idx + 1 == cache.size() ? "" : ",");
+	}
+	out << "\n};";
+	std::cout << "Written into " << filename << ".\n";
 
-	std::ofstream out;
-
-	out.open("test_results/binary32_generated_cache.txt");
-	auto binary32_cache_bitset = generate_cache_bitset<
-		common_info<float>::cache_precision,
-		common_info<float>::min_k,
-		common_info<float>::max_k>();
-	write_file(out, common_info<float>{}, binary32_cache_bitset,
-		"std::uint64_t", "binary32",
-		[](std::uint64_t& value) {
-			++value;
-			return value == 0;
-		},
-		[](std::ofstream& out, std::uint64_t value) {
-			out << "0x" << std::hex << std::setw(16) << std::setfill('0') << value;
-		});
-	out.close();
-
-	out.open("test_results/binary64_generated_cache.txt");
-	auto binary64_cache_bitset = generate_cache_bitset<
-		common_info<double>::cache_precision,
-		common_info<double>::min_k,
-		common_info<double>::max_k>();
-	write_file(out, common_info<double>{}, binary64_cache_bitset,
-		"uint128", "binary64",
-		[](uint128& value) {
-			value = uint128(value.high(), value.low() + 1);
-			return value.low() == 0;
-		},
-		[](std::ofstream& out, uint128 const& value) {
-			out << "{ 0x" << std::hex << std::setw(16) << std::setfill('0') << value.high()
-				<< ", 0x" << std::hex << std::setw(16) << std::setfill('0') << value.low()
-				<< " }";
-		});
-	out.close();
+	visit_instantiated_parameters(format, [&](auto tag) {
+		using tag_type = decltype(tag);
+		succeeded = compare_with_instantiated_cache<typename tag_type::float_type,
+			typename tag_type::parameters>(cache) && succeeded;
+	});
+
+	return succeeded;
+}
+
+void generate_cache()
+{
+	std::cout << "[Generating cache...]\n";
+
+	generate_cache(verify_parameters{}, builtin_format<float>("binary32"));
+	generate_cache(verify_parameters{}, builtin_format<double>("binary64"));
 
 	std::cout << "Done.\n\n\n";
 }
\ No newline at end of file
@@ -41,6 +41,12 @@ extern void verify_correct_rounding_bound();
 //#define VERIFY_INCORRECT_ROUNDING_REMOVAL
 extern void verify_incorrect_rounding_removal();
 
+// Test the bigint arithmetic used by the verifications above against the reference
+// implementation, and compare their speed
+//#define BIGINT_TEST
+static std::size_t number_of_bigint_tests = 10000;
+extern void bigint_test(std::size_t number_of_random_inputs);
+
 // Generate random float's and test Grisu-Exact's output
 //#define UNIFORM_RANDOM_TEST_FLOAT
 static std::size_t number_of_uniform_random_tests_float = 10000000;
@@ -51,6 +57,43 @@ extern void uniform_random_test_float(std::size_t number_of_tests);
 static std::size_t number_of_uniform_random_tests_double = 10000000;
 extern void uniform_random_test_double(std::size_t number_of_tests);
 
+// Test Grisu-Exact's output with float samples from a file written by grisu_exact_samples
+//#define SAMPLE_FILE_TEST_FLOAT
+static char const* sample_file_test_filename_float = "samples_binary32.bin";
+extern void sample_file_test_float(char const* filename);
+
+// Test Grisu-Exact's output with double samples from a file written by grisu_exact_samples
+//#define SAMPLE_FILE_TEST_DOUBLE
+static char const* sample_file_test_filename_double = "samples_binary64.bin";
+extern void sample_file_test_double(char const* filename);
+
+// Test Grisu-Exact's output for every float, resuming from the checkpoint file if it exists
+//#define EXHAUSTIVE_TEST_FLOAT
+static char const* exhaustive_test_checkpoint_filename_float = "exhaustive_test_binary32.checkpoint";
+extern void exhaustive_test_float(char const* checkpoint_filename);
+
+// Test every combination of rounding mode and correct rounding search with float inputs
+// against the exact reference implementation
+//#define REFERENCE_TEST_FLOAT
+static std::size_t number_of_random_reference_tests_float = 100000;
+extern void reference_test_float(std::size_t number_of_random_inputs);
+
+// Test every combination of rounding mode and correct rounding search with double inputs
+// against the exact reference implementation
+//#define REFERENCE_TEST_DOUBLE
+static std::size_t number_of_random_reference_tests_double = 100000;
+extern void reference_test_double(std::size_t number_of_random_inputs);
+
+// Test the std::format and {fmt} adapters and the other output functions against fp_to_chars
+//#define OUTPUT_TEST
+static std::size_t number_of_output_tests = 100000;
+extern void output_test(std::size_t number_of_random_inputs);
+
+// Test fixed-point notation output with several locales, for float's and double's
+//#define FIXED_NOTATION_TEST
+static std::size_t number_of_fixed_notation_tests = 10000000;
+extern void fixed_notation_test(std::size_t number_of_random_inputs);
+
 // Run Grisu-Exact algorithm with randomly generated inputs
 //#define UNIFORM_RANDOM_PERF_TEST_FLOAT
 static std::size_t number_of_uniform_random_perf_tests_float = 100000000;
@@ -89,6 +132,14 @@ static std::size_t number_of_benchmark_iterations_double = 1000;
 extern void benchmark_test_double(std::size_t number_of_uniform_samples,
 	std::size_t number_of_digits_samples_per_digits, std::size_t number_of_iterations);
 
+// Do benchmark for binary64 numbers widened from binary32
+//#define BENCHMARK_TEST_WIDENED_FLOAT
+static std::size_t number_of_uniform_benchmark_samples_widened_float = 1000000;
+static std::size_t number_of_digits_benchmark_samples_per_digits_widened_float = 100000;
+static std::size_t number_of_benchmark_iterations_widened_float = 1000;
+extern void benchmark_test_widened_float(std::size_t number_of_uniform_samples,
+	std::size_t number_of_digits_samples_per_digits, std::size_t number_of_iterations);
+
 int main()
 {
 #ifdef VERIFY_LOG_COMPUTATION
@@ -115,6 +166,10 @@ int main()
 	verify_incorrect_rounding_removal();
 #endif
 
+#ifdef BIGINT_TEST
+	bigint_test(number_of_bigint_tests);
+#endif
+
 #ifdef UNIFORM_RANDOM_TEST_FLOAT
 	uniform_random_test_float(number_of_uniform_random_tests_float);
 #endif
@@ -123,6 +178,34 @@ int main()
 	uniform_random_test_double(number_of_uniform_random_tests_double);
 #endif
 
+#ifdef SAMPLE_FILE_TEST_FLOAT
+	sample_file_test_float(sample_file_test_filename_float);
+#endif
+
+#ifdef SAMPLE_FILE_TEST_DOUBLE
+	sample_file_test_double(sample_file_test_filename_double);
+#endif
+
+#ifdef EXHAUSTIVE_TEST_FLOAT
+	exhaustive_test_float(exhaustive_test_checkpoint_filename_float);
+#endif
+
+#ifdef REFERENCE_TEST_FLOAT
+	reference_test_float(number_of_random_reference_tests_float);
+#endif
+
+#ifdef REFERENCE_TEST_DOUBLE
+	reference_test_double(number_of_random_reference_tests_double);
+#endif
+
+#ifdef OUTPUT_TEST
+	output_test(number_of_output_tests);
+#endif
+
+#ifdef FIXED_NOTATION_TEST
+	fixed_notation_test(number_of_fixed_notation_tests);
+#endif
+
 #ifdef UNIFORM_RANDOM_PERF_TEST_FLOAT
 	uniform_random_perf_test_float(number_of_uniform_random_perf_tests_float);
 #endif
@@ -147,6 +230,12 @@ int main()
 		number_of_benchmark_iterations_double);
 #endif
 
+#ifdef BENCHMARK_TEST_WIDENED_FLOAT
+	benchmark_test_widened_float(number_of_uniform_benchmark_samples_widened_float,
+		number_of_digits_benchmark_samples_per_digits_widened_float,
+		number_of_benchmark_iterations_widened_float);
+#endif
+
 #ifdef LIVE_TEST_FLOAT
 	live_test_float();
 #endif
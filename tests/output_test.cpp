@@ -0,0 +1,380 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// Test the adapters around fp_to_chars_n: the std::formatter and fmt::formatter specializations
+// of fp_formatter.h, for the format specs "" and "E" and for output iterators that are not
+// char*, fp_to_chars_slot(s), for the padding and the bytes outside the slots, and
+// fp_to_chars_narrowest, for doubles inside and outside the range of float.
+// Every output should be the same as that of fp_to_chars_n, and should read back.
+// The std::formatter is tested only if <format> is available, and the fmt::formatter only if
+// {fmt} is found by CMake.
+
+// {fmt} should be included before fp_formatter.h
+#if defined(GRISU_EXACT_HAS_FMT)
+#include <fmt/format.h>
+#endif
+#include "output_test.h"
+#include "../common/random_float.h"
+#include "../fp_formatter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+	template <class Float>
+	Float parse_float(char const* str)
+	{
+		if constexpr (std::is_same_v<Float, float>) {
+			return std::strtof(str, nullptr);
+		}
+		else {
+			return std::strtod(str, nullptr);
+		}
+	}
+
+	// The outputs are compared with that of fp_to_chars_n, which the other tests check
+	template <class Float>
+	class output_checker {
+	public:
+		output_checker(output_test_parameters const& params, char const* type_name_string) :
+			params_{ params }, type_name_string_{ type_name_string } {}
+
+		std::size_t number_of_failures() const noexcept {
+			return number_of_failures_;
+		}
+
+		void check(Float x)
+		{
+			char expected[jkj::fp_to_chars_max_length<Float> + 1];
+			jkj::fp_to_chars(x, expected);
+
+			// The output of fp_to_chars_n reads back
+			auto const parsed = parse_float<Float>(expected);
+			if (std::isnan(x) ? std::strcmp(expected, "NaN") != 0 :
+				parsed != x || std::signbit(parsed) != std::signbit(x))
+			{
+				report("fp_to_chars", expected, "a string that reads back");
+			}
+
+			auto const formatted = jkj::fp_format(x);
+
+			// Written directly into a char*, and through a non-pointer output iterator
+			{
+				char buffer[jkj::fp_to_chars_max_length<Float>];
+				auto const end = jkj::fp_formatter_detail::format_to(formatted, buffer);
+				compare("format_to(char*)", std::string(buffer, end), expected);
+			}
+			{
+				std::string output;
+				jkj::fp_formatter_detail::format_to(formatted, std::back_inserter(output));
+				compare("format_to(back_inserter)", output, expected);
+			}
+
+#if defined(__cpp_lib_format)
+			compare("std::format(\"{}\")", std::format("{}", formatted), expected);
+			compare("std::format(\"{:E}\")", std::format("{:E}", formatted), expected);
+			{
+				char buffer[jkj::fp_to_chars_max_length<Float>];
+				auto const end = std::format_to(buffer, "{:E}", formatted);
+				compare("std::format_to(char*)", std::string(buffer, end), expected);
+			}
+			{
+				std::string output;
+				std::format_to(std::back_inserter(output), "{}", formatted);
+				compare("std::format_to(back_inserter)", output, expected);
+			}
+#endif
+
+#if defined(FMT_VERSION)
+			compare("fmt::format(\"{}\")", fmt::format("{}", formatted), expected);
+			compare("fmt::format(\"{:E}\")", fmt::format("{:E}", formatted), expected);
+			{
+				char buffer[jkj::fp_to_chars_max_length<Float>];
+				auto const end = fmt::format_to(buffer, "{:E}", formatted);
+				compare("fmt::format_to(char*)", std::string(buffer, end), expected);
+			}
+			{
+				std::string output;
+				fmt::format_to(std::back_inserter(output), "{}", formatted);
+				compare("fmt::format_to(back_inserter)", output, expected);
+			}
+#endif
+		}
+
+	private:
+		void compare(char const* adapter, std::string const& output, char const* expected)
+		{
+			if (output != expected) {
+				report(adapter, output, expected);
+			}
+		}
+
+		void report(char const* adapter, std::string const& output, char const* expected)
+		{
+			if (number_of_failures_++ < params_.max_number_of_reported_failures) {
+				std::cout << "Error detected! [" << type_name_string_ << ", " << adapter <<
+					" = " << output << ", expected " << expected << "]\n";
+			}
+		}
+
+		output_test_parameters const&	params_;
+		char const*						type_name_string_;
+		std::size_t						number_of_failures_ = 0;
+	};
+
+	template <class Float>
+	std::size_t test_formatters(output_test_parameters const& params, std::mt19937_64& rg,
+		char const* type_name_string)
+	{
+		output_checker<Float> checker{ params, type_name_string };
+
+		std::vector<Float> inputs = { Float(0), Float(1), Float(0.1), Float(1e7), Float(1e-7),
+			std::numeric_limits<Float>::denorm_min(), std::numeric_limits<Float>::min(),
+			std::numeric_limits<Float>::max(), std::numeric_limits<Float>::infinity(),
+			std::numeric_limits<Float>::quiet_NaN() };
+		for (std::size_t i = 0; i < params.number_of_random_inputs; ++i) {
+			inputs.push_back(uniformly_randomly_generate_general_float<Float>(rg));
+		}
+		for (auto const x : inputs) {
+			checker.check(x);
+			checker.check(-x);
+		}
+
+		std::cout << "Formatters for " << type_name_string << ": " <<
+			checker.number_of_failures() << " failures.\n";
+		return checker.number_of_failures();
+	}
+
+	// fp_to_chars_slot fills exactly slot_size characters with the output of fp_to_chars_n
+	// followed by padding, and fp_to_chars_slots puts the i-th value at i * slot_size
+	template <class Float, std::size_t slot_size>
+	std::size_t test_slots(output_test_parameters const& params, std::mt19937_64& rg,
+		char const* type_name_string)
+	{
+		constexpr std::size_t guard_size = 8;
+		constexpr char guard = '#';
+		constexpr std::size_t number_of_slots = 16;
+
+		std::size_t number_of_failures = 0;
+		auto report = [&](char const* what, Float x) {
+			if (number_of_failures++ < params.max_number_of_reported_failures) {
+				char output[jkj::fp_to_chars_max_length<Float> + 1];
+				jkj::fp_to_chars(x, output);
+				std::cout << "Error detected! [" << type_name_string << " " << output <<
+					", slot_size = " << slot_size << ": " << what << "]\n";
+			}
+		};
+		// The slot at slot holds x padded with padding
+		auto check_slot = [&](char const* slot, Float x, char padding) {
+			char expected[jkj::fp_to_chars_max_length<Float>];
+			auto const length = std::size_t(jkj::fp_to_chars_n(x, expected) - expected);
+			if (std::memcmp(slot, expected, length) != 0) {
+				report("wrong output", x);
+			}
+			else if (std::any_of(slot + length, slot + slot_size,
+				[padding](char c) { return c != padding; }))
+			{
+				report("wrong padding", x);
+			}
+		};
+		auto guards_intact = [&](char const* first, char const* last) {
+			return std::all_of(first, first + guard_size, [](char c) { return c == guard; }) &&
+				std::all_of(last, last + guard_size, [](char c) { return c == guard; });
+		};
+
+		std::vector<Float> inputs = { Float(0), std::numeric_limits<Float>::denorm_min(),
+			std::numeric_limits<Float>::max(), std::numeric_limits<Float>::infinity(),
+			std::numeric_limits<Float>::quiet_NaN() };
+		for (std::size_t i = 0; i < params.number_of_random_inputs; ++i) {
+			inputs.push_back(uniformly_randomly_generate_general_float<Float>(rg));
+		}
+
+		// Single slots, padded with '\0' and ' '
+		char buffer[guard_size + number_of_slots * slot_size + guard_size];
+		auto const slots = buffer + guard_size;
+		for (auto const x : inputs) {
+			for (auto const y : { x, -x }) {
+				for (char padding : { '\0', ' ' }) {
+					std::fill(std::begin(buffer), std::end(buffer), guard);
+					auto const next = jkj::fp_to_chars_slot<slot_size>(y, slots, padding);
+					if (next != slots + slot_size) {
+						report("wrong return value", y);
+					}
+					if (!guards_intact(buffer, slots + slot_size)) {
+						report("written outside the slot", y);
+					}
+					check_slot(slots, y, padding);
+				}
+			}
+		}
+
+		// Batches of number_of_slots values, each value at its own stride
+		for (std::size_t first = 0; first + number_of_slots <= inputs.size(); first += number_of_slots) {
+			std::fill(std::begin(buffer), std::end(buffer), guard);
+			auto const end = jkj::fp_to_chars_slots<slot_size>(inputs.data() + first,
+				inputs.data() + first + number_of_slots, slots, '\0');
+			if (end != slots + number_of_slots * slot_size) {
+				report("wrong return value of fp_to_chars_slots", inputs[first]);
+			}
+			if (!guards_intact(buffer, slots + number_of_slots * slot_size)) {
+				report("written outside the slots", inputs[first]);
+			}
+			for (std::size_t i = 0; i < number_of_slots; ++i) {
+				check_slot(slots + i * slot_size, inputs[first + i], '\0');
+			}
+		}
+
+		std::cout << "Slots of " << slot_size << " characters for " << type_name_string << ": " <<
+			number_of_failures << " failures.\n";
+		return number_of_failures;
+	}
+
+	// fp_to_chars_narrowest prints a double exactly representable as a float as that float,
+	// and any other double, including those outside the range of float, as a double
+	std::size_t test_narrowest(output_test_parameters const& params, std::mt19937_64& rg)
+	{
+		std::size_t number_of_failures = 0;
+		auto check = [&](double x, char const* expected) {
+			char output[jkj::fp_to_chars_max_length<double> + 1];
+			jkj::fp_to_chars_narrowest(x, output);
+			if (std::strcmp(output, expected) != 0 &&
+				number_of_failures++ < params.max_number_of_reported_failures)
+			{
+				std::cout << "Error detected! [fp_to_chars_narrowest = " << output <<
+					", expected " << expected << "]\n";
+			}
+		};
+
+		char expected[jkj::fp_to_chars_max_length<double> + 1];
+		std::vector<double> inputs = { std::numeric_limits<double>::max(),
+			double(std::numeric_limits<float>::max()) * 2, 1e300,
+			std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::infinity(),
+			std::numeric_limits<double>::quiet_NaN() };
+		for (std::size_t i = 0; i < params.number_of_random_inputs; ++i) {
+			inputs.push_back(uniformly_randomly_generate_general_float<double>(rg));
+		}
+		for (auto const x : inputs) {
+			for (auto const y : { x, -x }) {
+				if (std::fabs(y) <= double(std::numeric_limits<float>::max()) &&
+					double(float(y)) == y)
+				{
+					jkj::fp_to_chars(float(y), expected);
+				}
+				else {
+					jkj::fp_to_chars(y, expected);
+				}
+				check(y, expected);
+			}
+		}
+		for (std::size_t i = 0; i < params.number_of_random_inputs; ++i) {
+			auto const x = uniformly_randomly_generate_finite_float<float>(rg);
+			jkj::fp_to_chars(x, expected);
+			check(double(x), expected);
+		}
+
+		std::cout << "fp_to_chars_narrowest: " << number_of_failures << " failures.\n";
+		return number_of_failures;
+	}
+
+	// The format specs other than "" and "E" are rejected
+	std::size_t test_format_spec_parsing()
+	{
+		std::size_t number_of_failures = 0;
+		auto check = [&](std::string_view spec, bool valid, std::size_t length) {
+			bool rejected = false;
+			auto const end = jkj::fp_formatter_detail::parse_format_spec(spec.data(),
+				spec.data() + spec.size(), [&rejected](char const*) { rejected = true; });
+			if (rejected == valid || (valid && std::size_t(end - spec.data()) != length)) {
+				++number_of_failures;
+				std::cout << "Error detected! [format spec \"" << spec << "\" should be " <<
+					(valid ? "accepted" : "rejected") << "]\n";
+			}
+		};
+		check("", true, 0);
+		check("}", true, 0);
+		check("E", true, 1);
+		check("E}", true, 1);
+		check("e}", false, 0);
+		check("EE}", false, 0);
+		check(".3}", false, 0);
+
+#if defined(__cpp_lib_format)
+		try {
+			(void)std::vformat("{:e}", std::make_format_args(jkj::fp_format(1.0)));
+			++number_of_failures;
+			std::cout << "Error detected! [std::format should reject \"{:e}\"]\n";
+		}
+		catch (std::format_error const&) {}
+#endif
+#if defined(FMT_VERSION)
+		try {
+			(void)fmt::format(fmt::runtime("{:e}"), jkj::fp_format(1.0));
+			++number_of_failures;
+			std::cout << "Error detected! [fmt::format should reject \"{:e}\"]\n";
+		}
+		catch (fmt::format_error const&) {}
+#endif
+
+		std::cout << "Format spec parsing: " << number_of_failures << " failures.\n";
+		return number_of_failures;
+	}
+}
+
+bool output_test(output_test_parameters const& params)
+{
+	auto const seed = params.use_seed ? params.seed : generate_correctly_seeded_mt19937_64()();
+	std::mt19937_64 rg{ seed };
+
+	std::cout << "Testing the output adapters with " << params.number_of_random_inputs <<
+		" random inputs of both signs (seed " << seed << ")";
+#if defined(__cpp_lib_format)
+	std::cout << ", with std::format";
+#endif
+#if defined(FMT_VERSION)
+	std::cout << ", with {fmt}";
+#endif
+	std::cout << "...\n";
+
+	std::size_t number_of_failures = test_format_spec_parsing();
+	number_of_failures += test_formatters<float>(params, rg, "float");
+	number_of_failures += test_formatters<double>(params, rg, "double");
+	number_of_failures += test_narrowest(params, rg);
+	number_of_failures += test_slots<float, jkj::fp_to_chars_default_slot_size<float>>(
+		params, rg, "float");
+	number_of_failures += test_slots<float, 32>(params, rg, "float");
+	number_of_failures += test_slots<double, jkj::fp_to_chars_default_slot_size<double>>(
+		params, rg, "double");
+	number_of_failures += test_slots<double, 32>(params, rg, "double");
+	return number_of_failures == 0;
+}
+
+void output_test(std::size_t number_of_random_inputs)
+{
+	std::cout << "[Testing the output adapters...]\n";
+	output_test_parameters params;
+	params.number_of_random_inputs = number_of_random_inputs;
+	output_test(params);
+	std::cout << "Done.\n\n\n";
+}
\ No newline at end of file
@@ -0,0 +1,419 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// Compare the output of Grisu-Exact for every combination of RoundingMode and
+// CorrectRoundingSearch, with the default parameters and with those in alternative_parameters.h,
+// with that of the exact reference implementation (exact_reference.h),
+// over adversarial inputs (powers of 2, extreme values, and values whose rounding interval
+// ends exactly at a short decimal or which lie exactly between two shortest representations)
+// and random inputs. The inputs are divided into chunks, which threads take in turn.
+
+#include "reference_test.h"
+#include "exact_reference.h"
+#include "../common/random_float.h"
+#include "../parameters/alternative_parameters.h"
+#include "../common/policy_list.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+	// The interval of real numbers rounded to x under the rounding mode, in magnitude
+	template <class RoundingMode>
+	exact_reference::interval rounding_interval(bool is_negative, bool is_even)
+	{
+		namespace rm = jkj::grisu_exact_rounding_modes;
+		using exact_reference::endpoint;
+		auto nearest = [](bool include_left, bool include_right) {
+			return exact_reference::interval{
+				endpoint::midpoint, include_left, endpoint::midpoint, include_right };
+		};
+		// Reals in [|x|, next float) or (previous float, |x|]
+		constexpr exact_reference::interval truncated = {
+			endpoint::value, true, endpoint::neighbor, false };
+		constexpr exact_reference::interval augmented = {
+			endpoint::neighbor, false, endpoint::value, true };
+
+		if constexpr (std::is_same_v<RoundingMode, rm::nearest_to_even> ||
+			std::is_same_v<RoundingMode, rm::nearest_to_even_static_boundary>)
+		{
+			return nearest(is_even, is_even);
+		}
+		else if constexpr (std::is_same_v<RoundingMode, rm::nearest_to_odd> ||
+			std::is_same_v<RoundingMode, rm::nearest_to_odd_static_boundary>)
+		{
+			return nearest(!is_even, !is_even);
+		}
+		else if constexpr (std::is_same_v<RoundingMode, rm::nearest_toward_plus_infinity> ||
+			std::is_same_v<RoundingMode, rm::nearest_toward_plus_infinity_static_boundary>)
+		{
+			return nearest(!is_negative, is_negative);
+		}
+		else if constexpr (std::is_same_v<RoundingMode, rm::nearest_toward_minus_infinity> ||
+			std::is_same_v<RoundingMode, rm::nearest_toward_minus_infinity_static_boundary>)
+		{
+			return nearest(is_negative, !is_negative);
+		}
+		else if constexpr (std::is_same_v<RoundingMode, rm::nearest_toward_zero>) {
+			return nearest(false, true);
+		}
+		else if constexpr (std::is_same_v<RoundingMode, rm::nearest_away_from_zero>) {
+			return nearest(true, false);
+		}
+		else if constexpr (std::is_same_v<RoundingMode, rm::toward_plus_infinity>) {
+			return is_negative ? truncated : augmented;
+		}
+		else if constexpr (std::is_same_v<RoundingMode, rm::toward_minus_infinity>) {
+			return is_negative ? augmented : truncated;
+		}
+		else if constexpr (std::is_same_v<RoundingMode, rm::toward_zero>) {
+			return truncated;
+		}
+		else {
+			static_assert(std::is_same_v<RoundingMode, rm::away_from_zero>);
+			return augmented;
+		}
+	}
+
+	template <class CorrectRoundingSearch>
+	constexpr exact_reference::tie_rule tie_rule_of()
+	{
+		namespace crs = jkj::grisu_exact_correct_rounding;
+		using exact_reference::tie_rule;
+		if constexpr (std::is_same_v<CorrectRoundingSearch, crs::do_not_care>) {
+			return tie_rule::any;
+		}
+		else if constexpr (std::is_same_v<CorrectRoundingSearch, crs::tie_to_even>) {
+			return tie_rule::to_even;
+		}
+		else if constexpr (std::is_same_v<CorrectRoundingSearch, crs::tie_to_odd>) {
+			return tie_rule::to_odd;
+		}
+		else if constexpr (std::is_same_v<CorrectRoundingSearch, crs::tie_to_up>) {
+			return tie_rule::to_up;
+		}
+		else {
+			static_assert(std::is_same_v<CorrectRoundingSearch, crs::tie_to_down>);
+			return tie_rule::to_down;
+		}
+	}
+
+	template <class Float>
+	struct policy_combination {
+		char const*					parameters;
+		char const*					rounding_mode;
+		char const*					correct_rounding_search;
+		exact_reference::interval	(*interval)(bool is_negative, bool is_even);
+		exact_reference::tie_rule	rule;
+		exact_reference::decimal	(*compute)(Float x);
+	};
+
+	template <class Float, class Parameters, class RoundingMode, class CorrectRoundingSearch>
+	exact_reference::decimal grisu_exact_decimal(Float x)
+	{
+		auto const result = jkj::grisu_exact_with_parameters<Parameters, false>(x,
+			RoundingMode{}, CorrectRoundingSearch{});
+		return{ std::uint64_t(result.significand), result.exponent };
+	}
+
+	template <class Float, class Parameters, class RoundingMode, class... CorrectRoundingSearch>
+	void add_combinations(std::vector<policy_combination<Float>>& combinations,
+		char const* parameters_name, type_list<CorrectRoundingSearch...>)
+	{
+		(combinations.push_back({ parameters_name,
+			policy_name<RoundingMode>, policy_name<CorrectRoundingSearch>,
+			rounding_interval<RoundingMode>, tie_rule_of<CorrectRoundingSearch>(),
+			grisu_exact_decimal<Float, Parameters, RoundingMode, CorrectRoundingSearch> }), ...);
+	}
+
+	template <class Float, class Parameters, class... RoundingMode>
+	void add_all_combinations(std::vector<policy_combination<Float>>& combinations,
+		char const* parameters_name, type_list<RoundingMode...>)
+	{
+		(add_combinations<Float, Parameters, RoundingMode>(combinations, parameters_name,
+			correct_rounding_searches{}), ...);
+	}
+
+	// With the default parameters and with those in alternative_parameters.h
+	template <class Float>
+	std::vector<policy_combination<Float>> all_combinations()
+	{
+		std::vector<policy_combination<Float>> combinations;
+		add_all_combinations<Float, jkj::grisu_exact_default_parameters<Float>>(combinations,
+			"default parameters", rounding_modes{});
+		add_all_combinations<Float, grisu_exact_alternative_parameters<Float>>(combinations,
+			"alternative parameters", rounding_modes{});
+		return combinations;
+	}
+
+	// Positive finite nonzero inputs at which the correctness depends on
+	// delicate boundary conditions
+	template <class Float, class RandGen>
+	std::vector<Float> generate_adversarial_inputs(RandGen& rg)
+	{
+		using info = exact_reference::detail::float_info<Float>;
+		using carrier_uint = typename info::carrier_uint;
+		constexpr int precision = info::precision;
+		constexpr auto hidden_bit = std::uint64_t(1) << precision;
+		constexpr int max_biased_exponent = std::numeric_limits<Float>::max_exponent * 2 - 2;
+
+		std::vector<Float> ret;
+		auto add_bits = [&ret](carrier_uint bits) {
+			Float x;
+			std::memcpy(&x, &bits, sizeof(Float));
+			ret.push_back(x);
+		};
+		// f * 2^e, if it is a normal number with that significand
+		auto add_normal = [&ret](std::uint64_t f, int e) {
+			if (f >= hidden_bit && f < 2 * hidden_bit && e >= info::min_exponent &&
+				e + precision < std::numeric_limits<Float>::max_exponent)
+			{
+				ret.push_back(std::ldexp(Float(f), e));
+			}
+		};
+
+		// Extreme values and subnormals
+		auto const max_finite = carrier_uint(
+			(std::uint64_t(max_biased_exponent) << precision) | (hidden_bit - 1));
+		for (carrier_uint bits : { carrier_uint(1), carrier_uint(2), carrier_uint(3),
+			carrier_uint(hidden_bit - 2), carrier_uint(hidden_bit - 1), carrier_uint(hidden_bit),
+			carrier_uint(hidden_bit + 1), carrier_uint(max_finite - 1), max_finite })
+		{
+			add_bits(bits);
+		}
+
+		// Every power of 2 and its neighbors; the lower interval is shorter at a power of 2
+		for (int biased_exponent = 1; biased_exponent <= max_biased_exponent; ++biased_exponent) {
+			auto const bits = carrier_uint(biased_exponent) << precision;
+			add_bits(bits - 1);
+			add_bits(bits);
+			add_bits(bits + 1);
+		}
+
+		// Values such that |x|, the next float, or a midpoint is exactly T * 10^k
+		// T = m * 5^k should be less than 2^(precision + 2)
+		std::uint64_t power_of_5 = 1;
+		for (int k = 0; power_of_5 < 4 * hidden_bit; ++k, power_of_5 *= 5) {
+			auto const min_m = (hidden_bit + power_of_5 - 1) / power_of_5;
+			auto const max_m = (4 * hidden_bit - 1) / power_of_5;
+			std::uniform_int_distribution<std::uint64_t> m_distribution{ min_m, max_m };
+			for (int i = 0; i < 64; ++i) {
+				auto const m = i == 0 ? min_m : i == 1 ? max_m : m_distribution(rg);
+				auto const t = m * power_of_5;
+				for (int shift = 0; shift <= 1; ++shift) {
+					// x, or the next float, is t * 2^k
+					add_normal(t >> shift, k + shift);
+					add_normal((t >> shift) - 1, k + shift);
+					// A midpoint is t * 2^k
+					if (t % 2 != 0) {
+						add_normal((t - 1) / 2, k + 1);
+						add_normal((t + 1) / 2, k + 1);
+					}
+				}
+			}
+		}
+
+		// Values with a few binary fractional digits, where two shortest representations
+		// can be equally close
+		std::uniform_int_distribution<std::uint64_t> f_distribution{ hidden_bit, 2 * hidden_bit - 1 };
+		for (int e = -6; e <= 0; ++e) {
+			for (int i = 0; i < 1000; ++i) {
+				add_normal(f_distribution(rg), e);
+			}
+		}
+
+		return ret;
+	}
+
+	// Positive finite nonzero random inputs; half of them are uniform over the bit patterns,
+	// and the other half have uniformly random number of digits
+	template <class Float, class RandGen>
+	std::vector<Float> generate_random_inputs(std::size_t n, RandGen& rg)
+	{
+		constexpr unsigned int max_digits = std::numeric_limits<Float>::max_digits10;
+		std::vector<random_float_with_given_digits<Float>> generators;
+		for (unsigned int digits = 1; digits <= max_digits; ++digits) {
+			generators.emplace_back(digits);
+		}
+
+		std::vector<Float> ret;
+		ret.reserve(n);
+		while (ret.size() < n) {
+			auto const x = ret.size() % 2 == 0 ?
+				uniformly_randomly_generate_finite_float<Float>(rg) :
+				generators[ret.size() / 2 % max_digits](rg);
+			if (x != 0) {
+				ret.push_back(std::abs(x));
+			}
+		}
+		return ret;
+	}
+
+	template <class Float>
+	std::string describe(Float x)
+	{
+		using carrier_uint = typename exact_reference::detail::float_info<Float>::carrier_uint;
+		carrier_uint bits;
+		std::memcpy(&bits, &x, sizeof(Float));
+		std::ostringstream out;
+		out << std::setprecision(std::numeric_limits<Float>::max_digits10) << x <<
+			" (0x" << std::hex << std::setw(sizeof(Float) * 2) << std::setfill('0') << bits << ")";
+		return out.str();
+	}
+
+	template <class Float>
+	bool reference_test(reference_test_parameters const& params, char const* type_name_string)
+	{
+		auto const seed = params.use_seed ? params.seed : generate_correctly_seeded_mt19937_64()();
+		std::mt19937_64 rg{ seed };
+
+		auto inputs = generate_adversarial_inputs<Float>(rg);
+		auto const number_of_adversarial_inputs = inputs.size();
+		auto const random_inputs = generate_random_inputs<Float>(params.number_of_random_inputs, rg);
+		inputs.insert(inputs.end(), random_inputs.begin(), random_inputs.end());
+
+		auto const combinations = all_combinations<Float>();
+		std::cout << "Testing " << combinations.size() << " policy combinations for " <<
+			type_name_string << " with " << number_of_adversarial_inputs << " adversarial and " <<
+			params.number_of_random_inputs << " random inputs of both signs (seed " << seed <<
+			")...\n";
+
+		constexpr std::size_t chunk_size = 256;
+		auto const number_of_chunks = (inputs.size() + chunk_size - 1) / chunk_size;
+		std::atomic<std::size_t> next_chunk{ 0 };
+		std::vector<std::atomic<std::size_t>> number_of_failures(combinations.size());
+		std::mutex output_mutex;
+		std::size_t number_of_reported_failures = 0;
+
+		auto test_input = [&](Float x) {
+			std::uint64_t bits = 0;
+			std::memcpy(&bits, &x, sizeof(Float));
+			bool const is_negative = std::signbit(x);
+			bool const is_even = bits % 2 == 0;
+
+			// Computed once for each distinct interval
+			std::vector<std::pair<exact_reference::interval,
+				exact_reference::shortest_candidates>> candidates;
+			for (std::size_t idx = 0; idx < combinations.size(); ++idx) {
+				auto const& combination = combinations[idx];
+				auto const itv = combination.interval(is_negative, is_even);
+				auto it = std::find_if(candidates.begin(), candidates.end(), [&itv](auto const& p) {
+					return p.first.left == itv.left && p.first.include_left == itv.include_left &&
+						p.first.right == itv.right && p.first.include_right == itv.include_right;
+				});
+				if (it == candidates.end()) {
+					candidates.emplace_back(itv,
+						exact_reference::compute_shortest_candidates(x, itv));
+					it = candidates.end() - 1;
+				}
+
+				auto const output = combination.compute(x);
+				if (exact_reference::is_allowed(it->second, combination.rule, output)) {
+					continue;
+				}
+
+				++number_of_failures[idx];
+				std::lock_guard<std::mutex> lock{ output_mutex };
+				if (number_of_reported_failures++ >= params.max_number_of_reported_failures) {
+					continue;
+				}
+				auto const& c = it->second;
+				std::cout << "Error detected! [" << describe(x) << ", " <<
+					combination.parameters << ", " << combination.rounding_mode << ", " <<
+					combination.correct_rounding_search <<
+					": Grisu-Exact = " << output.significand << "e" << output.exponent << ", ";
+				if (combination.rule == exact_reference::tie_rule::any) {
+					std::cout << "expected [" << c.first << ", " << c.last << "]e" << c.exponent;
+				}
+				else {
+					auto const expected = exact_reference::choose(c, combination.rule);
+					std::cout << "expected " << expected.significand << "e" << expected.exponent;
+				}
+				std::cout << "]\n";
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (std::size_t thread_idx = 0; thread_idx < std::max(std::size_t(1), params.number_of_threads);
+			++thread_idx)
+		{
+			threads.emplace_back([&] {
+				for (auto chunk = next_chunk++; chunk < number_of_chunks; chunk = next_chunk++) {
+					auto const last = std::min((chunk + 1) * chunk_size, inputs.size());
+					for (auto idx = chunk * chunk_size; idx < last; ++idx) {
+						test_input(inputs[idx]);
+						test_input(-inputs[idx]);
+					}
+				}
+			});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		std::size_t total_failures = 0;
+		for (std::size_t idx = 0; idx < combinations.size(); ++idx) {
+			if (number_of_failures[idx] != 0) {
+				std::cout << combinations[idx].parameters << ", " <<
+					combinations[idx].rounding_mode << ", " <<
+					combinations[idx].correct_rounding_search << ": " <<
+					number_of_failures[idx] << " failures\n";
+				total_failures += number_of_failures[idx];
+			}
+		}
+		if (total_failures == 0) {
+			std::cout << "Reference test for " << type_name_string << " succeeded.\n";
+		}
+		return total_failures == 0;
+	}
+}
+
+bool reference_test_float(reference_test_parameters const& params)
+{
+	return reference_test<float>(params, "float");
+}
+bool reference_test_double(reference_test_parameters const& params)
+{
+	return reference_test<double>(params, "double");
+}
+
+void reference_test_float(std::size_t number_of_random_inputs)
+{
+	std::cout << "[Testing every policy combination with float inputs against the exact reference...]\n";
+	reference_test_parameters params;
+	params.number_of_random_inputs = number_of_random_inputs;
+	reference_test_float(params);
+	std::cout << "Done.\n\n\n";
+}
+void reference_test_double(std::size_t number_of_random_inputs)
+{
+	std::cout << "[Testing every policy combination with double inputs against the exact reference...]\n";
+	reference_test_parameters params;
+	params.number_of_random_inputs = number_of_random_inputs;
+	reference_test_double(params);
+	std::cout << "Done.\n\n\n";
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef JKJ_GRISU_EXACT_REFERENCE_TEST
+#define JKJ_GRISU_EXACT_REFERENCE_TEST
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+struct reference_test_parameters {
+	// In addition to the adversarial inputs; every input is tested with both signs
+	std::size_t number_of_random_inputs = 100000;
+	std::size_t number_of_threads = std::thread::hardware_concurrency();
+	// Drawn from std::random_device if not given
+	bool use_seed = false;
+	std::uint64_t seed = 0;
+	std::size_t max_number_of_reported_failures = 100;
+};
+
+// Returns true if there is no failure
+bool reference_test_float(reference_test_parameters const& params);
+bool reference_test_double(reference_test_parameters const& params);
+
+#endif
\ No newline at end of file
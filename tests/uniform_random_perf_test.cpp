@@ -16,7 +16,7 @@
 // KIND, either express or implied.
 
 #include "../fp_to_chars.h"
-#include "random_float.h"
+#include "../common/random_float.h"
 #include <iostream>
 
 template <class Float>
@@ -16,46 +16,104 @@
 // KIND, either express or implied.
 
 #include "../fp_to_chars.h"
-#include "random_float.h"
+#include "../common/random_float.h"
+#include "../common/sample_file.h"
 #include "../benchmark/ryu/ryu.h"
 #include <iostream>
 #include <string_view>
 
-template <class Float, class TypenameString>
-void uniform_random_test(std::size_t number_of_tests, TypenameString&& type_name_string)
+// Returns false if any of the checks fails
+template <class Float>
+static bool check_against_ryu(Float x)
 {
 	char buffer1[41];
 	char buffer2[41];
-	auto rg = generate_correctly_seeded_mt19937_64();
 	bool succeeded = true;
-	for (std::size_t test_idx = 0; test_idx < number_of_tests; ++test_idx) {
-		auto x = uniformly_randomly_generate_general_float<Float>(rg);
 
-		// Check if the output is identical to that of Ryu
-		jkj::fp_to_chars(x, buffer1);
-		if constexpr (std::is_same_v<Float, float>) {
-			f2s_buffered(x, buffer2);
-		}
-		else {
-			d2s_buffered(x, buffer2);
-		}
+	// Check if the output is identical to that of Ryu
+	jkj::fp_to_chars(x, buffer1);
+	if constexpr (std::is_same_v<Float, float>) {
+		f2s_buffered(x, buffer2);
+	}
+	else {
+		d2s_buffered(x, buffer2);
+	}
 
-		std::string_view view1(buffer1);
-		std::string_view view2(buffer2);
+	std::string_view view1(buffer1);
+	std::string_view view2(buffer2);
+
+	if (view1 != view2) {
+		std::cout << "Error detected! [Ryu = " << buffer2
+			<< ", Grisu-Exact = " << buffer1 << "]\n";
+		succeeded = false;
+	}
 
-		if (view1 != view2) {
-			std::cout << "Error detected! [Ryu = " << buffer2
+	// Check if the shortest output is recovered from the float widened to double
+	if constexpr (std::is_same_v<Float, float>) {
+		jkj::fp_to_chars_narrowest(double(x), buffer2);
+		if (view1 != std::string_view(buffer2)) {
+			std::cout << "Error detected! [Grisu-Exact (narrowest) = " << buffer2
 				<< ", Grisu-Exact = " << buffer1 << "]\n";
 			succeeded = false;
 		}
 	}
 
+	// Check if the overwrite-tolerant writer produces the same output
+	*jkj::fp_to_chars_n_unsafe_slack<sizeof(buffer2)>(x, buffer2) = '\0';
+	if (view1 != std::string_view(buffer2)) {
+		std::cout << "Error detected! [Grisu-Exact (unsafe slack) = " << buffer2
+			<< ", Grisu-Exact = " << buffer1 << "]\n";
+		succeeded = false;
+	}
+
+	return succeeded;
+}
+
+template <class Float, class TypenameString>
+void uniform_random_test(std::size_t number_of_tests, TypenameString&& type_name_string)
+{
+	auto rg = generate_correctly_seeded_mt19937_64();
+	bool succeeded = true;
+	for (std::size_t test_idx = 0; test_idx < number_of_tests; ++test_idx) {
+		auto x = uniformly_randomly_generate_general_float<Float>(rg);
+		succeeded = check_against_ryu(x) && succeeded;
+	}
+
 	if (succeeded) {
 		std::cout << "Uniform random test for " << type_name_string
 			<< " with " << number_of_tests << " examples succeeded.\n";
 	}
 }
 
+// Same checks with every sample in a file written by benchmark/make_sample_file.cpp
+template <class Float>
+static void sample_file_test(char const* filename)
+{
+	sample_file file;
+	if (auto const error = file.open(filename); !error.empty()) {
+		std::cout << error << "\n";
+		return;
+	}
+	if (file.header().float_size != sizeof(Float)) {
+		std::cout << filename << " does not contain samples of this type.\n";
+		return;
+	}
+
+	bool succeeded = true;
+	std::size_t number_of_tests = 0;
+	for (std::size_t idx = 0; idx < file.number_of_buckets(); ++idx) {
+		for (auto ptr = file.bucket_begin<Float>(idx); ptr != file.bucket_end<Float>(idx); ++ptr) {
+			succeeded = check_against_ryu(*ptr) && succeeded;
+			++number_of_tests;
+		}
+	}
+
+	if (succeeded) {
+		std::cout << "Test with " << number_of_tests << " samples from " << filename <<
+			" (seed " << file.header().seed << ") succeeded.\n";
+	}
+}
+
 void uniform_random_test_float(std::size_t number_of_tests) {
 	std::cout << "[Testing uniformly randomly generated float inputs...]\n";
 	uniform_random_test<float>(number_of_tests, "float");
@@ -65,4 +123,15 @@ void uniform_random_test_double(std::size_t number_of_tests) {
 	std::cout << "[Testing uniformly randomly generated double inputs...]\n";
 	uniform_random_test<double>(number_of_tests, "double");
 	std::cout << "Done.\n\n\n";
+}
+
+void sample_file_test_float(char const* filename) {
+	std::cout << "[Testing float samples from a file...]\n";
+	sample_file_test<float>(filename);
+	std::cout << "Done.\n\n\n";
+}
+void sample_file_test_double(char const* filename) {
+	std::cout << "[Testing double samples from a file...]\n";
+	sample_file_test<double>(filename);
+	std::cout << "Done.\n\n\n";
 }
\ No newline at end of file
@@ -0,0 +1,254 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// Common part of the offline verifications, which check the assumptions and
+// the parameters Grisu-Exact is built on; see tests/verify_main.cpp for the driver.
+
+#ifndef JKJ_GRISU_EXACT_VERIFY
+#define JKJ_GRISU_EXACT_VERIFY
+
+#include "../grisu_exact.h"
+#include "../parameters/alternative_parameters.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// A binary floating-point format and the parameters of Grisu-Exact for it,
+// the runtime counterpart of jkj::grisu_exact_detail::common_info
+struct verify_format {
+	std::string name;
+	// Number of bits of the significand, excluding the hidden bit
+	int precision = 0;
+	int exponent_bits = 0;
+	int alpha = -5;
+	int gamma = -2;
+	// min_kappa + 2 if negative
+	int initial_kappa = -1;
+
+	// Derived from the above by derive_format_parameters
+	int extended_precision = 0;
+	int exponent_bias = 0;
+	int min_exponent = 0;
+	int max_exponent = 0;
+	int min_kappa = 0;
+	int max_kappa = 0;
+	int min_k = 0;
+	int max_k = 0;
+	int cache_precision = 0;
+};
+
+// Computes the derived members, checking what common_info checks with static_assert's
+// Returns an empty string on success, or the reason why the format is not supported
+inline std::string derive_format_parameters(verify_format& format)
+{
+	using namespace jkj::grisu_exact_detail;
+
+	if (format.precision < 1 || format.exponent_bits < 2) {
+		return "The precision should be positive and there should be at least 2 exponent bits.";
+	}
+	format.extended_precision = 1 + format.exponent_bits + format.precision;
+	if (format.extended_precision != 16 && format.extended_precision != 32 &&
+		format.extended_precision != 64)
+	{
+		return "The format should have 16, 32, or 64 bits in total.";
+	}
+	auto const q = format.extended_precision;
+	auto const p = format.precision;
+
+	if (format.exponent_bits > 11) {
+		return "The exponent range is too wide for floor_log10_pow2 and floor_log2_pow10.";
+	}
+	format.exponent_bias = 1 - (1 << (format.exponent_bits - 1));
+	format.min_exponent = 3 - (1 << (format.exponent_bits - 1)) - q;
+	format.max_exponent = (1 << (format.exponent_bits - 1)) - q;
+
+	if (format.alpha < -(q - p - 4) || format.gamma > 0) {
+		return "alpha should be at least -(q-p-4), and gamma should be at most 0.";
+	}
+	if (format.gamma < format.alpha + 3) {
+		return "gamma should be at least alpha + 3.";
+	}
+	if (std::max(format.max_exponent + 1 - format.alpha, format.alpha - 1 - format.min_exponent) > 1650) {
+		return "The exponent range is too wide for floor_log10_pow2.";
+	}
+	format.min_k = -floor_log10_pow2(format.max_exponent + 1 - format.alpha);
+	format.max_k = -floor_log10_pow2(format.min_exponent + 1 - format.alpha);
+	if (std::max(-format.min_k, format.max_k) > 642) {
+		return "The range of k is too wide for floor_log2_pow10.";
+	}
+
+	format.min_kappa = -floor_log10_pow2(-(q - p - 3 + format.alpha)) - 1;
+	format.max_kappa = -floor_log10_pow2(-(q + format.gamma)) - 1;
+	if (format.min_kappa < 0 || format.min_kappa > format.max_kappa) {
+		return "alpha and gamma give an empty range of kappa.";
+	}
+	if (format.initial_kappa < 0) {
+		format.initial_kappa = format.min_kappa + 2;
+	}
+	// The decreasing search is performed only once, and goes down to min_kappa
+	if (format.initial_kappa != format.min_kappa + 2 || format.initial_kappa > format.max_kappa) {
+		return "initial_kappa should be min_kappa + 2 = " + std::to_string(format.min_kappa + 2) +
+			", and at most max_kappa = " + std::to_string(format.max_kappa) + ".";
+	}
+	// delta, which is at most 2^(q-p-1+gamma), should not overflow during the decreasing search
+	if (floor_log2_pow10(format.initial_kappa - format.min_kappa - 1) >= 32 - (q - p - 1) - format.gamma) {
+		return "delta may overflow during the decreasing search.";
+	}
+	if (format.initial_kappa >= floor_log10_pow2(32)) {
+		return "10^initial_kappa should fit in 32 bits.";
+	}
+	// The increasing search has at most 4 steps
+	if (format.max_kappa - format.initial_kappa >= 16) {
+		return "The search steps of Grisu-Exact do not support this range of kappa.";
+	}
+	// Fractional parts cannot vanish when the exponent is the minimum
+	if (format.min_exponent >= floor_log5_pow2(-(q - p - 3 + format.alpha)) - (q - p - 3)) {
+		return "The fractional parts may vanish at the minimum exponent.";
+	}
+
+	format.cache_precision = 2 * q;
+	return {};
+}
+
+// The format and the parameters of common_info<Float, Parameters>
+template <class Float, class Parameters = jkj::grisu_exact_default_parameters<Float>>
+verify_format builtin_format(char const* name)
+{
+	using info = jkj::grisu_exact_detail::common_info<Float, Parameters>;
+
+	verify_format format;
+	format.name = name;
+	format.precision = int(info::precision);
+	format.exponent_bits = int(info::exponent_bits);
+	format.alpha = info::alpha;
+	format.gamma = info::gamma;
+	format.initial_kappa = info::initial_kappa;
+	derive_format_parameters(format);
+	return format;
+}
+
+template <class Float, class Parameters = jkj::grisu_exact_default_parameters<Float>>
+bool is_builtin_format(verify_format const& format)
+{
+	using info = jkj::grisu_exact_detail::common_info<Float, Parameters>;
+
+	return format.precision == int(info::precision) && format.exponent_bits == int(info::exponent_bits) &&
+		format.alpha == info::alpha && format.gamma == info::gamma &&
+		format.initial_kappa == info::initial_kappa;
+}
+
+template <class Float, class Parameters>
+struct parameters_tag {
+	using float_type = Float;
+	using parameters = Parameters;
+};
+
+// The checks that run Grisu-Exact itself are possible only for the parameters instantiated here,
+// that is, the default ones and those in alternative_parameters.h
+// Calls f(parameters_tag<Float, Parameters>{}) for the ones matching the format,
+// and returns false if there are none.
+template <class F>
+bool visit_instantiated_parameters(verify_format const& format, F&& f)
+{
+	if (is_builtin_format<float>(format)) {
+		f(parameters_tag<float, jkj::grisu_exact_default_parameters<float>>{});
+	}
+	else if (is_builtin_format<double>(format)) {
+		f(parameters_tag<double, jkj::grisu_exact_default_parameters<double>>{});
+	}
+	else if (is_builtin_format<float, grisu_exact_alternative_parameters_float>(format)) {
+		f(parameters_tag<float, grisu_exact_alternative_parameters_float>{});
+	}
+	else if (is_builtin_format<double, grisu_exact_alternative_parameters_double>(format)) {
+		f(parameters_tag<double, grisu_exact_alternative_parameters_double>{});
+	}
+	else {
+		return false;
+	}
+	return true;
+}
+
+struct verify_parameters {
+	std::size_t number_of_threads = std::thread::hardware_concurrency();
+	// Where the tables are written
+	std::string output_directory = "test_results";
+};
+
+// Calls f(idx) for every idx in [0, size); threads take the indices in turn,
+// so each call should be a sizable piece of work
+template <class F>
+void parallel_for(std::size_t size, std::size_t number_of_threads, F&& f)
+{
+	number_of_threads = std::min(std::max(std::size_t(1), number_of_threads), size);
+
+	std::atomic<std::size_t> next_idx{ 0 };
+	auto work = [&] {
+		for (auto idx = next_idx++; idx < size; idx = next_idx++) {
+			f(idx);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (std::size_t thread_idx = 1; thread_idx < number_of_threads; ++thread_idx) {
+		threads.emplace_back(work);
+	}
+	work();
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
+
+// Calls f(std::integral_constant<std::size_t, N>{}) with the smallest N in {4, 8, ..., 64} such that
+// N elements of 64 bits can hold max_bits bits, so that big integers sized at runtime can be used
+template <class F>
+auto with_number_of_elements(std::size_t max_bits, F&& f)
+{
+	if (max_bits <= 4 * 64) {
+		return f(std::integral_constant<std::size_t, 4>{});
+	}
+	else if (max_bits <= 8 * 64) {
+		return f(std::integral_constant<std::size_t, 8>{});
+	}
+	else if (max_bits <= 16 * 64) {
+		return f(std::integral_constant<std::size_t, 16>{});
+	}
+	else if (max_bits <= 32 * 64) {
+		return f(std::integral_constant<std::size_t, 32>{});
+	}
+	else {
+		// Enough for every format derive_format_parameters accepts
+		assert(max_bits <= 64 * 64);
+		return f(std::integral_constant<std::size_t, 64>{});
+	}
+}
+
+// Each returns true if the verification succeeded
+// The log computations do not depend on the format, but the range each format needs is reported.
+bool verify_log_computation(verify_parameters const& params, std::vector<verify_format> const& formats);
+bool verify_cache_length(verify_parameters const& params, verify_format const& format);
+bool generate_cache(verify_parameters const& params, verify_format const& format);
+// These run Grisu-Exact, so the formats without instantiated parameters are skipped
+bool verify_delta_computation(verify_parameters const& params, verify_format const& format);
+bool verify_correct_rounding_bound(verify_parameters const& params, verify_format const& format);
+bool verify_incorrect_rounding_removal(verify_parameters const& params, verify_format const& format);
+
+#endif
\ No newline at end of file
@@ -15,7 +15,8 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
 // KIND, either express or implied.
 
-#include "bigint.h"
+#include "verify.h"
+#include "../common/bigint.h"
 
 namespace jkj {
 	namespace grisu_exact_detail {
@@ -127,7 +128,6 @@ namespace jkj {
 			return ret;
 		}
 
-		template <class Float>
 		struct further_info {
 			// When k < 0,
 			// we should be able to hold 5^-k and 2^(q + e + k + 1).
@@ -139,11 +139,7 @@ namespace jkj {
 			// the necessary bits for the former is at most e + k + 2 - alpha.
 			// On the other hand, e + k is an increasing function of e, so
 			// the following is an upper bound:
-			static constexpr std::size_t negative_k_max_bits =
-				std::max(int(common_info<Float>::extended_precision + 2),
-					int(2 - common_info<Float>::alpha)) +
-				common_info<Float>::max_exponent + common_info<Float>::min_k;
-
+			std::size_t negative_k_max_bits;
 
 			// When k >= 0,
 			// we should be able to hold 5^k * 2^(p+2) and 2^(-e - k - (q-p-3)).
@@ -156,229 +152,253 @@ namespace jkj {
 			// the necessary bits for the former is at most -e - k + p + 5 + alpha.
 			// On the other hand, -e - k is a decreasing function on e, so
 			// the following is an upper bound:
-			static constexpr std::size_t positive_k_max_bits =
-				common_info<Float>::precision +
-				std::max(-int(common_info<Float>::extended_precision - 4),
-					int(5 + common_info<Float>::alpha))
-				- common_info<Float>::min_exponent - common_info<Float>::max_k;
-
+			std::size_t positive_k_max_bits;
 
 			// Useful constants
-			static constexpr auto range =
-				(std::uint64_t(1) << (common_info<Float>::precision + 2));
-			static constexpr auto q_mp_m2 =
-				common_info<Float>::extended_precision - common_info<Float>::precision - 2;
+			std::uint64_t range;
+			int q_mp_m2;
+
+			explicit further_info(verify_format const& format) :
+				negative_k_max_bits{ std::size_t(
+					std::max(format.extended_precision + 2, 2 - format.alpha) +
+					format.max_exponent + format.min_k) },
+				positive_k_max_bits{ std::size_t(format.precision +
+					std::max(-(format.extended_precision - 4), 5 + format.alpha)
+					- format.min_exponent - format.max_k) },
+				range{ std::uint64_t(1) << (format.precision + 2) },
+				q_mp_m2{ format.extended_precision - format.precision - 2 } {}
 		};
 
-		template <class Float, class F1, class F2>
-		void verify_cache_length_single_type_negative_k(F1&& on_each, F2&& on_max)
+		template <std::size_t array_size>
+		std::size_t verify_cache_length_negative_k(verify_format const& format,
+			further_info const& info, int e, int k, bigint_impl<array_size> const& power_of_5)
 		{
-			using bigint_type = bigint<further_info<Float>::negative_k_max_bits>;
-
-			std::size_t max_required_bits = 0;
-
-			bigint_type power_of_5 = 1;
-			int prev_k = 0;
-			for (int e = common_info<Float>::alpha + 3; e <= common_info<Float>::max_exponent; ++e) {
-				auto k = -floor_log10_pow2(e + 1 - common_info<Float>::alpha);
-				if (k != prev_k) {
-					assert(k == prev_k - 1);
-					power_of_5.multiply_5();
-					prev_k = k;
-				}
+			using bigint_type = bigint_impl<array_size>;
 
-				auto mod_minmax = minmax_euclid(
-					bigint_type::power_of_2(further_info<Float>::q_mp_m2 + e + k),
-					power_of_5, further_info<Float>::range);
-				auto& mod_min = mod_minmax.min;
-				auto& mod_max = mod_minmax.max;
+			auto mod_minmax = minmax_euclid(
+				bigint_type::power_of_2(std::size_t(info.q_mp_m2 + e + k)),
+				power_of_5, info.range);
+			auto& mod_min = mod_minmax.min;
+			auto& mod_max = mod_minmax.max;
 
-				auto divisor = power_of_5;
-				divisor -= mod_max;
-				auto dividend = power_of_5;
-				auto division_res = dividend.long_division(divisor);
+			auto divisor = power_of_5;
+			divisor -= mod_max;
+			auto dividend = power_of_5;
+			auto division_res = dividend.long_division(divisor);
 
-				auto log2_res_p1 = division_res.leading_one_pos.element_pos *
-					division_res.element_number_of_bits + division_res.leading_one_pos.bit_pos;
+			auto log2_res_p1 = division_res.leading_one_pos.element_pos *
+				division_res.element_number_of_bits + division_res.leading_one_pos.bit_pos;
 
-				auto required_bits = common_info<Float>::extended_precision +
-					e + floor_log2_pow10(k) + 1 + log2_res_p1;
+			auto required_bits = std::size_t(format.extended_precision +
+				e + floor_log2_pow10(k) + 1) + log2_res_p1;
 
-				mod_minmax = minmax_euclid(
-					bigint_type::power_of_2(further_info<Float>::q_mp_m2 + e + k + 2),
-					power_of_5, further_info<Float>::range / 2);
-				mod_min = mod_minmax.min;
-				mod_max = mod_minmax.max;
+			mod_minmax = minmax_euclid(
+				bigint_type::power_of_2(std::size_t(info.q_mp_m2 + e + k + 2)),
+				power_of_5, info.range / 2);
+			mod_min = mod_minmax.min;
+			mod_max = mod_minmax.max;
 
-				divisor = power_of_5;
-				divisor -= mod_max;
-				dividend = power_of_5;
-				division_res = dividend.long_division(divisor);
+			divisor = power_of_5;
+			divisor -= mod_max;
+			dividend = power_of_5;
+			division_res = dividend.long_division(divisor);
 
-				log2_res_p1 = division_res.leading_one_pos.element_pos *
-					division_res.element_number_of_bits + division_res.leading_one_pos.bit_pos;
+			log2_res_p1 = division_res.leading_one_pos.element_pos *
+				division_res.element_number_of_bits + division_res.leading_one_pos.bit_pos;
 
-				auto two_y_result = common_info<Float>::extended_precision +
-					e + floor_log2_pow10(k) + 1 + log2_res_p1;
+			auto two_y_result = std::size_t(format.extended_precision +
+				e + floor_log2_pow10(k) + 1) + log2_res_p1;
 
-				if (two_y_result > required_bits)
-					required_bits = two_y_result;
- 
-				auto edge_case_a = bigint_type::power_of_2(further_info<Float>::q_mp_m2 + e + k - 1);
-				edge_case_a *= (further_info<Float>::range - 1);
-				edge_case_a.long_division(power_of_5);
+			if (two_y_result > required_bits)
+				required_bits = two_y_result;
 
-				divisor = power_of_5;
-				divisor -= edge_case_a;
-				dividend = power_of_5;
-				division_res = dividend.long_division(divisor);
+			auto edge_case_a = bigint_type::power_of_2(std::size_t(info.q_mp_m2 + e + k - 1));
+			edge_case_a *= (info.range - 1);
+			edge_case_a.long_division(power_of_5);
 
-				log2_res_p1 = division_res.leading_one_pos.element_pos *
-					division_res.element_number_of_bits + division_res.leading_one_pos.bit_pos;
+			divisor = power_of_5;
+			divisor -= edge_case_a;
+			dividend = power_of_5;
+			division_res = dividend.long_division(divisor);
 
-				auto edge_case_result = common_info<Float>::extended_precision +
-					e + floor_log2_pow10(k) + log2_res_p1;
+			log2_res_p1 = division_res.leading_one_pos.element_pos *
+				division_res.element_number_of_bits + division_res.leading_one_pos.bit_pos;
 
-				if (edge_case_result > required_bits)
-					required_bits = edge_case_result;
+			auto edge_case_result = std::size_t(format.extended_precision +
+				e + floor_log2_pow10(k)) + log2_res_p1;
 
-				if (required_bits > max_required_bits)
-					max_required_bits = required_bits;
-
-				on_each(e, required_bits);
-			}
+			if (edge_case_result > required_bits)
+				required_bits = edge_case_result;
 
-			on_max(max_required_bits);
+			return required_bits;
 		}
 
-		template <class Float, class F1, class F2>
-		void verify_cache_length_single_type_positive_k(F1&& on_each, F2&& on_max)
+		template <std::size_t array_size>
+		std::size_t verify_cache_length_positive_k(verify_format const& format,
+			further_info const& info, int e, int k, bigint_impl<array_size> const& power_of_5)
 		{
-			using bigint_type = bigint<further_info<Float>::positive_k_max_bits>;
-
-			std::size_t max_required_bits = 0;
-
-			bigint_type power_of_5 = 1;
-			int prev_k = 0;
-			for (int e = common_info<Float>::alpha + 2; e >= common_info<Float>::min_exponent; --e) {
-				auto k = -floor_log10_pow2(e + 1 - common_info<Float>::alpha);
-				if (k != prev_k) {
-					assert(k == prev_k + 1);
-					power_of_5.multiply_5();
-					prev_k = k;
-				}
+			using bigint_type = bigint_impl<array_size>;
+			auto const precision = std::size_t(format.precision);
 
-				auto required_bits_base = std::size_t(floor_log2_pow10(k) - k + 1);
-				auto required_bits = required_bits_base;
+			auto required_bits_base = std::size_t(floor_log2_pow10(k) - k + 1);
+			auto required_bits = required_bits_base;
 
-				int exp_of_2 = -e - k - int(further_info<Float>::q_mp_m2);
+			int exp_of_2 = -e - k - info.q_mp_m2;
 
-				if (exp_of_2 > 0) {
-					auto mod_minmax = minmax_euclid(
-						power_of_5,
-						bigint_type::power_of_2(exp_of_2),
-						further_info<Float>::range);
-					auto& mod_min = mod_minmax.min;
+			if (exp_of_2 > 0) {
+				auto mod_minmax = minmax_euclid(
+					power_of_5,
+					bigint_type::power_of_2(std::size_t(exp_of_2)),
+					info.range);
+				auto& mod_min = mod_minmax.min;
 
-					if (mod_min.leading_one_pos.bit_pos != 0) {
-						auto log2_res = mod_min.leading_one_pos.element_pos *
-							mod_min.element_number_of_bits + mod_min.leading_one_pos.bit_pos - 1;
+				if (mod_min.leading_one_pos.bit_pos != 0) {
+					auto log2_res = mod_min.leading_one_pos.element_pos *
+						mod_min.element_number_of_bits + mod_min.leading_one_pos.bit_pos - 1;
 
-						if (log2_res > common_info<Float>::precision + 2) {
-							required_bits -= (log2_res - common_info<Float>::precision - 2);
-						}
+					if (log2_res > precision + 2) {
+						required_bits -= (log2_res - precision - 2);
 					}
 				}
+			}
 
-				exp_of_2 -= 2;
-				if (exp_of_2 > 0) {
-					auto mod_minmax = minmax_euclid(
-						power_of_5,
-						bigint_type::power_of_2(exp_of_2),
-						further_info<Float>::range / 2);
-					auto& mod_min = mod_minmax.min;
+			exp_of_2 -= 2;
+			if (exp_of_2 > 0) {
+				auto mod_minmax = minmax_euclid(
+					power_of_5,
+					bigint_type::power_of_2(std::size_t(exp_of_2)),
+					info.range / 2);
+				auto& mod_min = mod_minmax.min;
 
-					if (mod_min.leading_one_pos.bit_pos != 0) {
-						auto log2_res = mod_min.leading_one_pos.element_pos *
-							mod_min.element_number_of_bits + mod_min.leading_one_pos.bit_pos - 1;
+				if (mod_min.leading_one_pos.bit_pos != 0) {
+					auto log2_res = mod_min.leading_one_pos.element_pos *
+						mod_min.element_number_of_bits + mod_min.leading_one_pos.bit_pos - 1;
 
-						if (log2_res > common_info<Float>::precision + 1) {
-							auto two_y_result = required_bits_base - log2_res + common_info<Float>::precision + 1;
+					if (log2_res > precision + 1) {
+						auto two_y_result = required_bits_base - log2_res + precision + 1;
 
-							if (two_y_result > required_bits)
-								required_bits = two_y_result;
-						}
+						if (two_y_result > required_bits)
+							required_bits = two_y_result;
 					}
 				}
+			}
 
-				exp_of_2 += 3;
-				if (exp_of_2 > 0) {
-					auto edge_case_a = power_of_5;
-					edge_case_a *= (further_info<Float>::range - 1);
-					edge_case_a.long_division(bigint_type::power_of_2(exp_of_2));
+			exp_of_2 += 3;
+			if (exp_of_2 > 0) {
+				auto edge_case_a = power_of_5;
+				edge_case_a *= (info.range - 1);
+				edge_case_a.long_division(bigint_type::power_of_2(std::size_t(exp_of_2)));
 
-					if (edge_case_a.leading_one_pos.bit_pos != 0) {
-						auto log2_res = edge_case_a.leading_one_pos.element_pos *
-							edge_case_a.element_number_of_bits + edge_case_a.leading_one_pos.bit_pos - 1;
+				if (edge_case_a.leading_one_pos.bit_pos != 0) {
+					auto log2_res = edge_case_a.leading_one_pos.element_pos *
+						edge_case_a.element_number_of_bits + edge_case_a.leading_one_pos.bit_pos - 1;
 
-						if (log2_res > common_info<Float>::precision + 2) {
-							auto edge_case_result = required_bits_base - log2_res + common_info<Float>::precision + 2;
+					if (log2_res > precision + 2) {
+						auto edge_case_result = required_bits_base - log2_res + precision + 2;
 
-							if (edge_case_result > required_bits)
-								required_bits = edge_case_result;
-						}
+						if (edge_case_result > required_bits)
+							required_bits = edge_case_result;
 					}
 				}
+			}
 
-				if (required_bits > max_required_bits)
-					max_required_bits = required_bits;
+			return required_bits;
+		}
 
-				on_each(e, required_bits);
+		// Computes the required bits for e = first_e, first_e + step, ... , last_e in parallel
+		// The powers of 5 are computed first, as the consecutive exponents share them.
+		template <std::size_t array_size, class F>
+		std::vector<std::size_t> verify_cache_length_range(verify_parameters const& params,
+			verify_format const& format, int first_e, int last_e, int step, F&& required_bits_of)
+		{
+			using bigint_type = bigint_impl<array_size>;
+
+			auto abs_k = [&format](int e) {
+				return std::abs(floor_log10_pow2(e + 1 - format.alpha));
+			};
+			std::vector<bigint_type> powers_of_5(std::size_t(std::max(abs_k(first_e), abs_k(last_e)) + 1));
+			powers_of_5[0] = 1;
+			for (std::size_t i = 1; i < powers_of_5.size(); ++i) {
+				powers_of_5[i] = powers_of_5[i - 1];
+				powers_of_5[i].multiply_5();
 			}
 
-			on_max(max_required_bits);
+			std::vector<std::size_t> required_bits(std::size_t((last_e - first_e) / step + 1));
+			parallel_for(required_bits.size(), params.number_of_threads, [&](std::size_t idx) {
+				auto const e = first_e + int(idx) * step;
+				auto const k = -floor_log10_pow2(e + 1 - format.alpha);
+				required_bits[idx] = required_bits_of(e, k, powers_of_5[std::size_t(std::abs(k))]);
+			});
+			return required_bits;
 		}
 	}
 }
 
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 
-void verify_cache_length()
+bool verify_cache_length(verify_parameters const& params, verify_format const& format)
 {
-	std::cout << "[Verifying cache length upper bound...]\n";
+	using namespace jkj::grisu_exact_detail;
+
+	further_info const info{ format };
+	bool succeeded = true;
+
+	auto write_results = [&](char const* suffix, int first_e, int step,
+		std::vector<std::size_t> const& required_bits)
+	{
+		auto const filename = params.output_directory + "/" + format.name + suffix;
+		std::ofstream out{ filename };
+		if (!out) {
+			std::cout << "Cannot open " << filename << ".\n";
+			succeeded = false;
+			return;
+		}
+		out << "e,required_bits\n";
+		for (std::size_t idx = 0; idx < required_bits.size(); ++idx) {
+			out << first_e + int(idx) * step << "," << required_bits[idx] << "\n";
+		}
 
-	std::ofstream out;
-	auto on_each = [&out](auto e, auto required_bits) {
-		out << e << "," << required_bits << std::endl;
-	};
-	auto on_max = [](auto max_required_bits) {
+		auto const max_required_bits = *std::max_element(required_bits.begin(), required_bits.end());
 		std::cout << "Maximum required bits: " << max_required_bits << std::endl;
+		if (max_required_bits > std::size_t(format.cache_precision)) {
+			std::cout << "The cache has only " << format.cache_precision << " bits!\n";
+			succeeded = false;
+		}
 	};
 
-	std::cout << "\nVerify for IEEE-754 binary32 (float) type for negative k...\n";	
-	out.open("test_results/binary32_negative_k.csv");
-	out << "e,required_bits\n";
-	jkj::grisu_exact_detail::verify_cache_length_single_type_negative_k<float>(on_each, on_max);
-	out.close();
-
-	std::cout << "\nVerify for IEEE-754 binary32 (float) type for positive k...\n";
-	out.open("test_results/binary32_positive_k.csv");
-	out << "e,required_bits\n";
-	jkj::grisu_exact_detail::verify_cache_length_single_type_positive_k<float>(on_each, on_max);
-	out.close();
-
-	std::cout << "\nVerify for IEEE-754 binary64 (double) type for negative k...\n";
-	out.open("test_results/binary64_negative_k.csv");
-	out << "e,required_bits\n";
-	jkj::grisu_exact_detail::verify_cache_length_single_type_negative_k<double>(on_each, on_max);
-	out.close();
-
-	std::cout << "\nVerify for IEEE-754 binary64 (double) type for positive k...\n";
-	out.open("test_results/binary64_positive_k.csv");
-	out << "e,required_bits\n";
-	jkj::grisu_exact_detail::verify_cache_length_single_type_positive_k<double>(on_each, on_max);
-	out.close();
+	std::cout << "\nVerify for " << format.name << " for negative k...\n";
+	auto const negative_k_required_bits = with_number_of_elements(info.negative_k_max_bits,
+		[&](auto array_size) {
+			return verify_cache_length_range<decltype(array_size)::value>(params, format,
+				format.alpha + 3, format.max_exponent, 1,
+				[&](int e, int k, auto const& power_of_5) {
+					return verify_cache_length_negative_k(format, info, e, k, power_of_5);
+				});
+		});
+	write_results("_negative_k.csv", format.alpha + 3, 1, negative_k_required_bits);
+
+	std::cout << "\nVerify for " << format.name << " for positive k...\n";
+	auto const positive_k_required_bits = with_number_of_elements(info.positive_k_max_bits,
+		[&](auto array_size) {
+			return verify_cache_length_range<decltype(array_size)::value>(params, format,
+				format.alpha + 2, format.min_exponent, -1,
+				[&](int e, int k, auto const& power_of_5) {
+					return verify_cache_length_positive_k(format, info, e, k, power_of_5);
+				});
+		});
+	write_results("_positive_k.csv", format.alpha + 2, -1, positive_k_required_bits);
+
+	return succeeded;
+}
+
+void verify_cache_length()
+{
+	std::cout << "[Verifying cache length upper bound...]\n";
+
+	verify_cache_length(verify_parameters{}, builtin_format<float>("binary32"));
+	verify_cache_length(verify_parameters{}, builtin_format<double>("binary64"));
 
 	std::cout << std::endl;
 	std::cout << "Done.\n\n\n";
@@ -15,45 +15,50 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
 // KIND, either express or implied.
 
-#include "../grisu_exact.h"
+#include "verify.h"
 
+#include <cstring>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 
-void verify_correct_rounding_bound()
-{
-	std::cout << "[Verifying correct rounding bound...]\n";
+namespace {
+	template <class Float, class Parameters>
+	bool verify_correct_rounding_bound_impl(verify_parameters const& params)
+	{
+		using namespace jkj::grisu_exact_detail;
+		using info = common_info<Float, Parameters>;
+		using extended_significand_type = typename info::extended_significand_type;
 
-	using namespace jkj::grisu_exact_detail;
+		constexpr auto max_exponent_shifted =
+			((int)(1) << info::exponent_bits) - 1;
 
-	auto verify_single_type = [](auto type_tag) {
-		using float_type = typename decltype(type_tag)::float_type;
-		using extended_significand_type = typename common_info<float_type>::extended_significand_type;
+		// For each e_shifted, what is printed and whether it is a failure,
+		// so that the messages are printed in the order of e
+		std::vector<std::string> messages(std::size_t(max_exponent_shifted - 1));
+		std::vector<char> failures(messages.size(), false);
 
-		bool success = true;
+		parallel_for(messages.size(), params.number_of_threads, [&](std::size_t idx) {
+			auto const e_shifted = int(idx) + 1;
 
-		constexpr auto max_exponent_shifted =
-			((int)(1) << common_info<float_type>::exponent_bits) - 1;
-		for (int e_shifted = 1; e_shifted < max_exponent_shifted; ++e_shifted)
-		{
 			// Compose bits
-			auto const bit_rep = extended_significand_type(e_shifted) << common_info<float_type>::precision;
-			float_type x;
+			auto const bit_rep = extended_significand_type(e_shifted) << info::precision;
+			Float x;
 			std::memcpy(&x, &bit_rep, sizeof(bit_rep));
 
 			// Compute e, k, and beta
-			auto const e = e_shifted + common_info<float_type>::exponent_bias
-				- int(common_info<float_type>::extended_precision) + 1;
-			auto const k = -floor_log10_pow2(e + 1 - common_info<float_type>::alpha);
+			auto const e = e_shifted + info::exponent_bias
+				- int(info::extended_precision) + 1;
+			auto const k = -floor_log10_pow2(e + 1 - info::alpha);
 			int const beta = e + floor_log2_pow10(k) + 1;
 
 			// Run Grisu-Exact without correct rounding search to inspect the possible range of kappa
 			// Since the significand is always even, nearest-to-odd is the most harsh condition, and
 			// nearest-to-even is the most generous condition
-			auto const grisu_exact_result_harsh = jkj::grisu_exact(x,
+			auto const grisu_exact_result_harsh = jkj::grisu_exact_with_parameters<Parameters, true>(x,
 				jkj::grisu_exact_rounding_modes::nearest_to_odd{},
 				jkj::grisu_exact_correct_rounding::do_not_care{});
-			auto const grisu_exact_result_generous = jkj::grisu_exact(x,
+			auto const grisu_exact_result_generous = jkj::grisu_exact_with_parameters<Parameters, true>(x,
 				jkj::grisu_exact_rounding_modes::nearest_to_even{},
 				jkj::grisu_exact_correct_rounding::do_not_care{});
 
@@ -61,23 +66,25 @@ void verify_correct_rounding_bound()
 			auto const kappa_max = grisu_exact_result_generous.exponent + k;
 
 			if (kappa_min != kappa_max) {
-				std::cout << "Detected mismatch between kappa's for different rounding modes!\n";
-				return false;
+				messages[idx] = "Detected mismatch between kappa's for different rounding modes! (e = "
+					+ std::to_string(e) + ")\n";
+				failures[idx] = true;
+				return;
 			}
-			auto const kappa = kappa_min;
+			auto const kappa = int(kappa_min);
 			auto divisor = extended_significand_type(1);
 			for (int i = 0; i < kappa; ++i) {
 				divisor *= 10;
 			}
 
-			auto const& cache = get_cache<float_type>(k);
-			assert(-beta < common_info<float_type>::extended_precision);
+			auto const& cache = get_cache<Float, Parameters>(k);
+			assert(-beta < info::extended_precision);
 
 			// To get n', we need to subtract 1, except when N = 10^kappa * n
 			// Thus, compute N first
-			auto fr = common_info<float_type>::sign_bit_mask | common_info<float_type>::boundary_bit;
-			auto zi = grisu_exact_impl<float_type>::compute_mul(fr, cache, -beta);
-			auto epsiloni = grisu_exact_impl<float_type>::template compute_delta<
+			auto fr = info::sign_bit_mask | info::boundary_bit;
+			auto zi = grisu_exact_impl<Float, Parameters>::compute_mul(fr, cache, -beta);
+			auto epsiloni = grisu_exact_impl<Float, Parameters>::template compute_delta<
 				jkj::grisu_exact_rounding_modes::left_closed_directed_tag>(
 				false, cache, -beta + 1);
 			auto displacement = (zi % divisor) + divisor / 2;
@@ -91,42 +98,60 @@ void verify_correct_rounding_bound()
 			}
 
 			if (np >= 5 && kappa != 0) {
-				std::cout << "n' = " << np
+				std::ostringstream message;
+				message << "n' = " << np
 					<< " (e = " << e << ", x = ";
-				std::cout << std::hex << std::setfill('0');				
+				message << std::hex << std::setfill('0');
 
-				if constexpr (sizeof(float_type) == 4) {
-					std::cout << std::setprecision(9) << x << " [0x" << std::setw(8);
-					success = false;
+				if constexpr (sizeof(Float) == 4) {
+					message << std::setprecision(9) << x << " [0x" << std::setw(8);
 				}
 				else {
-					static_assert(sizeof(float_type) == 8);
-					std::cout << std::setprecision(17) << x << " [0x" << std::setw(16);
-					if (np >= 6) {
-						success = false;
-					}
+					static_assert(sizeof(Float) == 8);
+					message << std::setprecision(17) << x << " [0x" << std::setw(16);
 				}
 
-				std::cout << bit_rep << "])\n" << std::dec;
+				message << bit_rep << "])\n";
+				// The correct rounding search assumes n' is at most Parameters::max_n_prime
+				if (np > Parameters::max_n_prime) {
+					failures[idx] = true;
+				}
+				messages[idx] = message.str();
 			}
-		}
+		});
 
-		return success;
-	};
-
-	if (verify_single_type(common_info<float>{})) {
-		std::cout << "correct rounding bound computation for binary32: verified." << std::endl;
-	}
-	else {
-		std::cout << "correct rounding bound computation for binary32: failed." << std::endl;
+		for (auto const& message : messages) {
+			std::cout << message;
+		}
+		return std::find(failures.begin(), failures.end(), char(true)) == failures.end();
 	}
+}
 
-	if (verify_single_type(common_info<double>{})) {
-		std::cout << "correct rounding bound computation for binary64: verified." << std::endl;
-	}
-	else {
-		std::cout << "correct rounding bound computation for binary64: failed." << std::endl;
+bool verify_correct_rounding_bound(verify_parameters const& params, verify_format const& format)
+{
+	bool success = true;
+	if (!visit_instantiated_parameters(format, [&](auto tag) {
+		using tag_type = decltype(tag);
+		success = verify_correct_rounding_bound_impl<typename tag_type::float_type,
+			typename tag_type::parameters>(params);
+	}))
+	{
+		std::cout << "correct rounding bound computation for " << format.name << ": skipped; "
+			"Grisu-Exact is not instantiated with these parameters." << std::endl;
+		return true;
 	}
 
+	std::cout << "correct rounding bound computation for " << format.name << ": "
+		<< (success ? "verified." : "failed.") << std::endl;
+	return success;
+}
+
+void verify_correct_rounding_bound()
+{
+	std::cout << "[Verifying correct rounding bound...]\n";
+
+	verify_correct_rounding_bound(verify_parameters{}, builtin_format<float>("binary32"));
+	verify_correct_rounding_bound(verify_parameters{}, builtin_format<double>("binary64"));
+
 	std::cout << "Done.\n\n\n";
 }
\ No newline at end of file
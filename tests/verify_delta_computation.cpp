@@ -15,61 +15,80 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
 // KIND, either express or implied.
 
-#include "../grisu_exact.h"
+#include "verify.h"
 
 #include <iostream>
+#include <sstream>
 
-void verify_delta_computation()
-{
-	std::cout << "[Verifying delta computation...]\n";
-
-	using namespace jkj::grisu_exact_detail;
-
-	auto verify_single_type = [](auto type_tag, auto&& type_name_string) {
-		using float_type = typename decltype(type_tag)::float_type;
+namespace {
+	template <class Float, class Parameters>
+	bool verify_delta_computation_impl(verify_parameters const& params)
+	{
+		using namespace jkj::grisu_exact_detail;
+		using info = common_info<Float, Parameters>;
 
 		constexpr auto fdelta =
-			(typename common_info<float_type>::extended_significand_type)(3) <<
-			(common_info<float_type>::extended_precision - common_info<float_type>::precision - 3);
+			(typename info::extended_significand_type)(3) <<
+			(info::extended_precision - info::precision - 3);
 
-		for (int k = common_info<float_type>::min_k;
-			k <= common_info<float_type>::max_k; ++k)
-		{
-			auto cache = get_cache<float_type>(k);
+		// One message for each k with a mismatch, printed in the order of k
+		std::vector<std::string> messages(std::size_t(info::max_k - info::min_k + 1));
+		parallel_for(messages.size(), params.number_of_threads, [&](std::size_t idx) {
+			auto const k = info::min_k + int(idx);
+			auto cache = get_cache<Float, Parameters>(k);
 
 			auto deltai_orthodox
-				= grisu_exact_impl<float_type>::compute_mul(fdelta, cache, -common_info<float_type>::gamma);
+				= grisu_exact_impl<Float, Parameters>::compute_mul(fdelta, cache, -info::gamma);
 
 			auto deltai_fast
-				= grisu_exact_impl<float_type>::template compute_delta<jkj::grisu_exact_rounding_modes::to_nearest_tag>(
-					true, cache, -common_info<float_type>::gamma);
+				= grisu_exact_impl<Float, Parameters>::template compute_delta<jkj::grisu_exact_rounding_modes::to_nearest_tag>(
+					true, cache, -info::gamma);
 
 			if (deltai_orthodox != deltai_fast) {
-				std::cout << "compute_delta for " << type_name_string
-					<< ": mismatch! [k = " << k << ", correct deltai = "
-					<< deltai_orthodox << ", computed deltai = ("
+				std::ostringstream message;
+				message << "compute_delta: mismatch! [k = " << k << ", correct deltai = "
+					<< deltai_orthodox << ", computed deltai = "
 					<< deltai_fast << "]\n";
+				messages[idx] = message.str();
+			}
+		});
 
-				return false;
+		bool success = true;
+		for (auto const& message : messages) {
+			if (!message.empty()) {
+				std::cout << message;
+				success = false;
 			}
 		}
+		return success;
+	}
+}
 
+bool verify_delta_computation(verify_parameters const& params, verify_format const& format)
+{
+	bool success = true;
+	if (!visit_instantiated_parameters(format, [&](auto tag) {
+		using tag_type = decltype(tag);
+		success = verify_delta_computation_impl<typename tag_type::float_type,
+			typename tag_type::parameters>(params);
+	}))
+	{
+		std::cout << "delta computation for " << format.name << ": skipped; "
+			"Grisu-Exact is not instantiated with these parameters." << std::endl;
 		return true;
-	};
-
-	if (verify_single_type(common_info<float>{}, "float")) {
-		std::cout << "delta computation for binary32: verified." << std::endl;
-	}
-	else {
-		std::cout << "delta computation for binary32: failed." << std::endl;
 	}
 
-	if (verify_single_type(common_info<double>{}, "double")) {
-		std::cout << "delta computation for binary64: verified." << std::endl;
-	}
-	else {
-		std::cout << "delta computation for binary64: failed." << std::endl;
-	}
+	std::cout << "delta computation for " << format.name << ": "
+		<< (success ? "verified." : "failed.") << std::endl;
+	return success;
+}
+
+void verify_delta_computation()
+{
+	std::cout << "[Verifying delta computation...]\n";
+
+	verify_delta_computation(verify_parameters{}, builtin_format<float>("binary32"));
+	verify_delta_computation(verify_parameters{}, builtin_format<double>("binary64"));
 
 	std::cout << "Done.\n\n\n";
 }
\ No newline at end of file
@@ -15,45 +15,50 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
 // KIND, either express or implied.
 
-#include "../grisu_exact.h"
+#include "verify.h"
 
+#include <cstring>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 
-void verify_incorrect_rounding_removal()
-{
-	std::cout << "[Verifying incorrect rounding removal...]\n";
+namespace {
+	template <class Float, class Parameters>
+	bool verify_incorrect_rounding_removal_impl(verify_parameters const& params)
+	{
+		using namespace jkj::grisu_exact_detail;
+		using info = common_info<Float, Parameters>;
+		using extended_significand_type = typename info::extended_significand_type;
 
-	using namespace jkj::grisu_exact_detail;
+		constexpr auto max_exponent_shifted =
+			((int)(1) << info::exponent_bits) - 1;
 
-	auto verify_single_type = [](auto type_tag) {
-		using float_type = typename decltype(type_tag)::float_type;
-		using extended_significand_type = typename common_info<float_type>::extended_significand_type;
+		// For each e_shifted, what is printed and whether it is a failure,
+		// so that the messages are printed in the order of e
+		std::vector<std::string> messages(std::size_t(max_exponent_shifted - 1));
+		std::vector<char> failures(messages.size(), false);
 
-		bool success = true;
+		parallel_for(messages.size(), params.number_of_threads, [&](std::size_t idx) {
+			auto const e_shifted = int(idx) + 1;
 
-		constexpr auto max_exponent_shifted =
-			((int)(1) << common_info<float_type>::exponent_bits) - 1;
-		for (int e_shifted = 1; e_shifted < max_exponent_shifted; ++e_shifted)
-		{
 			// Compose bits
-			auto const bit_rep = extended_significand_type(e_shifted) << common_info<float_type>::precision;
-			float_type x;
+			auto const bit_rep = extended_significand_type(e_shifted) << info::precision;
+			Float x;
 			std::memcpy(&x, &bit_rep, sizeof(bit_rep));
 
 			// Compute e, k, and beta
-			auto const e = e_shifted + common_info<float_type>::exponent_bias
-				- int(common_info<float_type>::extended_precision) + 1;
-			auto const k = -floor_log10_pow2(e + 1 - common_info<float_type>::alpha);
+			auto const e = e_shifted + info::exponent_bias
+				- int(info::extended_precision) + 1;
+			auto const k = -floor_log10_pow2(e + 1 - info::alpha);
 			int const beta = e + floor_log2_pow10(k) + 1;
 
 			// Run Grisu-Exact without correct rounding search to inspect the possible range of kappa
 			// Since the significand is always even, nearest-to-odd is the most harsh condition, and
 			// nearest-to-even is the most generous condition
-			auto const grisu_exact_result_harsh = jkj::grisu_exact(x,
+			auto const grisu_exact_result_harsh = jkj::grisu_exact_with_parameters<Parameters, true>(x,
 				jkj::grisu_exact_rounding_modes::nearest_to_odd{},
 				jkj::grisu_exact_correct_rounding::do_not_care{});
-			auto const grisu_exact_result_generous = jkj::grisu_exact(x,
+			auto const grisu_exact_result_generous = jkj::grisu_exact_with_parameters<Parameters, true>(x,
 				jkj::grisu_exact_rounding_modes::nearest_to_even{},
 				jkj::grisu_exact_correct_rounding::do_not_care{});
 
@@ -61,17 +66,19 @@ void verify_incorrect_rounding_removal()
 			auto const kappa_max = grisu_exact_result_generous.exponent + k;
 
 			if (kappa_min != kappa_max) {
-				std::cout << "Detected mismatch between kappa's for different rounding modes!\n";
-				return false;
+				messages[idx] = "Detected mismatch between kappa's for different rounding modes! (e = "
+					+ std::to_string(e) + ")\n";
+				failures[idx] = true;
+				return;
 			}
-			auto const kappa = kappa_min;
+			auto const kappa = int(kappa_min);
 			auto divisor = extended_significand_type(1);
 			for (int i = 0; i < kappa; ++i) {
 				divisor *= 10;
 			}
 
-			auto const& cache = get_cache<float_type>(k);
-			assert(-beta < common_info<float_type>::extended_precision);
+			auto const& cache = get_cache<Float, Parameters>(k);
+			assert(-beta < info::extended_precision);
 
 			// Carefully compute the rounded-down value of y (y^(rd) in the paper)
 			// Since y = 2^(e+q-1) * 10^k, we compute the ceiling of
@@ -79,12 +86,12 @@ void verify_incorrect_rounding_removal()
 			// First, compute floor(2^(e+q) * 10^k) = floor(2^(q+beta) * phi_k * 2^-Q),
 			// which is the first q+beta bits of phi_k
 			extended_significand_type two_yi;
-			if constexpr (sizeof(float_type) == 4) {
+			if constexpr (sizeof(Float) == 4) {
 				two_yi = extended_significand_type(cache >>
-					(int(common_info<float_type>::extended_precision) - beta));
+					(int(info::extended_precision) - beta));
 			}
 			else {
-				static_assert(sizeof(float_type) == 8);
+				static_assert(sizeof(Float) == 8);
 				two_yi = cache.high() >> -beta;
 			}
 
@@ -109,7 +116,7 @@ void verify_incorrect_rounding_removal()
 				else {
 					// Check if b is an integer, or equivalently,
 					// 2^(e+q) * 10^k is an integer
-					if (e + common_info<float_type>::extended_precision + k >= 0 && k >= 0) {
+					if (e + info::extended_precision + k >= 0 && k >= 0) {
 						rounded_down = (a - 1) / 2;
 					}
 					else {
@@ -119,9 +126,9 @@ void verify_incorrect_rounding_removal()
 			}
 
 			// Check if the distance from floor(z/10^kappa) is exactly 1
-			auto const fr = common_info<float_type>::sign_bit_mask | common_info<float_type>::boundary_bit;
-			auto const zi = grisu_exact_impl<float_type>::compute_mul(fr, cache, -beta);
-			auto const deltai = grisu_exact_impl<float_type>::template compute_delta<
+			auto const fr = info::sign_bit_mask | info::boundary_bit;
+			auto const zi = grisu_exact_impl<Float, Parameters>::compute_mul(fr, cache, -beta);
+			auto const deltai = grisu_exact_impl<Float, Parameters>::template compute_delta<
 				jkj::grisu_exact_rounding_modes::to_nearest_tag>(true, cache, -beta);
 			auto const approx_x = zi - deltai;
 			auto const right_bdy = zi / divisor;
@@ -132,89 +139,88 @@ void verify_incorrect_rounding_removal()
 				// We are interested in the case when the integer part of those two are the same
 				auto const distancei = r + divisor;
 				if (distancei == deltai) {
-					std::cout << "Coincidence of integer parts detected (x = "
+					std::ostringstream message;
+					message << "Coincidence of integer parts detected (x = "
 						<< std::hex << std::setfill('0');
 
-					if constexpr (sizeof(float_type) == 4) {
-						std::cout << std::setprecision(9) << x << " [0x" << std::setw(8);
+					if constexpr (sizeof(Float) == 4) {
+						message << std::setprecision(9) << x << " [0x" << std::setw(8);
 					}
 					else {
-						static_assert(sizeof(float_type) == 8);
-						std::cout << std::setprecision(17) << x << " [0x" << std::setw(16);
+						static_assert(sizeof(Float) == 8);
+						message << std::setprecision(17) << x << " [0x" << std::setw(16);
 					}
 
-					std::cout << bit_rep << "], e = " << std::dec << e << "): ";
+					message << bit_rep << "], e = " << std::dec << e << "): ";
 
 					// Now, compare the fractional parts
-					auto const fl = common_info<float_type>::sign_bit_mask -
-						common_info<float_type>::edge_case_boundary_bit;
+					auto const fl = info::sign_bit_mask -
+						info::edge_case_boundary_bit;
 
-					if ((grisu_exact_impl<float_type>::compute_mul(fl, cache, -beta) & 1) != (approx_x & 1))
+					if ((grisu_exact_impl<Float, Parameters>::compute_mul(fl, cache, -beta) & 1) != (approx_x & 1))
 					{
-						std::cout << "z^(f) < delta^(f)\n";
-						
-						if constexpr (sizeof(float_type) == 4) {
-							if (e == 59) {
-								success = false;
-							}
-						}
-						else {
-							if (e == -203) {
-								success = false;
-							}
+						message << "z^(f) < delta^(f)\n";
+
+						if (Parameters::skip_incorrect_rounding_removal(e)) {
+							failures[idx] = true;
 						}
 					}
-					else if (grisu_exact_impl<float_type>::template equal_fractional_parts<
+					else if (grisu_exact_impl<Float, Parameters>::template equal_fractional_parts<
 						jkj::grisu_exact_rounding_modes::to_nearest_tag>(fl, e, -k))
 					{
-						std::cout << "z^(f) == delta^(f)\n";
+						message << "z^(f) == delta^(f)\n";
 
-						if constexpr (sizeof(float_type) == 4) {
-							if (e == 59) {
-								success = false;
-							}
-						}
-						else {
-							if (e == -203) {
-								success = false;
-							}
+						if (Parameters::skip_incorrect_rounding_removal(e)) {
+							failures[idx] = true;
 						}
 					}
 					else
 					{
-						std::cout << "z^(f) > delta^(f)\n";
+						message << "z^(f) > delta^(f)\n";
 
-						if constexpr (sizeof(float_type) == 4) {
-							if (e != 59) {
-								success = false;
-							}
-						}
-						else {
-							if (e != -203) {
-								success = false;
-							}
+						// The correct rounding search should stop only in this case
+						if (!Parameters::skip_incorrect_rounding_removal(e)) {
+							failures[idx] = true;
 						}
 					}
+
+					messages[idx] = message.str();
 				}
 			}
-		}
+		});
 
-		return success;
-	};
-
-	if (verify_single_type(common_info<float>{})) {
-		std::cout << "Incorrect rounding removal for binary32: verified." << std::endl;
-	}
-	else {
-		std::cout << "Incorrect rounding removal for binary32: failed." << std::endl;
+		for (auto const& message : messages) {
+			std::cout << message;
+		}
+		return std::find(failures.begin(), failures.end(), char(true)) == failures.end();
 	}
+}
 
-	if (verify_single_type(common_info<double>{})) {
-		std::cout << "Incorrect rounding removal for binary64: verified." << std::endl;
-	}
-	else {
-		std::cout << "Incorrect rounding removal for binary64: failed." << std::endl;
+bool verify_incorrect_rounding_removal(verify_parameters const& params, verify_format const& format)
+{
+	bool success = true;
+	if (!visit_instantiated_parameters(format, [&](auto tag) {
+		using tag_type = decltype(tag);
+		success = verify_incorrect_rounding_removal_impl<typename tag_type::float_type,
+			typename tag_type::parameters>(params);
+	}))
+	{
+		std::cout << "Incorrect rounding removal for " << format.name << ": skipped; "
+			"Grisu-Exact is not instantiated with these parameters." << std::endl;
+		return true;
 	}
 
+	std::cout << "Incorrect rounding removal for " << format.name << ": "
+		<< (success ? "verified." : "failed.") << std::endl;
+	return success;
+}
+
+void verify_incorrect_rounding_removal()
+{
+	std::cout << "[Verifying incorrect rounding removal...]\n";
+
+	verify_incorrect_rounding_removal(verify_parameters{}, builtin_format<float>("binary32"));
+	verify_incorrect_rounding_removal(verify_parameters{}, builtin_format<double>("binary64"));
+
 	std::cout << "Done.\n\n\n";
 }
\ No newline at end of file
@@ -15,145 +15,162 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
 // KIND, either express or implied.
 
-#include "../grisu_exact.h"
+// Checks floor_log10_pow2, floor_log2_pow10, and floor_log5_pow2 against exact computations
+// with big integers. Each of them multiplies e by a truncated constant in fixed point, which
+// gives the exact answer unless the discarded lower bits could carry; only those exponents
+// are computed exactly, and the exponents are distributed over threads.
 
-#include <cmath>
+#include "verify.h"
+#include "../common/bigint.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
-#include "bigint.h"
+#include <limits>
+#include <string>
+#include <utility>
+
+namespace {
+	struct log_check_result {
+		// Whether the lower bits may carry, so that the exact value has been computed
+		bool checked = false;
+		bool succeeded = true;
+		std::string messages;
+	};
+
+	// Check every 1 <= e <= max_e such that the lower bits of e * constant may carry when
+	// the next digits of the constant are added; e * constant should not exceed max_product,
+	// the maximum of the type the multiplication is done in
+	// Returns the maximum e such that computed(x) is correct for every |x| <= e
+	template <class TrueValue, class Computed>
+	int verify_log_function(verify_parameters const& params, char const* name, int max_e,
+		std::int64_t constant, int lower_bits, std::int64_t next_digits, std::int64_t max_product,
+		TrueValue&& true_value_of, Computed&& computed_of)
+	{
+		// Beyond this, the multiplication itself overflows
+		auto const max_checked_e = int(std::min(std::int64_t(max_e), max_product / constant));
+
+		std::vector<log_check_result> results(static_cast<std::size_t>(max_checked_e));
+		parallel_for(results.size(), params.number_of_threads, [&](std::size_t idx) {
+			auto const e = int(idx) + 1;
+			auto& result = results[idx];
+
+			// Verify the lower bits can never overflow
+			auto const lower = (std::int64_t(e) * constant) & ((std::int64_t(1) << lower_bits) - 1);
+			if (lower + next_digits < (std::int64_t(1) << lower_bits)) {
+				return;
+			}
+			result.checked = true;
 
-void verify_log_computation()
+			// If there might be overflow, compute directly to verify
+			auto const true_value = true_value_of(e);
+			// The logarithm is never an integer
+			for (auto [x, expected] : { std::pair{ e, true_value }, std::pair{ -e, -true_value - 1 } }) {
+				auto const computed = computed_of(x);
+				if (computed != expected) {
+					result.messages += std::string(name) + ": mismatch! [e = " + std::to_string(x) +
+						", true_value = " + std::to_string(expected) +
+						", computed = " + std::to_string(computed) + "]\n";
+					result.succeeded = false;
+				}
+			}
+		});
+
+		int maximum_valid_exp = 0;
+		bool succeeded = true;
+		for (int e = 1; e <= max_checked_e; ++e) {
+			auto const& result = results[std::size_t(e - 1)];
+			if (result.checked) {
+				std::cout << name << ": overflow detected [e = " << e << "]\n" << result.messages;
+			}
+			succeeded = succeeded && result.succeeded;
+			if (succeeded) {
+				maximum_valid_exp = e;
+			}
+		}
+		if (max_checked_e < max_e) {
+			std::cout << name << ": the multiplication overflows for |e| >= " << max_checked_e + 1 << "\n";
+		}
+		std::cout << name << " is valid up to |e| <= " << maximum_valid_exp << ".\n\n";
+		return maximum_valid_exp;
+	}
+}
+
+bool verify_log_computation(verify_parameters const& params, std::vector<verify_format> const& formats)
 {
 	using jkj::grisu_exact_detail::bigint;
 
-	std::cout << "[Verifying log computation...]\n";
-
 	// Verify floor_log10_pow2
-	int maximum_valid_exp = 0;
-	bool succeeded = true;
-	for (int e = 1; e <= 4096; ++e) {
-		// Take lower 20 bits of 0x4d104 * e
-		auto lower = (std::int32_t(e) * 0x4d104) & 0xfffff;
-
-		// Verify the lower bits can never overflow
-		if (lower + 0xd28 >= 0x100000) {
-			std::cout << "floor_log10_pow2: overflow detected [e = " << e << "]\n";
-
-			// If there might be overflow, compute directly to verify
-			bigint<4097> number = bigint<4097>::power_of_2(e);
+	auto const floor_log10_pow2_max = verify_log_function(params, "floor_log10_pow2",
+		4096, 0x4d104, 20, 0xd28, std::numeric_limits<std::int32_t>::max(),
+		[](int e) {
+			bigint<4097> number = bigint<4097>::power_of_2(std::size_t(e));
 			int true_value = 0;
 			while (number >= 10) {
 				number = number.long_division(10);
 				++true_value;
 			}
-
-			auto computed = jkj::grisu_exact_detail::floor_log10_pow2<false>(e);
-			if (computed != true_value) {
-				std::cout << "floor_log10_pow2: mismatch! [e = " << e
-					<< ", true_value = " << true_value
-					<< ", computed = " << computed << "]\n";
-				succeeded = false;
-			}
-			computed = jkj::grisu_exact_detail::floor_log10_pow2<false>(-e);
-			true_value = -true_value - 1;	// log10(2^e) is never an integer
-			if (computed != true_value) {
-				std::cout << "floor_log10_pow2: mismatch! [e = " << -e
-					<< ", true_value = " << true_value
-					<< ", computed = " << computed << "]\n";
-				succeeded = false;
-			}
-		}
-		
-		if (succeeded) {
-			maximum_valid_exp = e;
-		}
-	}
-	std::cout << "floor_log10_pow2 is valid up to |e| <= " << maximum_valid_exp << ".\n\n";
-
+			return true_value;
+		},
+		[](int e) { return jkj::grisu_exact_detail::floor_log10_pow2<false>(e); });
 
 	// Verify floor_log2_pow10
-	maximum_valid_exp = 0;
-	succeeded = true;
-	for (int e = 1; e <= 1024; ++e) {
-		// Take lower 20 bits of 0x35269e * e
-		auto lower = (std::int32_t(e) * 0x35269e) & 0xfffff;
-
-		// Verify the lower bits can never overflow
-		if (lower + 0x130 >= 0x100000) {
-			std::cout << "floor_log2_pow10: overflow detected [e = " << e << "]\n";
-			
-			// If there might be overflow, compute directly to verify
-			bigint<4 * 4096> number = bigint<4 * 4096>::power_of_2(e);
+	auto const floor_log2_pow10_max = verify_log_function(params, "floor_log2_pow10",
+		1024, 0x35269e, 20, 0x130, std::numeric_limits<std::int32_t>::max(),
+		[](int e) {
+			bigint<4 * 4096> number = bigint<4 * 4096>::power_of_2(std::size_t(e));
 			for (int i = 0; i < e; ++i) {
 				number.multiply_5();
 			}
-			auto true_value = int(number.leading_one_pos.element_pos * decltype(number)::element_number_of_bits
+			return int(number.leading_one_pos.element_pos * decltype(number)::element_number_of_bits
 				+ number.leading_one_pos.bit_pos - 1);
-
-			auto computed = jkj::grisu_exact_detail::floor_log2_pow10<false>(e);
-			if (computed != true_value) {
-				std::cout << "floor_log2_pow10: mismatch! [e = " << e
-					<< ", true_value = " << true_value
-					<< ", computed = " << computed << "]\n";
-				succeeded = false;
-			}
-			computed = jkj::grisu_exact_detail::floor_log2_pow10<false>(-e);
-			true_value = -true_value - 1;	// log2(10^e) is never an integer
-			if (computed != true_value) {
-				std::cout << "floor_log2_pow10: mismatch! [e = " << -e
-					<< ", true_value = " << true_value
-					<< ", computed = " << computed << "]\n";
-				succeeded = false;
-			}
-		}
-
-		if (succeeded) {
-			maximum_valid_exp = e;
-		}
-	}
-	std::cout << "floor_log2_pow10 is valid up to |e| <= " << maximum_valid_exp << ".\n\n";
-
+		},
+		[](int e) { return jkj::grisu_exact_detail::floor_log2_pow10<false>(e); });
 
 	// Verify floor_log5_pow2
-	maximum_valid_exp = 0;
-	succeeded = true;
-	for (int e = 1; e <= 65536; ++e) {
-		// Take lower 32 bits of 0x6e40d1a4 * e
-		auto lower = (std::int64_t(e) * 0x6e40d1a4) & 0xffffffff;
-
-		// Verify the lower bits can never overflow
-		if (lower + 0x143e >= 0x100000000) {
-			std::cout << "floor_log5_pow2: overflow detected [e = " << e << "]\n";
-
-			// If there might be overflow, compute directly to verify
-			bigint<65537> number = bigint<65537>::power_of_2(e);
+	auto const floor_log5_pow2_max = verify_log_function(params, "floor_log5_pow2",
+		65536, 0x6e40d1a4, 32, 0x143e, std::numeric_limits<std::int64_t>::max(),
+		[](int e) {
+			bigint<65537> number = bigint<65537>::power_of_2(std::size_t(e));
 			int true_value = 0;
 			while (number >= 5) {
 				number = number.long_division(5);
 				++true_value;
 			}
+			return true_value;
+		},
+		[](int e) { return jkj::grisu_exact_detail::floor_log5_pow2<false>(e); });
 
-			auto computed = jkj::grisu_exact_detail::floor_log5_pow2<false>(e);
-			if (computed != true_value) {
-				std::cout << "floor_log5_pow2: mismatch! [e = " << e
-					<< ", true_value = " << true_value
-					<< ", computed = " << computed << "]\n";
-				succeeded = false;
-			}
-			computed = jkj::grisu_exact_detail::floor_log5_pow2<false>(-e);
-			true_value = -true_value - 1;	// log10(2^e) is never an integer
-			if (computed != true_value) {
-				std::cout << "floor_log5_pow2: mismatch! [e = " << -e
-					<< ", true_value = " << true_value
-					<< ", computed = " << computed << "]\n";
-				succeeded = false;
-			}
-		}
-
-		if (succeeded) {
-			maximum_valid_exp = e;
-		}
+	// The largest arguments each format passes
+	bool succeeded = true;
+	for (auto const& format : formats) {
+		auto const q = format.extended_precision;
+		auto const p = format.precision;
+		auto const floor_log10_pow2_needed = std::max({
+			format.max_exponent + 1 - format.alpha, format.alpha - 1 - format.min_exponent,
+			std::abs(q - p - 3 + format.alpha), q + format.gamma, 32 });
+		auto const floor_log2_pow10_needed = std::max(-format.min_k, format.max_k);
+		auto const floor_log5_pow2_needed = std::max({
+			std::abs(q - p + format.alpha), std::abs(q - p - 3 + format.alpha), p + 2 });
+
+		bool const verified = floor_log10_pow2_needed <= floor_log10_pow2_max &&
+			floor_log2_pow10_needed <= floor_log2_pow10_max &&
+			floor_log5_pow2_needed <= floor_log5_pow2_max;
+		std::cout << format.name << " needs |e| <= " << floor_log10_pow2_needed <<
+			" for floor_log10_pow2, " << floor_log2_pow10_needed << " for floor_log2_pow10, and " <<
+			floor_log5_pow2_needed << " for floor_log5_pow2: " <<
+			(verified ? "verified.\n" : "failed.\n");
+		succeeded = succeeded && verified;
 	}
-	std::cout << "floor_log5_pow2 is valid up to |e| <= " << maximum_valid_exp << ".\n\n";
 
+	return succeeded;
+}
+
+void verify_log_computation()
+{
+	std::cout << "[Verifying log computation...]\n";
+	verify_log_computation(verify_parameters{},
+		{ builtin_format<float>("binary32"), builtin_format<double>("binary64") });
 	std::cout << "Done.\n\n\n";
 }
\ No newline at end of file
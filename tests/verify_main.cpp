@@ -0,0 +1,257 @@
+// Copyright 2020 Junekey Jeon
+//
+// The contents of this file may be used under the terms of
+// the Apache License v2.0 with LLVM Exceptions.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     https://llvm.org/foundation/relicensing/LICENSE.txt)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+// Stand-alone driver of the offline verifications
+// tests/main.cpp remains the entry point for the Visual Studio project;
+// this one is used for the CMake target grisu_exact_verify.
+//
+// Besides binary32 and binary64, a format can be given by its precision and exponent bits
+// together with the parameters alpha, gamma, and the initial kappa of Grisu-Exact, so that
+// alternative configurations can be checked before instantiating them.
+//
+// Exit code: 0 if every verification succeeds, 1 if any fails,
+// 2 on invalid options or an unsupported format.
+
+#include "verify.h"
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+namespace {
+	void print_usage(char const* program_name)
+	{
+		std::cout << "Usage: " << program_name << " [verifications] [formats] [options]\n"
+			"Verifications (default: all):\n"
+			"  --log                         floor_log10_pow2, floor_log2_pow10, and floor_log5_pow2\n"
+			"  --cache-length                the number of bits needed for each cache entry\n"
+			"  --generate-cache              the cache entries, compared with the instantiated ones if any\n"
+			"  --delta                       compute_delta (instantiated parameters only)\n"
+			"  --correct-rounding-bound      the steps of the correct rounding search\n"
+			"                                (instantiated parameters only)\n"
+			"  --incorrect-rounding-removal  the simplification of the incorrect rounding removal\n"
+			"                                (instantiated parameters only)\n"
+			"  --all                         all of the above\n"
+			"Formats (default: binary32 and binary64):\n"
+			"  --float                       binary32 with the parameters of grisu_exact.h\n"
+			"  --double                      binary64 with the parameters of grisu_exact.h\n"
+			"  --precision P                 a format with P significand bits, excluding the hidden bit\n"
+			"  --exponent-bits E             and E exponent bits; 1 + E + P should be 16, 32, or 64\n"
+			"  --alpha A                     alpha for that format (default: -5)\n"
+			"  --gamma G                     gamma for that format (default: -2)\n"
+			"  --initial-kappa K             the initial kappa for that format (default: min_kappa + 2)\n"
+			"Options:\n"
+			"  --threads N                   number of threads (default: the number of hardware threads)\n"
+			"  --output-dir D                where the tables are written (default: test_results)\n"
+			"  --help                        print this message\n";
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bool run_log = false;
+	bool run_cache_length = false;
+	bool run_generate_cache = false;
+	bool run_delta = false;
+	bool run_correct_rounding_bound = false;
+	bool run_incorrect_rounding_removal = false;
+	bool run_float = false;
+	bool run_double = false;
+	bool run_custom = false;
+	verify_format custom_format;
+	verify_parameters params;
+
+	for (int i = 1; i < argc; ++i) {
+		std::string_view arg = argv[i];
+		auto next_value = [&]() -> char const* {
+			if (i + 1 >= argc) {
+				std::cerr << "Missing value for " << arg << "\n";
+				std::exit(2);
+			}
+			return argv[++i];
+		};
+		auto next_number = [&]() -> int {
+			return std::stoi(next_value());
+		};
+
+		if (arg == "--log") {
+			run_log = true;
+		}
+		else if (arg == "--cache-length") {
+			run_cache_length = true;
+		}
+		else if (arg == "--generate-cache") {
+			run_generate_cache = true;
+		}
+		else if (arg == "--delta") {
+			run_delta = true;
+		}
+		else if (arg == "--correct-rounding-bound") {
+			run_correct_rounding_bound = true;
+		}
+		else if (arg == "--incorrect-rounding-removal") {
+			run_incorrect_rounding_removal = true;
+		}
+		else if (arg == "--all") {
+			run_log = run_cache_length = run_generate_cache = run_delta =
+				run_correct_rounding_bound = run_incorrect_rounding_removal = true;
+		}
+		else if (arg == "--float") {
+			run_float = true;
+		}
+		else if (arg == "--double") {
+			run_double = true;
+		}
+		else if (arg == "--precision") {
+			run_custom = true;
+			custom_format.precision = next_number();
+		}
+		else if (arg == "--exponent-bits") {
+			run_custom = true;
+			custom_format.exponent_bits = next_number();
+		}
+		else if (arg == "--alpha") {
+			run_custom = true;
+			custom_format.alpha = next_number();
+		}
+		else if (arg == "--gamma") {
+			run_custom = true;
+			custom_format.gamma = next_number();
+		}
+		else if (arg == "--initial-kappa") {
+			run_custom = true;
+			custom_format.initial_kappa = next_number();
+			if (custom_format.initial_kappa < 0) {
+				std::cerr << "--initial-kappa should be nonnegative\n";
+				return 2;
+			}
+		}
+		else if (arg == "--threads") {
+			params.number_of_threads = std::size_t(next_number());
+		}
+		else if (arg == "--output-dir") {
+			params.output_directory = next_value();
+		}
+		else if (arg == "--help") {
+			print_usage(argv[0]);
+			return EXIT_SUCCESS;
+		}
+		else {
+			std::cerr << "Unknown option: " << arg << "\n";
+			print_usage(argv[0]);
+			return 2;
+		}
+	}
+	if (!run_log && !run_cache_length && !run_generate_cache && !run_delta &&
+		!run_correct_rounding_bound && !run_incorrect_rounding_removal)
+	{
+		run_log = run_cache_length = run_generate_cache = run_delta =
+			run_correct_rounding_bound = run_incorrect_rounding_removal = true;
+	}
+	if (!run_float && !run_double && !run_custom) {
+		run_float = true;
+		run_double = true;
+	}
+
+	std::vector<verify_format> formats;
+	if (run_float) {
+		formats.push_back(builtin_format<float>("binary32"));
+	}
+	if (run_double) {
+		formats.push_back(builtin_format<double>("binary64"));
+	}
+	if (run_custom) {
+		if (custom_format.precision == 0 || custom_format.exponent_bits == 0) {
+			std::cerr << "--precision and --exponent-bits should be given together\n";
+			return 2;
+		}
+		if (auto error = derive_format_parameters(custom_format); !error.empty()) {
+			std::cerr << "Unsupported format: " << error << "\n";
+			return 2;
+		}
+		if (is_builtin_format<float>(custom_format)) {
+			custom_format.name = "binary32";
+		}
+		else if (is_builtin_format<double>(custom_format)) {
+			custom_format.name = "binary64";
+		}
+		else {
+			custom_format.name = "p" + std::to_string(custom_format.precision) +
+				"_e" + std::to_string(custom_format.exponent_bits) +
+				"_alpha" + std::to_string(custom_format.alpha) +
+				"_gamma" + std::to_string(custom_format.gamma) +
+				"_kappa" + std::to_string(custom_format.initial_kappa);
+		}
+		formats.push_back(custom_format);
+	}
+
+	for (auto const& format : formats) {
+		std::cout << format.name << ": precision " << format.precision << ", exponent bits " <<
+			format.exponent_bits << ", alpha " << format.alpha << ", gamma " << format.gamma <<
+			", kappa in [" << format.min_kappa << ", " << format.max_kappa << "] starting from " <<
+			format.initial_kappa << ", k in [" << format.min_k << ", " << format.max_k << "]\n";
+	}
+	std::cout << "\n";
+
+	if (run_cache_length || run_generate_cache) {
+		std::filesystem::create_directories(params.output_directory);
+	}
+
+	bool succeeded = true;
+	auto run = [&](char const* title, auto&& verify) {
+		std::cout << "[" << title << "...]\n";
+		for (auto const& format : formats) {
+			succeeded = verify(params, format) && succeeded;
+		}
+		std::cout << "Done.\n\n\n";
+	};
+
+	if (run_log) {
+		std::cout << "[Verifying log computation...]\n";
+		succeeded = verify_log_computation(params, formats) && succeeded;
+		std::cout << "Done.\n\n\n";
+	}
+	if (run_cache_length) {
+		run("Verifying cache length upper bound", [](auto const& params, auto const& format) {
+			return verify_cache_length(params, format);
+		});
+	}
+	if (run_generate_cache) {
+		run("Generating cache", [](auto const& params, auto const& format) {
+			return generate_cache(params, format);
+		});
+	}
+	if (run_delta) {
+		run("Verifying delta computation", [](auto const& params, auto const& format) {
+			return verify_delta_computation(params, format);
+		});
+	}
+	if (run_correct_rounding_bound) {
+		run("Verifying correct rounding bound", [](auto const& params, auto const& format) {
+			return verify_correct_rounding_bound(params, format);
+		});
+	}
+	if (run_incorrect_rounding_removal) {
+		run("Verifying incorrect rounding removal", [](auto const& params, auto const& format) {
+			return verify_incorrect_rounding_removal(params, format);
+		});
+	}
+
+	std::cout << (succeeded ? "All verifications succeeded.\n" : "Some verifications failed.\n");
+	return succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file